@@ -8,8 +8,10 @@
 AGACueActor::AGACueActor(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	//can tick, but only when cue asks for it. See bTickWhenActive.
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	bTickWhenActive = false;
 	DefaultRoot = ObjectInitializer.CreateDefaultSubobject<USceneComponent>(this, TEXT("DefaultRoot"));
 	RootComponent = DefaultRoot;
 }
@@ -21,10 +23,18 @@ void AGACueActor::BeginPlay()
 	
 }
 
-// Called every frame
-void AGACueActor::Tick( float DeltaTime )
+void AGACueActor::OnAcquiredFromPool()
 {
-	Super::Tick( DeltaTime );
-
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(bTickWhenActive);
+}
+void AGACueActor::OnReleasedToPool()
+{
+	OnReturnedToPool();
+	OwningAbility = nullptr;
+	SetActorHiddenInGame(true);
+	SetActorTickEnabled(false);
+	//timers set while actor was out must not fire, after it's handed out again.
+	GetWorldTimerManager().ClearAllTimersForObject(this);
 }
 
@@ -15,6 +15,12 @@ public:
 
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "Root")
 		USceneComponent* DefaultRoot;
+	/*
+		Cue actors are pooled and don't tick by default.
+		Set it, if cue needs tick while it's handed out from pool.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "Pool")
+		bool bTickWhenActive;
 
 public:	
 	// Sets default values for this actor's properties
@@ -23,10 +29,14 @@ public:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 	
-	// Called every frame
-	virtual void Tick( float DeltaSeconds ) override;
-	
-	
+	/* Called by FGACueActorPool. */
+	void OnAcquiredFromPool();
+	void OnReleasedToPool();
+
+	/* Called when actor goes back to pool. Stop any effects here, actor will be reused. */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Game Abilities")
+		void OnReturnedToPool();
+
 	UFUNCTION(BlueprintImplementableEvent, Category = "Game Abilities")
 		void OnActivated();
 
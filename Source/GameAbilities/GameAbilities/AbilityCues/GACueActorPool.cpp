@@ -0,0 +1,184 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "GameAbilities.h"
+#include "GACueActor.h"
+#include "GACueActorPool.h"
+
+namespace GACueActorPool
+{
+	/* How often active actors are checked for missing owners. */
+	static const float SweepInterval = 1.0f;
+
+	struct FWorldPool
+	{
+		TMap<UClass*, TArray<TWeakObjectPtr<AGACueActor>>> FreeActors;
+		TArray<TWeakObjectPtr<AGACueActor>> ActiveActors;
+		bool bPrewarmed;
+		float NextSweepTime;
+
+		FWorldPool()
+			: bPrewarmed(false),
+			NextSweepTime(0)
+		{}
+	};
+	static TMap<UWorld*, FWorldPool> Pools;
+	static FDelegateHandle PostActorTickHandle;
+	static FDelegateHandle WorldCleanupHandle;
+
+	static bool CanHaveCues(UWorld* WorldIn)
+	{
+		return WorldIn && WorldIn->IsGameWorld() && WorldIn->GetNetMode() != NM_DedicatedServer;
+	}
+	static AGACueActor* Spawn(UWorld* WorldIn, UClass* ClassIn)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AGACueActor* Actor = WorldIn->SpawnActor<AGACueActor>(ClassIn, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+		if (Actor)
+		{
+			Actor->SetActorHiddenInGame(true);
+			Actor->SetActorTickEnabled(false);
+		}
+		return Actor;
+	}
+	static void Sweep(FWorldPool& PoolIn)
+	{
+		for (int32 Idx = PoolIn.ActiveActors.Num() - 1; Idx >= 0; Idx--)
+		{
+			AGACueActor* Actor = PoolIn.ActiveActors[Idx].Get();
+			if (!Actor || Actor->IsPendingKill())
+			{
+				PoolIn.ActiveActors.RemoveAtSwap(Idx, 1, false);
+				continue;
+			}
+			AActor* Owner = Actor->GetOwner();
+			if (!Owner || Owner->IsPendingKill())
+			{
+				FGACueActorPool::Release(Actor);
+			}
+		}
+	}
+	static void OnPostActorTick(UWorld* WorldIn, ELevelTick TickTypeIn, float DeltaTimeIn)
+	{
+		if (!CanHaveCues(WorldIn) || !WorldIn->HasBegunPlay())
+		{
+			return;
+		}
+		FWorldPool& Pool = Pools.FindOrAdd(WorldIn);
+		if (!Pool.bPrewarmed)
+		{
+			Pool.bPrewarmed = true;
+			for (const FGACueActorPrewarm& Prewarm : GetDefault<UGACueActorPoolSettings>()->PrewarmCues)
+			{
+				FGACueActorPool::Prewarm(WorldIn, Prewarm.CueClass, Prewarm.Count);
+			}
+		}
+		const float Time = WorldIn->GetTimeSeconds();
+		if (Time >= Pool.NextSweepTime)
+		{
+			Pool.NextSweepTime = Time + SweepInterval;
+			Sweep(Pool);
+		}
+	}
+	static void OnWorldCleanup(UWorld* WorldIn, bool bSessionEnded, bool bCleanupResources)
+	{
+		Pools.Remove(WorldIn);
+	}
+}
+
+void FGACueActorPool::Startup()
+{
+	GACueActorPool::PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(
+		&GACueActorPool::OnPostActorTick);
+	GACueActorPool::WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(
+		&GACueActorPool::OnWorldCleanup);
+}
+void FGACueActorPool::Shutdown()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(GACueActorPool::PostActorTickHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(GACueActorPool::WorldCleanupHandle);
+	GACueActorPool::Pools.Empty();
+}
+
+AGACueActor* FGACueActorPool::Acquire(UWorld* WorldIn, TSubclassOf<class AGACueActor> ClassIn,
+	const FVector& LocationIn, AActor* OwnerIn, APawn* InstigatorIn)
+{
+	if (!ClassIn || !GACueActorPool::CanHaveCues(WorldIn))
+	{
+		return nullptr;
+	}
+	GACueActorPool::FWorldPool& Pool = GACueActorPool::Pools.FindOrAdd(WorldIn);
+	AGACueActor* Actor = nullptr;
+	TArray<TWeakObjectPtr<AGACueActor>>& FreeActors = Pool.FreeActors.FindOrAdd(ClassIn);
+	while (!Actor && FreeActors.Num() > 0)
+	{
+		//actors might have been destroyed with level.
+		Actor = FreeActors.Pop(false).Get();
+		if (Actor && Actor->IsPendingKill())
+		{
+			Actor = nullptr;
+		}
+	}
+	if (!Actor)
+	{
+		Actor = GACueActorPool::Spawn(WorldIn, ClassIn);
+		if (!Actor)
+		{
+			return nullptr;
+		}
+	}
+	Actor->SetOwner(OwnerIn);
+	Actor->Instigator = InstigatorIn;
+	Actor->SetActorLocation(LocationIn);
+	Actor->OnAcquiredFromPool();
+	Pool.ActiveActors.Add(Actor);
+	return Actor;
+}
+
+void FGACueActorPool::Release(class AGACueActor* ActorIn)
+{
+	if (!ActorIn)
+	{
+		return;
+	}
+	GACueActorPool::FWorldPool* Pool = GACueActorPool::Pools.Find(ActorIn->GetWorld());
+	if (!Pool || Pool->ActiveActors.RemoveSwap(ActorIn) == 0)
+	{
+		return;
+	}
+	ActorIn->OnReleasedToPool();
+	ActorIn->SetOwner(nullptr);
+	ActorIn->Instigator = nullptr;
+	Pool->FreeActors.FindOrAdd(ActorIn->GetClass()).Add(ActorIn);
+}
+
+void FGACueActorPool::Prewarm(UWorld* WorldIn, TSubclassOf<class AGACueActor> ClassIn, int32 CountIn)
+{
+	if (!ClassIn || !GACueActorPool::CanHaveCues(WorldIn))
+	{
+		return;
+	}
+	TArray<TWeakObjectPtr<AGACueActor>>& FreeActors = GACueActorPool::Pools.FindOrAdd(WorldIn).FreeActors.FindOrAdd(ClassIn);
+	while (FreeActors.Num() < CountIn)
+	{
+		AGACueActor* Actor = GACueActorPool::Spawn(WorldIn, ClassIn);
+		if (!Actor)
+		{
+			break;
+		}
+		FreeActors.Add(Actor);
+	}
+}
+
+int32 FGACueActorPool::GetNumFree(UWorld* WorldIn, TSubclassOf<class AGACueActor> ClassIn)
+{
+	GACueActorPool::FWorldPool* Pool = GACueActorPool::Pools.Find(WorldIn);
+	const TArray<TWeakObjectPtr<AGACueActor>>* FreeActors = Pool ? Pool->FreeActors.Find(ClassIn) : nullptr;
+	return FreeActors ? FreeActors->Num() : 0;
+}
+
+int32 FGACueActorPool::GetNumActive(UWorld* WorldIn)
+{
+	GACueActorPool::FWorldPool* Pool = GACueActorPool::Pools.Find(WorldIn);
+	return Pool ? Pool->ActiveActors.Num() : 0;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "GACueActorPool.generated.h"
+
+USTRUCT()
+struct GAMEABILITIES_API FGACueActorPrewarm
+{
+	GENERATED_USTRUCT_BODY()
+public:
+	UPROPERTY(EditAnywhere, Category = "Pool")
+		TSubclassOf<class AGACueActor> CueClass;
+	/* Number of actors spawned when map is loaded. */
+	UPROPERTY(EditAnywhere, Category = "Pool")
+		int32 Count;
+
+	FGACueActorPrewarm()
+		: Count(0)
+	{};
+};
+
+/* Cue actors spawned up front, when map is loaded. Set in DefaultGame.ini. */
+UCLASS(config = Game, defaultconfig)
+class GAMEABILITIES_API UGACueActorPoolSettings : public UObject
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(config, EditAnywhere, Category = "Pool")
+		TArray<FGACueActorPrewarm> PrewarmCues;
+};
+
+/*
+	Per world pool of AGACueActor, by cue class.
+	Actors are spawned hidden, with tick disabled, and are handed out and taken back without
+	being spawned or destroyed again. Actors which owner is gone are taken back automatically.
+
+	Cue actors are cosmetic, so dedicated server doesn't get any.
+*/
+class GAMEABILITIES_API FGACueActorPool
+{
+public:
+	/* Called by module. */
+	static void Startup();
+	static void Shutdown();
+
+	/* Returns free actor of class, or spawns new one if there is none. */
+	static class AGACueActor* Acquire(UWorld* WorldIn, TSubclassOf<class AGACueActor> ClassIn,
+		const FVector& LocationIn, AActor* OwnerIn, APawn* InstigatorIn);
+	static void Release(class AGACueActor* ActorIn);
+	/* Spawns actors of class, until there is at least CountIn free ones. */
+	static void Prewarm(UWorld* WorldIn, TSubclassOf<class AGACueActor> ClassIn, int32 CountIn);
+
+	static int32 GetNumFree(UWorld* WorldIn, TSubclassOf<class AGACueActor> ClassIn);
+	static int32 GetNumActive(UWorld* WorldIn);
+};
@@ -122,10 +122,8 @@ FGAEffectHandle UGABlueprintLibrary::ApplyEffect(UGAGameEffectSpec* SpecIn,
 	}
 	else
 	{
-		FGAEffect* effect = new FGAEffect(SpecIn, Context);
-		AddTagsToEffect(effect);
-		HandleIn = FGAEffectHandle::GenerateHandle(effect);
-		effect->Handle = HandleIn;
+		HandleIn = FGAEffectHandle::GenerateHandle(SpecIn, Context);
+		AddTagsToEffect(HandleIn.GetEffectPtr());
 	}
 	Context.InstigatorComp->ApplyEffectToTarget(HandleIn.GetEffect(), HandleIn);
 	return HandleIn;
@@ -187,15 +185,15 @@ FGAEffectHandle UGABlueprintLibrary::MakeEffect(UGAGameEffectSpec* SpecIn,
 	}
 	else
 	{
-		FGAEffect* effect = new FGAEffect(SpecIn, Context);
-		AddTagsToEffect(effect);
-		HandleIn = FGAEffectHandle::GenerateHandle(effect);
-		effect->Handle = HandleIn;
+		HandleIn = FGAEffectHandle::GenerateHandle(SpecIn, Context);
+		AddTagsToEffect(HandleIn.GetEffectPtr());
 	}
 	return HandleIn;
 }
 FGAEffectHandle UGABlueprintLibrary::ApplyEffect(const FGAEffectHandle& HandleIn)
 {
+	if (!HandleIn.IsValid())
+		return HandleIn;
 	HandleIn.GetContextRef().InstigatorComp->ApplyEffectToTarget(HandleIn.GetEffect(), HandleIn);
 	return HandleIn;
 }
@@ -8,6 +8,7 @@
 #include "Engine/ActorChannel.h"
 #include "Animation/AnimInstance.h"
 #include "Animation/AnimMontage.h"
+#include "GameFramework/GameStateBase.h"
 #include "GAGlobals.h"
 #include "GAAbilitySet.h"
 #include "IGIPawn.h"
@@ -20,8 +21,10 @@
 #include "MessageEndpoint.h"
 #include "MessageEndpointBuilder.h"
 #include "GAEffectExtension.h"
+#include "GAEffectCueBatcher.h"
 #include "GAAbilitiesComponent.h"
 DEFINE_STAT(STAT_ApplyEffect);
+DEFINE_STAT(STAT_ApplyEffectToTargets);
 DEFINE_STAT(STAT_ModifyAttribute);
 
 UGAAbilitiesComponent::UGAAbilitiesComponent(const FObjectInitializer& ObjectInitializer)
@@ -29,6 +32,7 @@ UGAAbilitiesComponent::UGAAbilitiesComponent(const FObjectInitializer& ObjectIni
 {
 	bWantsInitializeComponent = true;
 	bIsAnyAbilityActive = false;
+	bCaptureCombatTrace = false;
 }
 void UGAAbilitiesComponent::GetAttributeStructTest(FGAAttribute Name)
 {
@@ -43,11 +47,24 @@ void UGAAbilitiesComponent::OnRep_GameEffectContainer()
 FGAEffectHandle UGAAbilitiesComponent::ApplyEffectToSelf(const FGAEffect& EffectIn
 	, const FGAEffectHandle& HandleIn)
 {
-	OnEffectApplyToSelf.Broadcast(HandleIn, HandleIn.GetEffectPtr()->OwnedTags);
+	UGAGameEffectSpec* Spec = EffectIn.GameEffect;
+	if (AppliedTags.HasAny(Spec->GetDenyTagsMask())
+		|| !AppliedTags.HasAll(Spec->GetRequiredTagsMask()))
+	{
+		FGAEffectPool::Get().Release(HandleIn);
+		return FGAEffectHandle();
+	}
+	OnEffectApplyToSelf.Broadcast(HandleIn, HandleIn.GetEffectRef().OwnedTags);
 	GameEffectContainer.ApplyEffect(EffectIn, HandleIn);
 	FGAEffectCueParams CueParams;
 	CueParams.HitResult = EffectIn.Context.HitResult;
-	OnEffectApplied.Broadcast(HandleIn, HandleIn.GetEffectPtr()->OwnedTags);
+	OnEffectApplied.Broadcast(HandleIn, HandleIn.GetEffectRef().OwnedTags);
+	//instant effects, and effects which only stacked on existing one, are done at this point,
+	//nothing will reference them anymore.
+	if (!GameEffectContainer.IsEffectActive(HandleIn))
+	{
+		FGAEffectPool::Get().Release(HandleIn);
+	}
 	return FGAEffectHandle();
 }
 FGAEffectHandle UGAAbilitiesComponent::ApplyEffectToTarget(const FGAEffect& EffectIn
@@ -56,28 +73,95 @@ FGAEffectHandle UGAAbilitiesComponent::ApplyEffectToTarget(const FGAEffect& Effe
 	FGAEffectCueParams CueParams;
 	CueParams.HitResult = EffectIn.Context.HitResult;
 	//execute cue from effect regardless if we have target object or not.
-
-	MulticastApplyEffectCue(HandleIn, CueParams);
+	FGAEffectCueBatcher::QueueCue(this, HandleIn, CueParams);
 
 	if (EffectIn.IsValid() && EffectIn.Context.TargetComp.IsValid())
 	{
-		OnEffectApplyToTarget.Broadcast(HandleIn, HandleIn.GetEffectPtr()->OwnedTags);
+		OnEffectApplyToTarget.Broadcast(HandleIn, HandleIn.GetEffectRef().OwnedTags);
 		return EffectIn.Context.TargetComp->ApplyEffectToSelf(EffectIn, HandleIn);
 	}
+	//there is no one to apply effect to, so don't leave it hanging in pool.
+	FGAEffectPool::Get().Release(HandleIn);
 	return FGAEffectHandle();
 }
+TArray<FGAEffectHandle> UGAAbilitiesComponent::ApplyEffectToTargets(const FGAEffectSpec& SpecIn,
+	const TArray<FHitResult>& HitsIn, class APawn* Instigator, UObject* Causer)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ApplyEffectToTargets);
+	TArray<FGAEffectHandle> Handles;
+	if (!SpecIn.Spec || HitsIn.Num() == 0)
+	{
+		return Handles;
+	}
+	//instigator side of context is the same for every target.
+	FGAEffectContext BaseContext(nullptr, DefaultAttributes, FVector::ZeroVector, nullptr,
+		Causer, Instigator, nullptr, this);
+	if (!BaseContext.IsValid())
+	{
+		return Handles;
+	}
+	//only instant effects are resolved right away. Periodic and duration effects evaluate
+	//magnitude on every application, and must see instigator attributes as they change.
+	const bool bInstigatorMagnitude = SpecIn.Spec->EffectType == EGAEffectType::Instant
+		&& SpecIn.Spec->AtributeModifier.Magnitude.IsInstigatorOnly();
+	const float InstigatorMagnitude = bInstigatorMagnitude
+		? SpecIn.Spec->GetModifierEvaluator().Evaluate(BaseContext, FGAEffectHandle()) : 0;
+
+	TArray<FGAEffectHandle> PendingHandles;
+	PendingHandles.Reserve(HitsIn.Num());
+	for (const FHitResult& Hit : HitsIn)
+	{
+		FGAEffectCueParams CueParams;
+		CueParams.HitResult = Hit;
+
+		AActor* TargetActor = Hit.GetActor();
+		IIGAAbilities* TargetInt = Cast<IIGAAbilities>(TargetActor);
+		UGAAbilitiesComponent* TargetComp = TargetInt ? TargetInt->GetAbilityComp() : nullptr;
+		if (!TargetComp)
+		{
+			//cue still plays at hit location, but there is nothing to apply effect to.
+			FGAEffectCueBatcher::QueueCue(this, FGAEffectHandle(), CueParams);
+			continue;
+		}
+		FGAEffectContext Context = BaseContext;
+		Context.TargetAttributes = TargetInt->GetAttributes();
+		Context.TargetHitLocation = Hit.Location;
+		Context.Target = TargetActor;
+		Context.TargetComp = TargetComp;
+		Context.HitResult = Hit;
+
+		FGAEffectHandle Handle = FGAEffectHandle::GenerateHandle(SpecIn.Spec, Context);
+		FGAEffect& Effect = Handle.GetEffectRef();
+		AddTagsToEffect(&Effect);
+		if (bInstigatorMagnitude)
+		{
+			Effect.SetCachedMagnitude(InstigatorMagnitude);
+		}
+		FGAEffectCueBatcher::QueueCue(this, Handle, CueParams);
+		PendingHandles.Add(Handle);
+	}
+
+	for (const FGAEffectHandle& Handle : PendingHandles)
+	{
+		FGAEffect& Effect = Handle.GetEffectRef();
+		OnEffectApplyToTarget.Broadcast(Handle, Effect.OwnedTags);
+		Effect.Context.TargetComp->ApplyEffectToSelf(Effect, Handle);
+		//instant effects are already released.
+		if (Handle.IsValid())
+		{
+			Handles.Add(Handle);
+		}
+	}
+	return Handles;
+}
 
 FGAEffectHandle UGAAbilitiesComponent::MakeGameEffect(TSubclassOf<class UGAGameEffectSpec> SpecIn,
 	const FGAEffectContext& ContextIn)
 {
-	FGAEffect* effect = new FGAEffect(SpecIn.GetDefaultObject(), ContextIn);
-	if (effect)
-	{
-		effect->OwnedTags.AppendTags(effect->GameEffect->OwnedTags);
-		effect->ApplyTags.AppendTags(effect->GameEffect->ApplyTags);
-	}
-	FGAEffectHandle handle = FGAEffectHandle::GenerateHandle(effect);
-	effect->Handle = handle;
+	FGAEffectHandle handle = FGAEffectHandle::GenerateHandle(SpecIn.GetDefaultObject(), ContextIn);
+	FGAEffect& effect = handle.GetEffectRef();
+	effect.OwnedTags.AppendTags(effect.GameEffect->OwnedTags);
+	effect.ApplyTags.AppendTags(effect.GameEffect->ApplyTags);
 	return handle;
 }
 
@@ -88,6 +172,10 @@ void UGAAbilitiesComponent::ExecuteEffect(FGAEffectHandle HandleIn)
 	WE do not make any replication at the ApplyEffect because some effect might want to apply cues
 	on periods on expiration etc, and all those will go trouch ExecuteEffect path.
 	*/
+	if (!HandleIn.IsValid())
+	{
+		return;
+	}
 	OnEffectExecuted.Broadcast(HandleIn, HandleIn.GetEffectSpec()->OwnedTags);
 	UE_LOG(GameAttributesEffects, Log, TEXT("UGAAbilitiesComponent:: Effect %s executed"), *HandleIn.GetEffectSpec()->GetName());
 	FGAEffect& Effect = HandleIn.GetEffectRef();
@@ -95,7 +183,6 @@ void UGAAbilitiesComponent::ExecuteEffect(FGAEffectHandle HandleIn)
 
 	//execute period regardless if this periodic effect ? Or maybe change name OnEffectExecuted ?
 	Effect.OnEffectPeriod.ExecuteIfBound();
-	MulticastExecuteEffectCue(HandleIn);
 
 	HandleIn.ExecuteEffect(HandleIn, Mod, HandleIn.GetContextRef());
 
@@ -103,26 +190,42 @@ void UGAAbilitiesComponent::ExecuteEffect(FGAEffectHandle HandleIn)
 }
 void UGAAbilitiesComponent::ExpireEffect(FGAEffectHandle HandleIn)
 {
+	if (!HandleIn.IsValid())
+	{
+		return;
+	}
+	//effect is released on removal, spec outlives it.
+	UGAGameEffectSpec* Spec = HandleIn.GetEffectSpec();
 	//call effect internal delegate:
-	HandleIn.GetEffectPtr()->OnExpired();
-	InternalRemoveEffect(HandleIn);
-	OnEffectExpired.Broadcast(HandleIn, HandleIn.GetEffectSpec()->OwnedTags);
+	HandleIn.GetEffectRef().OnExpired();
+	//delegate might have removed effect already.
+	if (HandleIn.IsValid())
+	{
+		InternalRemoveEffect(HandleIn);
+	}
+	OnEffectExpired.Broadcast(HandleIn, Spec->OwnedTags);
+}
+void UGAAbilitiesComponent::TickEffectTimers()
+{
+	GameEffectContainer.TickEffectTimers();
 }
 void UGAAbilitiesComponent::RemoveEffect(FGAEffectHandle& HandleIn)
 {
+	if (!HandleIn.IsValid())
+	{
+		return;
+	}
+	UGAGameEffectSpec* Spec = HandleIn.GetEffectSpec();
 	InternalRemoveEffect(HandleIn);
-	OnEffectRemoved.Broadcast(HandleIn, HandleIn.GetEffectSpec()->OwnedTags);
+	OnEffectRemoved.Broadcast(HandleIn, Spec->OwnedTags);
 }
 void UGAAbilitiesComponent::InternalRemoveEffect(FGAEffectHandle& HandleIn)
 {
-	FTimerManager& timer = GetWorld()->GetTimerManager();
-	timer.ClearTimer(HandleIn.GetEffectRef().PeriodTimerHandle);
-	timer.ClearTimer(HandleIn.GetEffectRef().DurationTimerHandle);
+	//timers are cancelled by container, when effect is removed.
 	UE_LOG(GameAttributesEffects, Log, TEXT("UGAAbilitiesComponent:: Reset Timers and Remove Effect"));
 
 	FGAEffect& Effect = HandleIn.GetEffectRef();
 	FGAEffectMod Mod = Effect.GetAttributeModifier();
-	MulticastRemoveEffectCue(HandleIn);
 	//periodic effects do not apply duration based modifiers to attributes.
 	//yet in anycase.
 	GameEffectContainer.RemoveEffect(HandleIn);
@@ -151,6 +254,18 @@ TArray<FGAEffectUIData> UGAAbilitiesComponent::GetEffectUIData()
 	return dataReturn;
 }
 
+float UGAAbilitiesComponent::GetEffectRemainingTime(const FGAEffectRepInfo& EffectInfo) const
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return -1;
+	}
+	AGameStateBase* GameState = World->GetGameState();
+	const float ServerTime = GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+	return EffectInfo.GetRemainingTime(ServerTime);
+}
+
 int32 UGAAbilitiesComponent::GetEffectUIIndex()
 {
 	return 1;
@@ -161,38 +276,14 @@ FGAEffectUIData UGAAbilitiesComponent::GetEffectUIDataByIndex(int32 IndexIn)
 	return data;
 }
 
-void UGAAbilitiesComponent::MulticastApplyEffectCue_Implementation(FGAEffectHandle EffectHandle, FGAEffectCueParams CueParams)
-{
-	float test = 0;
-	ActiveCues.AddCue(EffectHandle, CueParams);
-}
-
-void UGAAbilitiesComponent::MulticastExecuteEffectCue_Implementation(FGAEffectHandle EffectHandle)
-{
-	//	ActiveCues.ExecuteCue(EffectHandle);
-}
-
-void UGAAbilitiesComponent::MulticastRemoveEffectCue_Implementation(FGAEffectHandle EffectHandle)
-{
-	//	ActiveCues.RemoveCue(EffectHandle);
-}
-
-void UGAAbilitiesComponent::MulticastUpdateDurationCue_Implementation(FGAEffectHandle EffectHandle, float NewDurationIn)
+void UGAAbilitiesComponent::ClientPlayEffectCues_Implementation(const TArray<FGAEffectCueEvent>& Cues)
 {
-
-}
-void UGAAbilitiesComponent::MulticastUpdatePeriodCue_Implementation(FGAEffectHandle EffectHandle, float NewPeriodIn)
-{
-
-}
-void UGAAbilitiesComponent::MulticastUpdateTimersCue_Implementation(FGAEffectHandle EffectHandle, float NewDurationIn, float NewPeriodIn)
-{
-
+	for (const FGAEffectCueEvent& Cue : Cues)
+	{
+		FGAEffectCueBatcher::PlayCue(Cue);
+	}
 }
-void UGAAbilitiesComponent::MulticastExtendDurationCue_Implementation(FGAEffectHandle EffectHandle, float NewDurationIn)
-{
 
-}
 
 
 float UGAAbilitiesComponent::ModifyAttribute(FGAEffectMod& ModIn, const FGAEffectHandle& HandleIn)
@@ -317,11 +408,8 @@ FGAEffectHandle UGAAbilitiesComponent::GenerateEffect(const FGAEffectSpec& SpecI
 	}
 	else
 	{
-		FGAEffect* effect = new FGAEffect(SpecIn.Spec, Context);
-		AddTagsToEffect(effect);
-		//FGAEffectHandle& HandleCon = const_cast<FGAEffectHandle&>(HandleIn);
-		HandleIn = FGAEffectHandle::GenerateHandle(effect);
-		effect->Handle = HandleIn;
+		HandleIn = FGAEffectHandle::GenerateHandle(SpecIn.Spec, Context);
+		AddTagsToEffect(HandleIn.GetEffectPtr());
 	}
 	return HandleIn;
 }
@@ -390,7 +478,10 @@ bool UGAAbilitiesComponent::HasAnyMatchingGameplayTags(const FGameplayTagContain
 
 void FGASAbilityItem::PreReplicatedRemove(const struct FGASAbilityContainer& InArraySerializer)
 {
-
+	if (Ability)
+	{
+		Ability->ReleaseActorCue();
+	}
 }
 void FGASAbilityItem::PostReplicatedAdd(const struct FGASAbilityContainer& InArraySerializer)
 {
@@ -500,6 +591,13 @@ void UGAAbilitiesComponent::UninitializeComponent()
 {
 	Super::UninitializeComponent();
 	//GameEffectContainer
+	for (FGASAbilityItem& Item : AbilityContainer.AbilitiesItems)
+	{
+		if (Item.Ability)
+		{
+			Item.Ability->ReleaseActorCue();
+		}
+	}
 }
 void UGAAbilitiesComponent::BP_BindAbilityToAction(FGameplayTag ActionName, FGameplayTag AbilityTag)
 {
@@ -17,12 +17,14 @@
 
 DECLARE_STATS_GROUP(TEXT("AttributeComponent"), STATGROUP_AttributeComponent, STATCAT_Advanced);
 DECLARE_CYCLE_STAT_EXTERN(TEXT("AttributeComponentApplyEffect"), STAT_ApplyEffect, STATGROUP_AttributeComponent, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("AttributeComponentApplyEffectToTargets"), STAT_ApplyEffectToTargets, STATGROUP_AttributeComponent, );
 DECLARE_CYCLE_STAT_EXTERN(TEXT("AttributeComponentModifyAttribute"), STAT_ModifyAttribute, STATGROUP_AttributeComponent, );
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FGAOnAttributeChanged);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGAOnAttributeModifed, const FGAModifiedAttribute&, attr);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGAGenericEffectDelegate, const FGAEffectHandle&, Handle, const FGameplayTagContainer&, Tags);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGAEffectInfoDelegate, const FGAEffectRepInfo&, EffectInfo);
 USTRUCT()
 struct FJumpNowMessage
 {
@@ -211,10 +213,24 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Effect")
 		FGAGenericEffectDelegate OnEffectRemoved;
 
+	/*
+		Called on server and clients, when replicated info about active effect has been added,
+		changed (extended) or removed. Use it for UI, instead of polling effects.
+	*/
+	UPROPERTY(BlueprintAssignable, Category = "Effect")
+		FGAEffectInfoDelegate OnEffectInfoAdded;
+	UPROPERTY(BlueprintAssignable, Category = "Effect")
+		FGAEffectInfoDelegate OnEffectInfoChanged;
+	UPROPERTY(BlueprintAssignable, Category = "Effect")
+		FGAEffectInfoDelegate OnEffectInfoRemoved;
+
 	/* NEW EFFECT SYSTEM */
 	UPROPERTY(ReplicatedUsing = OnRep_GameEffectContainer)
 		FGAEffectContainer GameEffectContainer;
 
+	/* Attribute changes and effects on this component are recorded to FGACombatTrace. */
+	bool bCaptureCombatTrace;
+
 	TMap<FGameplayTag, FGAGenericDelegate> GenericTagEvents;
 
 	UFUNCTION()
@@ -257,6 +273,14 @@ public:
 		const FGAEffectHandle& HandleIn);
 	FGAEffectHandle ApplyEffectToTarget(const FGAEffect& EffectIn,
 		const FGAEffectHandle& HandleIn);
+	/*
+		Applies the same effect from this component to every hit (AoE).
+		Instigator part of context and magnitudes which depend only on instigator are
+		made once for all targets, and cues are sent in single RPC.
+		Returns handles of effects which are still active after application.
+	*/
+	TArray<FGAEffectHandle> ApplyEffectToTargets(const FGAEffectSpec& SpecIn,
+		const TArray<FHitResult>& HitsIn, class APawn* Instigator, UObject* Causer);
 
 	FGAEffectHandle MakeGameEffect(TSubclassOf<class UGAGameEffectSpec> SpecIn,
 		const FGAEffectContext& ContextIn);
@@ -265,6 +289,8 @@ public:
 	void ExecuteEffect(FGAEffectHandle HandleIn);
 	/* ExpireEffect is used to remove existing effect naturally when their time expires. */
 	void ExpireEffect(FGAEffectHandle HandleIn);
+	/* Advances effect timers of GameEffectContainer. */
+	void TickEffectTimers();
 	/* RemoveEffect is used to remove effect by force. */
 	void RemoveEffect(FGAEffectHandle& HandleIn);
 	void InternalRemoveEffect(FGAEffectHandle& HandleIn);
@@ -278,6 +304,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Game Attributes | UI")
 		TArray<FGAEffectUIData> GetEffectUIData();
 
+	/* Time left on replicated effect, computed from server time. -1 for infinite effects. */
+	UFUNCTION(BlueprintPure, Category = "Game Attributes | UI")
+		float GetEffectRemainingTime(const FGAEffectRepInfo& EffectInfo) const;
+
 	/*
 	Get Last Index of effect for UI display.
 	*/
@@ -290,29 +320,10 @@ public:
 	Need prediction for spawning effects on client,
 	and then on updateing them predicitvely on all other clients.
 	*/
-	/*
-
-	*/
-	UFUNCTION(NetMulticast, Unreliable)
-		void MulticastApplyEffectCue(FGAEffectHandle EffectHandle, FGAEffectCueParams CueParams);
-
-	UFUNCTION(NetMulticast, Unreliable)
-		void MulticastExecuteEffectCue(FGAEffectHandle EffectHandle);
-
-	UFUNCTION(NetMulticast, Unreliable)
-		void MulticastRemoveEffectCue(FGAEffectHandle EffectHandle);
-
-	UFUNCTION(NetMulticast, Unreliable)
-		void MulticastUpdateDurationCue(FGAEffectHandle EffectHandle, float NewDurationIn);
-
-	UFUNCTION(NetMulticast, Unreliable)
-		void MulticastUpdatePeriodCue(FGAEffectHandle EffectHandle, float NewPeriodIn);
-
-	UFUNCTION(NetMulticast, Unreliable)
-		void MulticastUpdateTimersCue(FGAEffectHandle EffectHandle, float NewDurationIn, float NewPeriodIn);
+	/* Cues gathered by FGAEffectCueBatcher during server frame, relevant to owning connection. */
+	UFUNCTION(Client, Unreliable)
+		void ClientPlayEffectCues(const TArray<FGAEffectCueEvent>& Cues);
 
-	UFUNCTION(NetMulticast, Unreliable)
-		void MulticastExtendDurationCue(FGAEffectHandle EffectHandle, float NewDurationIn);
 
 	//////////// EFFECTS HANDLING
 	/////////////////////////////////////////////////
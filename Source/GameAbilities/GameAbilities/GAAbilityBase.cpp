@@ -10,6 +10,7 @@
 #include "GAAbilitiesComponent.h"
 
 #include "AbilityCues/GACueActor.h"
+#include "AbilityCues/GACueActorPool.h"
 #include "GameplayTagContainer.h"
 #include "Net/UnrealNetwork.h"
 #include "Animation/AnimMontage.h"
@@ -59,23 +60,7 @@ void UGAAbilityBase::InitAbility()
 }
 void UGAAbilityBase::OnRep_InitAbility()
 {
-	if (!ActorCue)
-	{
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.Instigator = POwner;
-		SpawnParams.Owner = POwner;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-		//can be null.
-		UWorld* world = GetWorld();
-		if (world)
-		{
-			ActorCue = world->SpawnActor<AGACueActor>(ActorCueClass, POwner->GetActorLocation(), FRotator(0, 0, 0), SpawnParams);
-			if (ActorCue)
-			{
-				ActorCue->OwningAbility = this;
-			}
-		}
-	}
+	//actor cue is taken from pool, when it's activated. See ActivateActorCue.
 }
 void UGAAbilityBase::OnNativeInputPressed(FGameplayTag ActionName)
 {
@@ -161,6 +146,7 @@ void UGAAbilityBase::NativeOnAbilityActivationCancel()
 	OnConfirmDelegate.RemoveAll(this);
 
 	OnAbilityActivationCancel();
+	ReleaseActorCue();
 	//AbilityActivatedCounter++;
 }
 void UGAAbilityBase::OnActivationEffectPeriod()
@@ -186,6 +172,7 @@ void UGAAbilityBase::NativeFinishAbility()
 	{
 		ActivationEffectHandle.GetContextRef().InstigatorComp->RemoveEffect(ActivationEffectHandle);
 	}
+	ReleaseActorCue();
 	//remove effect.
 }
 /* Functions for activation effect delegates */
@@ -225,7 +212,7 @@ bool UGAAbilityBase::ApplyCooldownEffect()
 	}
 	FHitResult Hit(ForceInit);
 	FGAEffectContext Context = UGABlueprintLibrary::MakeContext(this, POwner, this, Hit);
-	float DurationCheck = ActivationEffect.Spec->Duration.GetFloatValue(Context);
+	float DurationCheck = ActivationEffect.Spec->GetDurationEvaluator().Evaluate(Context, FGAEffectHandle());
 	if (DurationCheck > 0)
 	{
 		UE_LOG(GameAbilities, Log, TEXT("Set cooldown effect in Ability: %s"), *GetName());
@@ -235,7 +222,7 @@ bool UGAAbilityBase::ApplyCooldownEffect()
 		if (CooldownHandle.IsValid())
 		{
 			LastCooldownTime = GetWorld()->GetTimeSeconds();
-			TSharedPtr<FGAEffect> Effect = CooldownHandle.GetEffectPtr();
+			FGAEffect* Effect = CooldownHandle.GetEffectPtr();
 			if (!Effect->OnEffectExpired.IsBound())
 			{
 				UE_LOG(GameAbilities, Log, TEXT("Bind effect cooldown in Ability: %s"), *GetName());
@@ -253,7 +240,7 @@ bool UGAAbilityBase::ApplyActivationEffect()
 		return false;
 	FHitResult Hit(ForceInit);
 	FGAEffectContext Context = UGABlueprintLibrary::MakeContext(this, POwner, this, Hit);
-	float DurationCheck = ActivationEffect.Spec->Duration.GetFloatValue(Context);
+	float DurationCheck = ActivationEffect.Spec->GetDurationEvaluator().Evaluate(Context, FGAEffectHandle());
 	if (DurationCheck > 0 || ActivationEffect.Spec->EffectType == EGAEffectType::Infinite)
 	{
 		UE_LOG(GameAbilities, Log, TEXT("Set expiration effect in Ability: %s"), *GetName());
@@ -269,7 +256,7 @@ bool UGAAbilityBase::ApplyActivationEffect()
 				AttributeComponent = ActivationEffectHandle.GetContext().InstigatorComp.Get();
 			}
 			LastActivationTime = GetWorld()->GetTimeSeconds();
-			TSharedPtr<FGAEffect> Effect = ActivationEffectHandle.GetEffectPtr();
+			FGAEffect* Effect = ActivationEffectHandle.GetEffectPtr();
 			if (!Effect->OnEffectExpired.IsBound())
 			{
 				UE_LOG(GameAbilities, Log, TEXT("Bind effect expiration in Ability: %s"), *GetName());
@@ -462,11 +449,9 @@ FGAEffectHandle UGAAbilityBase::ApplyEffectToActor(const FGAEffectSpec& SpecIn,
 	}
 	else
 	{
-		FGAEffect* effect = new FGAEffect(SpecIn.Spec, Context);
+		HandleIn = FGAEffectHandle::GenerateHandle(SpecIn.Spec, Context);
+		FGAEffect* effect = HandleIn.GetEffectPtr();
 		AddTagsToEffect(effect);
-		//FGAEffectHandle& HandleCon = const_cast<FGAEffectHandle&>(HandleIn);
-		HandleIn = FGAEffectHandle::GenerateHandle(effect);
-		effect->Handle = HandleIn;
 		effect->Ability = this;
 		effect->OwnedTags.AppendTags(OwnedTags);
 	}
@@ -478,9 +463,22 @@ FGAEffectHandle UGAAbilityBase::ApplyEffectFromHit(const FGAEffectSpec& SpecIn,
 	UObject* Causer)
 {
 	HandleIn = UGAAbilitiesComponent::GenerateEffect(SpecIn, HandleIn, HitIn, Instigator, Causer);
+	if (!HandleIn.IsValid())
+	{
+		return HandleIn;
+	}
 	HandleIn.GetContextRef().InstigatorComp->ApplyEffectToTarget(HandleIn.GetEffect(), HandleIn);
 	return HandleIn;
 }
+TArray<FGAEffectHandle> UGAAbilityBase::ApplyEffectToTargets(const FGAEffectSpec& SpecIn,
+	const TArray<FHitResult>& HitsIn, class APawn* Instigator, UObject* Causer)
+{
+	if (!AbilityComponent)
+	{
+		return TArray<FGAEffectHandle>();
+	}
+	return AbilityComponent->ApplyEffectToTargets(SpecIn, HitsIn, Instigator, Causer);
+}
 void UGAAbilityBase::RemoveEffectFromActor(FGAEffectHandle& HandleIn, class AActor* TargetIn)
 {
 	IIGAAbilities* TargetAttr = Cast<IIGAAbilities>(TargetIn);
@@ -581,14 +579,37 @@ void UGAAbilityBase::PlayMontage(UAnimMontage* MontageIn, FName SectionName, flo
 
 void UGAAbilityBase::ActivateActorCue(FVector Location)
 {
+	UWorld* World = GetWorld();
+	if (!ActorCue && World)
+	{
+		//can be null. Pool takes actor back, when owner is gone.
+		ActorCue = FGACueActorPool::Acquire(World, ActorCueClass, Location, POwner, POwner);
+		if (ActorCue)
+		{
+			ActorCue->OwningAbility = this;
+		}
+	}
 	if (ActorCue)
 	{
-
 		ActorCue->SetActorLocation(Location);
 		ActorCue->SetActorHiddenInGame(false);
 		ActorCue->OnActivated();
 	}
 }
+void UGAAbilityBase::ReleaseActorCue()
+{
+	if (!ActorCue)
+	{
+		return;
+	}
+	//pool might have taken it back already, and handed to someone else.
+	if (ActorCue->OwningAbility == this)
+	{
+		ActorCue->OnDeactivated();
+		FGACueActorPool::Release(ActorCue);
+	}
+	ActorCue = nullptr;
+}
 
 void UGAAbilityBase::MulticastActivateActorCue_Implementation(FVector Location)
 {
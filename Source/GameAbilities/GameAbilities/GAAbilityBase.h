@@ -450,14 +450,24 @@ public:
 		FGAEffectHandle ApplyEffectFromHit(const FGAEffectSpec& SpecIn,
 			FGAEffectHandle HandleIn, const FHitResult& HitIn, class APawn* Instigator,
 			UObject* Causer);
+	/* Applies effect to every hit at once. Use it instead of ApplyEffectFromHit for AoE. */
+	UFUNCTION(BlueprintCallable, Category = "Game Abilities System")
+		TArray<FGAEffectHandle> ApplyEffectToTargets(const FGAEffectSpec& SpecIn,
+			const TArray<FHitResult>& HitsIn, class APawn* Instigator, UObject* Causer);
 
 	void RemoveEffectFromActor(FGAEffectHandle& HandleIn, class AActor* TargetIn);
 
 	/*
 		Cues handling
 	*/
+	/* Takes ActorCueClass actor from FGACueActorPool, if ability doesn't have one yet, and activates it. */
 	UFUNCTION(BlueprintCallable, Category = "Game Abilities System | Cues")
 		void ActivateActorCue(FVector Location);
+	/*
+		Gives actor cue back to FGACueActorPool. Called when ability finishes, is cancelled
+		or removed.
+	*/
+	void ReleaseActorCue();
 	UFUNCTION(NetMulticast, Reliable, Category = "Game Abilities System | Cues")
 		void MulticastActivateActorCue(FVector Location);
 	void MulticastActivateActorCue_Implementation(FVector Location);
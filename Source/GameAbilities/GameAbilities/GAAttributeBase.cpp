@@ -7,6 +7,7 @@
 #include "IGAAbilities.h"
 
 #include "GAAttributeBase.h"
+#include "GACombatTrace.h"
 DEFINE_STAT(STAT_CalculateBonus);
 DEFINE_STAT(STAT_CurrentBonusByTag);
 DEFINE_STAT(STAT_FinalBonusByTag);
@@ -46,25 +47,19 @@ float FGAAttributeBase::Modify(const FGAEffectMod& ModIn, const FGAEffectHandle&
 		case EGAAttributeMod::Add:
 		{
 			float OldCurrentValue = CurrentValue;
-			UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Add:: OldCurrentValue: %f"), OldCurrentValue);
-			UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Add:: AddValue: %f"), ModIn.Value);
 			float Val = CurrentValue - (OldCurrentValue + ModIn.Value);
-			UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Add:: ActuallAddVal: %f"), Val);
 			CurrentValue -= Val;
 			CurrentValue = FMath::Clamp<float>(CurrentValue, 0, GetFinalValue());
-			UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Add:: CurrentValue: %f"), CurrentValue);
+			FGACombatTrace::RecordModify(HandleIn, ModIn.Attribute, OldCurrentValue, CurrentValue);
 			return CurrentValue;
 		}
 		case EGAAttributeMod::Subtract:
 		{
 			float OldCurrentValue = CurrentValue;
-			UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Subtract:: OldCurrentValue: %f"), OldCurrentValue);
-			UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Subtract:: SubtractValue: %f"), ModIn.Value);
 			float Val = CurrentValue - (OldCurrentValue - ModIn.Value);
-			UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Subtract:: ActuallSubtractVal: %f"), Val);
 			CurrentValue -= Val;
 			CurrentValue = FMath::Clamp<float>(CurrentValue, 0, GetFinalValue());
-			UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Subtract:: CurrentValue: %f"), CurrentValue);
+			FGACombatTrace::RecordModify(HandleIn, ModIn.Attribute, OldCurrentValue, CurrentValue);
 			return CurrentValue;
 		}
 		case EGAAttributeMod::Multiply:
@@ -108,31 +103,51 @@ void FGAAttributeBase::AddBonus(const FGAModifier& ModifiersIn, const FGAEffectH
 		break;
 	}*/
 
-	FGAModifier& modsTemp = Modifiers.FindOrAdd(Handle);
-	modsTemp = ModifiersIn;
-	CalculateBonus();
+	FGAModifier* OldMod = Modifiers.Find(Handle);
+	if (OldMod)
+	{
+		AccumulateBonus(*OldMod, -1);
+		*OldMod = ModifiersIn;
+	}
+	else
+	{
+		Modifiers.Add(Handle, ModifiersIn);
+	}
+	AccumulateBonus(ModifiersIn, 1);
+	UpdateBonus();
 }
 void FGAAttributeBase::RemoveBonus(const FGAEffectHandle& Handle)
 {
-	Modifiers.Remove(Handle);
-	CalculateBonus();
+	FGAModifier OldMod;
+	if (Modifiers.RemoveAndCopyValue(Handle, OldMod))
+	{
+		AccumulateBonus(OldMod, -1);
+		UpdateBonus();
+	}
 }
 
 void FGAAttributeBase::RemoveBonusByType(EGAAttributeMod ModType)
 {
+	bool bRemoved = false;
 	for (auto It = Modifiers.CreateIterator(); It; ++It)
 	{
 		const FGAModifier& mod = It->Value;
 		//check if current attribute mod have the same mod
 		if (mod.AttributeMod == ModType)
 		{
-			Modifiers.Remove(It.Key());
+			AccumulateBonus(mod, -1);
+			It.RemoveCurrent();
+			bRemoved = true;
 		}
 	}
-	CalculateBonus();
+	if (bRemoved)
+	{
+		UpdateBonus();
+	}
 }
 void FGAAttributeBase::RemoveWeakerBonus(EGAAttributeMod ModType, float ValueIn)
 {
+	bool bRemoved = false;
 	for (auto It = Modifiers.CreateIterator(); It; ++It)
 	{
 		const FGAModifier& mod = It->Value;
@@ -141,59 +156,111 @@ void FGAAttributeBase::RemoveWeakerBonus(EGAAttributeMod ModType, float ValueIn)
 			if (mod.AttributeMod == ModType
 				&& mod.Value <= ValueIn)
 			{
-				if (mod.AttributeMod == ModType)
-				{
-					Modifiers.Remove(It.Key());
-				}
+				AccumulateBonus(mod, -1);
+				It.RemoveCurrent();
+				bRemoved = true;
 			}
 
 	}
-	CalculateBonus();
+	if (bRemoved)
+	{
+		UpdateBonus();
+	}
 }
 
 void FGAAttributeBase::RemoveBonusType(EGAAttributeMod ModType)
 {
-	for (auto It = Modifiers.CreateIterator(); It; ++It)
+	RemoveBonusByType(ModType);
+}
+
+void FGAAttributeBase::AccumulateBonus(const FGAModifier& ModIn, float Sign)
+{
+	const float Value = ModIn.Value * Sign;
+	switch (ModIn.AttributeMod)
 	{
-		const FGAModifier& mod = It->Value;
-			//check if current attribute mod have the same mod
-			if (mod.AttributeMod == ModType)
-			{
-				Modifiers.Remove(It.Key());
-			}
+	case EGAAttributeMod::Add:
+		BonusMods.Additive += Value;
+		break;
+	case EGAAttributeMod::Subtract:
+		BonusMods.Subtractive += Value;
+		break;
+	case EGAAttributeMod::Multiply:
+		BonusMods.Multiplicative += Value;
+		break;
+	case EGAAttributeMod::Divide:
+		BonusMods.Divide += Value;
+		break;
+	case EGAAttributeMod::PercentageAdd:
+		BonusMods.PercentageAdd += Value;
+		break;
+	case EGAAttributeMod::PercentageSubtract:
+		BonusMods.PercentageSubtract += Value;
+		break;
+	default:
+		break;
 	}
-	CalculateBonus();
 }
-
+FGAIndividualMods FGAAttributeBase::SumModifiers(const TMap<FGAEffectHandle, FGAModifier>& ModifiersIn)
+{
+	FGAIndividualMods Sums;
+	for (auto ModIt = ModifiersIn.CreateConstIterator(); ModIt; ++ModIt)
+	{
+		const FGAModifier& mod = ModIt->Value;
+		switch (mod.AttributeMod)
+		{
+		case EGAAttributeMod::Add:
+			Sums.Additive += mod.Value;
+			break;
+		case EGAAttributeMod::Subtract:
+			Sums.Subtractive += mod.Value;
+			break;
+		case EGAAttributeMod::Multiply:
+			Sums.Multiplicative += mod.Value;
+			break;
+		case EGAAttributeMod::Divide:
+			Sums.Divide += mod.Value;
+			break;
+		case EGAAttributeMod::PercentageAdd:
+			Sums.PercentageAdd += mod.Value;
+			break;
+		case EGAAttributeMod::PercentageSubtract:
+			Sums.PercentageSubtract += mod.Value;
+			break;
+		default:
+			break;
+		}
+	}
+	return Sums;
+}
 void FGAAttributeBase::CalculateBonus()
 {
 	SCOPE_CYCLE_COUNTER(STAT_CalculateBonus);
-	float AdditiveBonus = 0;
-	float SubtractBonus = 0;
-	float MultiplyBonus = 1;
-	float DivideBonus = 1;
-	auto ModIt = Modifiers.CreateConstIterator();
-	for (ModIt; ModIt; ++ModIt)
+	BonusMods = SumModifiers(Modifiers);
+	UpdateBonus();
+}
+bool FGAAttributeBase::IsBonusConsistent() const
+{
+	FGAIndividualMods Sums = SumModifiers(Modifiers);
+	return FMath::IsNearlyEqual(Sums.Additive, BonusMods.Additive, KINDA_SMALL_NUMBER)
+		&& FMath::IsNearlyEqual(Sums.Subtractive, BonusMods.Subtractive, KINDA_SMALL_NUMBER)
+		&& FMath::IsNearlyEqual(Sums.Multiplicative, BonusMods.Multiplicative, KINDA_SMALL_NUMBER)
+		&& FMath::IsNearlyEqual(Sums.Divide, BonusMods.Divide, KINDA_SMALL_NUMBER)
+		&& FMath::IsNearlyEqual(Sums.PercentageAdd, BonusMods.PercentageAdd, KINDA_SMALL_NUMBER)
+		&& FMath::IsNearlyEqual(Sums.PercentageSubtract, BonusMods.PercentageSubtract, KINDA_SMALL_NUMBER);
+}
+
+void FGAAttributeBase::UpdateBonus()
+{
+	ModifiersGeneration++;
+	//don't let float error accumulate, when there is nothing left.
+	if (Modifiers.Num() == 0)
 	{
-		const FGAModifier& mod = ModIt->Value;
-			switch (mod.AttributeMod)
-			{
-			case EGAAttributeMod::Add:
-				AdditiveBonus += mod.Value;
-				break;
-			case EGAAttributeMod::Subtract:
-				SubtractBonus += mod.Value;
-				break;
-			case EGAAttributeMod::Multiply:
-				MultiplyBonus += mod.Value;
-				break;
-			case EGAAttributeMod::Divide:
-				DivideBonus += mod.Value;
-				break;
-			default:
-				break;
-			}
+		BonusMods = FGAIndividualMods();
 	}
+	float AdditiveBonus = BonusMods.Additive;
+	float SubtractBonus = BonusMods.Subtractive;
+	float MultiplyBonus = 1 + BonusMods.Multiplicative;
+	float DivideBonus = 1 + BonusMods.Divide;
 	float OldBonus = BonusValue;
 	//calculate final bonus from modifiers values.
 	//we don't handle stacking here. It's checked and handled before effect is added.
@@ -246,15 +313,21 @@ void FGAAttributeBase::CalculateBonus()
 	CurrentValue = CurrentValue + (50); ??
 	*/
 }
-float FGAAttributeBase::GetCurrentValueByTags(const FGameplayTagContainer& TagsIn, FGAIndividualMods& Bonuses) const
+const FGAIndividualMods& FGAAttributeBase::GetBonusModsByTags(const FGameplayTagContainer& TagsIn) const
 {
-	SCOPE_CYCLE_COUNTER(STAT_CurrentBonusByTag);
-	float AdditiveBonus = 0;
-	float SubtractBonus = 0;
-	float MultiplyBonus = 0;
-	float DivideBonus = 1;
-	float PercentageAddBonus = 0;
-	float PercentageSubtractBonus = 0;
+	if (CachedBonusGeneration != ModifiersGeneration)
+	{
+		CachedBonusByTags.Reset();
+		CachedBonusGeneration = ModifiersGeneration;
+	}
+	//key owning copy of tags is only made, when sums are not cached yet.
+	const uint32 TagsHash = FGAHashedGameplayTagContainer::GetTagsHash(TagsIn);
+	const FGAIndividualMods* Cached = CachedBonusByTags.FindByHash(TagsHash, TagsIn);
+	if (Cached)
+	{
+		return *Cached;
+	}
+	FGAIndividualMods Sums;
 	auto ModIt = Modifiers.CreateConstIterator();
 	for (ModIt; ModIt; ++ModIt)
 	{
@@ -265,28 +338,38 @@ float FGAAttributeBase::GetCurrentValueByTags(const FGameplayTagContainer& TagsI
 				switch (mod.AttributeMod)
 				{
 				case EGAAttributeMod::Add:
-					AdditiveBonus += mod.Value;
+					Sums.Additive += mod.Value;
 					break;
 				case EGAAttributeMod::Subtract:
-					SubtractBonus += mod.Value;
+					Sums.Subtractive += mod.Value;
 					break;
 				case EGAAttributeMod::Multiply:
-					MultiplyBonus += mod.Value;
+					Sums.Multiplicative += mod.Value;
 					break;
 				case EGAAttributeMod::Divide:
-					DivideBonus += mod.Value;
+					Sums.Divide += mod.Value;
 					break;
 				case EGAAttributeMod::PercentageAdd:
-					PercentageAddBonus += mod.Value;
+					Sums.PercentageAdd += mod.Value;
 					break;
 				case EGAAttributeMod::PercentageSubtract:
-					PercentageSubtractBonus += mod.Value;
+					Sums.PercentageSubtract += mod.Value;
 					break;
 				default:
 					break;
 				}
 			}
 	}
+	return CachedBonusByTags.AddByHash(TagsHash, FGAHashedGameplayTagContainer(TagsIn), Sums);
+}
+float FGAAttributeBase::GetCurrentValueByTags(const FGameplayTagContainer& TagsIn, FGAIndividualMods& Bonuses) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_CurrentBonusByTag);
+	const FGAIndividualMods& Sums = GetBonusModsByTags(TagsIn);
+	float AdditiveBonus = Sums.Additive;
+	float SubtractBonus = Sums.Subtractive;
+	float MultiplyBonus = Sums.Multiplicative;
+	float DivideBonus = 1 + Sums.Divide;
 	float OldBonus = BonusValue;
 	float CurrentBonus = BonusValue;
 	//calculate final bonus from modifiers values.
@@ -298,102 +381,34 @@ float FGAAttributeBase::GetCurrentValueByTags(const FGameplayTagContainer& TagsI
 	float addValue = CurrentBonus - OldBonus;
 	//reset to max = 200
 	Bonuses = FGAIndividualMods(AdditiveBonus, SubtractBonus, MultiplyBonus,
-		DivideBonus, PercentageAddBonus, PercentageSubtractBonus);
+		DivideBonus, Sums.PercentageAdd, Sums.PercentageSubtract);
 	return CurrentValue + addValue;
 }
 float FGAAttributeBase::GetFinalValueByTags(const FGameplayTagContainer& TagsIn, FGAIndividualMods& Bonuses) const
 {
 	SCOPE_CYCLE_COUNTER(STAT_FinalBonusByTag);
-	float AdditiveBonus = 0;
-	float SubtractBonus = 0;
-	float MultiplyBonus = 1;
-	float DivideBonus = 1;
-	float PercentageAddBonus = 0;
-	float PercentageSubtractBonus = 0;
-	auto ModIt = Modifiers.CreateConstIterator();
-	for (ModIt; ModIt; ++ModIt)
-	{
-		const FGAModifier& mod = ModIt->Value;
-			if (ModIt->Key.HasAllTags(TagsIn))//mod.Handle->HasAllTags(TagsIn))
-			{
-				switch (mod.AttributeMod)
-				{
-				case EGAAttributeMod::Add:
-					AdditiveBonus += mod.Value;
-					break;
-				case EGAAttributeMod::Subtract:
-					SubtractBonus += mod.Value;
-					break;
-				case EGAAttributeMod::Multiply:
-					MultiplyBonus += mod.Value;
-					break;
-				case EGAAttributeMod::Divide:
-					DivideBonus += mod.Value;
-					break;
-				case EGAAttributeMod::PercentageAdd:
-					PercentageAddBonus += mod.Value;
-					break;
-				case EGAAttributeMod::PercentageSubtract:
-					PercentageSubtractBonus += mod.Value;
-					break;
-				default:
-					break;
-				}
-			}
-	}
-	float OldBonus = BonusValue;
-	float CurrentBonus = BonusValue;
+	const FGAIndividualMods& Sums = GetBonusModsByTags(TagsIn);
+	float AdditiveBonus = Sums.Additive;
+	float SubtractBonus = Sums.Subtractive;
+	float MultiplyBonus = 1 + Sums.Multiplicative;
+	float DivideBonus = 1 + Sums.Divide;
+	float CurrentBonus;
 	//calculate final bonus from modifiers values.
 	//we don't handle stacking here. It's checked and handled before effect is added.
 	CurrentBonus = (AdditiveBonus - SubtractBonus);
 	CurrentBonus = (CurrentBonus * MultiplyBonus);
 	CurrentBonus = (CurrentBonus / DivideBonus);
-	//this is absolute maximum (not clamped right now).
-	float addValue = CurrentBonus - OldBonus;
-	//reset to max = 200
 	Bonuses = FGAIndividualMods(AdditiveBonus, SubtractBonus, MultiplyBonus,
-		DivideBonus, PercentageAddBonus, PercentageSubtractBonus);
+		DivideBonus, Sums.PercentageAdd, Sums.PercentageSubtract);
 	return CurrentBonus + BaseValue;
 }
 float FGAAttributeBase::GetBonusValueByTags(const FGameplayTagContainer & TagsIn, FGAIndividualMods & Bonuses) const
 {
-	float AdditiveBonus = 0;
-	float SubtractBonus = 0;
-	float MultiplyBonus = 1;
-	float DivideBonus = 1;
-	float PercentageAddBonus = 0;
-	float PercentageSubtractBonus = 0;
-	auto ModIt = Modifiers.CreateConstIterator();
-	for (ModIt; ModIt; ++ModIt)
-	{
-		const FGAModifier& mod = ModIt->Value;
-			if (ModIt->Key.HasAllTags(TagsIn))//mod.Handle->HasAllTags(TagsIn))
-			{
-				switch (mod.AttributeMod)
-				{
-				case EGAAttributeMod::Add:
-					AdditiveBonus += mod.Value;
-					break;
-				case EGAAttributeMod::Subtract:
-					SubtractBonus += mod.Value;
-					break;
-				case EGAAttributeMod::Multiply:
-					MultiplyBonus += mod.Value;
-					break;
-				case EGAAttributeMod::Divide:
-					DivideBonus += mod.Value;
-					break;
-				case EGAAttributeMod::PercentageAdd:
-					PercentageAddBonus += mod.Value;
-					break;
-				case EGAAttributeMod::PercentageSubtract:
-					PercentageSubtractBonus += mod.Value;
-					break;
-				default:
-					break;
-				}
-			}
-	}
+	const FGAIndividualMods& Sums = GetBonusModsByTags(TagsIn);
+	float AdditiveBonus = Sums.Additive;
+	float SubtractBonus = Sums.Subtractive;
+	float MultiplyBonus = 1 + Sums.Multiplicative;
+	float DivideBonus = 1 + Sums.Divide;
 	float CurrentBonus;
 	//calculate final bonus from modifiers values.
 	//we don't handle stacking here. It's checked and handled before effect is added.
@@ -401,7 +416,7 @@ float FGAAttributeBase::GetBonusValueByTags(const FGameplayTagContainer & TagsIn
 	CurrentBonus = (CurrentBonus * MultiplyBonus);
 	CurrentBonus = (CurrentBonus / DivideBonus);
 	Bonuses = FGAIndividualMods(AdditiveBonus, SubtractBonus, MultiplyBonus,
-		DivideBonus, PercentageAddBonus, PercentageSubtractBonus);
+		DivideBonus, Sums.PercentageAdd, Sums.PercentageSubtract);
 	return CurrentBonus;
 }
 void FGAAttributeBase::UpdateAttribute()
@@ -411,24 +426,16 @@ void FGAAttributeBase::UpdateAttribute()
 void FGAAttributeBase::Add(float ValueIn)
 {
 	float OldCurrentValue = CurrentValue;
-	UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Add:: OldCurrentValue: %f"), OldCurrentValue);
-	UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Add:: AddValue: %f"), ValueIn);
 	float Val = CurrentValue - (OldCurrentValue + ValueIn);
-	UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Add:: ActuallAddVal: %f"), Val);
 	CurrentValue -= Val;
 	CurrentValue = FMath::Clamp<float>(CurrentValue, 0, GetFinalValue());
-	UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Add:: CurrentValue: %f"), CurrentValue);
 }
 void FGAAttributeBase::Subtract(float ValueIn)
 {
 	float OldCurrentValue = CurrentValue;
-	UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Subtract:: OldCurrentValue: %f"), OldCurrentValue);
-	UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Subtract:: SubtractValue: %f"), ValueIn);
 	float Val = CurrentValue - (OldCurrentValue - ValueIn);
-	UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Subtract:: ActuallSubtractVal: %f"), Val);
 	CurrentValue -= Val;
 	CurrentValue = FMath::Clamp<float>(CurrentValue, 0, GetFinalValue());
-	UE_LOG(GameAttributes, Log, TEXT("FGAAttributeBase::Subtract:: CurrentValue: %f"), CurrentValue);
 }
 
 void FGAAttributeBase::InitializeAttribute()
@@ -438,4 +445,203 @@ void FGAAttributeBase::InitializeAttribute()
 	CurrentValue = GetFinalValue();
 	//CurrentValue = BaseValue;
 	
-}
\ No newline at end of file
+}
+
+namespace GAAttributeNet
+{
+	enum EField
+	{
+		Field_Base,
+		Field_Clamp,
+		Field_Current,
+		Field_Bonus,
+		Field_Extension,
+		Field_Num
+	};
+	static const int32 NumValues = Field_Extension;
+
+	/* Largest float, which still fits into int32. */
+	static const float MaxQuantized = 2147483520.0f;
+	static inline int32 RoundClamped(float ValueIn)
+	{
+		return FMath::RoundToInt(FMath::Clamp(ValueIn, -MaxQuantized, MaxQuantized));
+	}
+	static int32 Quantize(float ValueIn, EGAAttributeQuantization QuantizationIn)
+	{
+		switch (QuantizationIn)
+		{
+		case EGAAttributeQuantization::Tenth:
+			return RoundClamped(ValueIn * 10.0f);
+		case EGAAttributeQuantization::Hundredth:
+			return RoundClamped(ValueIn * 100.0f);
+		case EGAAttributeQuantization::Integer:
+			return RoundClamped(ValueIn);
+		default:
+		{
+			//keep exact bits, so even tiny changes are detected.
+			int32 Bits = 0;
+			FMemory::Memcpy(&Bits, &ValueIn, sizeof(float));
+			return Bits;
+		}
+		}
+	}
+	static float Dequantize(int32 ValueIn, EGAAttributeQuantization QuantizationIn)
+	{
+		switch (QuantizationIn)
+		{
+		case EGAAttributeQuantization::Tenth:
+			return ValueIn / 10.0f;
+		case EGAAttributeQuantization::Hundredth:
+			return ValueIn / 100.0f;
+		case EGAAttributeQuantization::Integer:
+			return (float)ValueIn;
+		default:
+		{
+			float Value = 0;
+			FMemory::Memcpy(&Value, &ValueIn, sizeof(float));
+			return Value;
+		}
+		}
+	}
+	/* Small values, positive or negative, take one or two bytes. */
+	static void SerializeSigned(FArchive& Ar, int32& ValueInOut)
+	{
+		uint32 ZigZag = ((uint32)ValueInOut << 1) ^ (uint32)(ValueInOut >> 31);
+		Ar.SerializeIntPacked(ZigZag);
+		if (Ar.IsLoading())
+		{
+			ValueInOut = (int32)(ZigZag >> 1) ^ -(int32)(ZigZag & 1);
+		}
+	}
+	static void SerializeValue(FArchive& Ar, int32& ValueInOut, EGAAttributeQuantization QuantizationIn)
+	{
+		if (QuantizationIn == EGAAttributeQuantization::None)
+		{
+			//bit pattern of float doesn't pack well.
+			Ar << ValueInOut;
+		}
+		else
+		{
+			SerializeSigned(Ar, ValueInOut);
+		}
+	}
+
+	/* Quantized values last sent to connection. */
+	class FDeltaState : public INetDeltaBaseState
+	{
+	public:
+		int32 Values[NumValues];
+		UClass* ExtensionClass;
+
+		virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+		{
+			FDeltaState* Other = static_cast<FDeltaState*>(OtherState);
+			return FMemory::Memcmp(Values, Other->Values, sizeof(Values)) == 0
+				&& ExtensionClass == Other->ExtensionClass;
+		}
+	};
+}
+
+bool FGAAttributeBase::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	using namespace GAAttributeNet;
+	float* Fields[NumValues] = { &BaseValue, &ClampValue, &CurrentValue, &BonusValue };
+	if (DeltaParms.Writer)
+	{
+		FArchive& Writer = *DeltaParms.Writer;
+		FDeltaState* OldState = static_cast<FDeltaState*>(DeltaParms.OldState);
+		FDeltaState* NewState = new FDeltaState();
+		*DeltaParms.NewState = MakeShareable(NewState);
+		for (int32 Idx = 0; Idx < NumValues; Idx++)
+		{
+			NewState->Values[Idx] = Quantize(*Fields[Idx], Quantization);
+		}
+		//class can only be written with package map, otherwise keep what was sent before.
+		NewState->ExtensionClass = DeltaParms.Map ? ExtensionClass
+			: (OldState ? OldState->ExtensionClass : nullptr);
+
+		uint32 Mask = 0;
+		for (int32 Idx = 0; Idx < NumValues; Idx++)
+		{
+			if (!OldState || OldState->Values[Idx] != NewState->Values[Idx])
+			{
+				Mask |= 1 << Idx;
+			}
+		}
+		if (!OldState || OldState->ExtensionClass != NewState->ExtensionClass)
+		{
+			Mask |= 1 << Field_Extension;
+		}
+		if (Mask == 0)
+		{
+			return false;
+		}
+		Writer.SerializeBits(&Mask, Field_Num);
+		for (int32 Idx = 0; Idx < NumValues; Idx++)
+		{
+			if (Mask & (1 << Idx))
+			{
+				SerializeValue(Writer, NewState->Values[Idx], Quantization);
+			}
+		}
+		if (Mask & (1 << Field_Extension))
+		{
+			UObject* Class = NewState->ExtensionClass;
+			DeltaParms.Map->SerializeObject(Writer, UClass::StaticClass(), Class);
+		}
+		return true;
+	}
+	else if (DeltaParms.Reader)
+	{
+		FArchive& Reader = *DeltaParms.Reader;
+		uint32 Mask = 0;
+		Reader.SerializeBits(&Mask, Field_Num);
+		for (int32 Idx = 0; Idx < NumValues; Idx++)
+		{
+			if (Mask & (1 << Idx))
+			{
+				int32 Value = 0;
+				SerializeValue(Reader, Value, Quantization);
+				*Fields[Idx] = Dequantize(Value, Quantization);
+			}
+		}
+		if (Mask & (1 << Field_Extension))
+		{
+			if (!DeltaParms.Map)
+			{
+				Reader.SetError();
+				return false;
+			}
+			UObject* Class = nullptr;
+			DeltaParms.Map->SerializeObject(Reader, UClass::StaticClass(), Class);
+			ExtensionClass = Cast<UClass>(Class);
+		}
+		return !Reader.IsError();
+	}
+	return true;
+}
+
+bool FGAModifiedAttribute::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << ReplicationCounter;
+	Ar << Attribute.AttributeName;
+	int32 Value = FMath::RoundToInt(ModifiedByValue * 10.0f);
+	GAAttributeNet::SerializeSigned(Ar, Value);
+	Tags.NetSerialize(Ar, Map, bOutSuccess);
+	bOutSuccess &= SerializePackedVector<1, 20>(TargetLocation, Ar);
+	bOutSuccess &= SerializePackedVector<1, 20>(InstigatorLocation, Ar);
+	if (Map)
+	{
+		UObject* CauserObj = Causer.Get();
+		bOutSuccess &= Map->SerializeObject(Ar, UGAAbilitiesComponent::StaticClass(), CauserObj);
+		if (Ar.IsLoading())
+		{
+			Causer = Cast<UGAAbilitiesComponent>(CauserObj);
+		}
+	}
+	if (Ar.IsLoading())
+	{
+		ModifiedByValue = Value / 10.0f;
+	}
+	return true;
+}
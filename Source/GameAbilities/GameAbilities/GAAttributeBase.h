@@ -11,6 +11,20 @@ DECLARE_CYCLE_STAT_EXTERN(TEXT("CalculateBonus"), STAT_CalculateBonus, STATGROUP
 DECLARE_CYCLE_STAT_EXTERN(TEXT("CurrentBonusByTag"), STAT_CurrentBonusByTag, STATGROUP_Attribute, );
 DECLARE_CYCLE_STAT_EXTERN(TEXT("FinalBonusByTag"), STAT_FinalBonusByTag, STATGROUP_Attribute, );
 
+/*
+	Precision of attribute values sent to clients. Quantized values are clamped to int32 range,
+	ie. Hundredth can send values up to about 21 million. Use None for bigger values.
+*/
+UENUM()
+enum class EGAAttributeQuantization : uint8
+{
+	/* Full float. */
+	None,
+	Tenth,
+	Hundredth,
+	Integer
+};
+
 /*
 	I probabaly should chaange attribute to use int's instead of floats. Stable, accurate and
 	I can still have decimal values with them.
@@ -49,12 +63,32 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Value")
 		TSubclassOf<class UGAAttributeExtension> ExtensionClass;
+	/*
+		Precision of values sent to clients. It's not replicated, so it must be the same
+		on server and clients. Don't change it at runtime.
+	*/
+	UPROPERTY(EditAnywhere, Category = "Replication")
+		EGAAttributeQuantization Quantization;
 protected:
 	/*
 		Bonus value calculated from stack of affecting effects.
 	*/
 	UPROPERTY()
 		float BonusValue;
+	/*
+		Running sums of modifiers, per mod type. Updated on every add/remove,
+		so we don't need to iterate over all Modifiers to get new BonusValue.
+	*/
+	FGAIndividualMods BonusMods;
+	/*
+		Bumped every time Modifiers change. When it no longer match CachedBonusGeneration,
+		bonuses cached by tags are stale.
+		Assumes effect owned tags do not change after effect has been applied.
+	*/
+	uint32 ModifiersGeneration;
+	mutable uint32 CachedBonusGeneration;
+	/* Summed modifiers for query tags, so the same tag query don't need to scan all modifiers again. */
+	mutable TMap<FGAHashedGameplayTagContainer, FGAIndividualMods> CachedBonusByTags;
 public:
 	//map of modifiers.
 	//It could be TArray, but map seems easier to use in this case
@@ -105,9 +139,28 @@ public:
 	void RemoveBonusType(EGAAttributeMod ModType);
 
 	void InitializeAttribute();
-
+	/*
+		Rebuilds bonus sums from all Modifiers. Expensive, it's only needed
+		as consistency check, normal add/remove path keep sums updated incrementally.
+	*/
 	void CalculateBonus();
+	/* Returns true if incrementally updated sums match full recalculation. */
+	bool IsBonusConsistent() const;
+	/*
+		Sends only values, which changed since state last sent to connection, quantized
+		to Quantization. Nothing is sent if quantized values didn't change.
+	*/
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+protected:
+	/* Add (Sign = 1) or remove (Sign = -1) modifier from running sums. */
+	void AccumulateBonus(const FGAModifier& ModIn, float Sign);
+	/* Calculates BonusValue from running sums and applies difference to CurrentValue. */
+	void UpdateBonus();
+	static FGAIndividualMods SumModifiers(const TMap<FGAEffectHandle, FGAModifier>& ModifiersIn);
+public:
 
+	/* Raw sums of modifiers, which effects have all of TagsIn. Cached until Modifiers change. */
+	const FGAIndividualMods& GetBonusModsByTags(const FGameplayTagContainer& TagsIn) const;
 	float GetCurrentValueByTags(const FGameplayTagContainer& TagsIn, FGAIndividualMods& Bonuses) const;
 	float GetFinalValueByTags(const FGameplayTagContainer& TagsIn, FGAIndividualMods& Bonuses) const;
 	float GetBonusValueByTags(const FGameplayTagContainer& TagsIn, FGAIndividualMods& Bonuses) const;
@@ -123,16 +176,30 @@ public:
 
 	FGAAttributeBase()
 		: CurrentValue(0),
-		BonusValue(0)
+		Quantization(EGAAttributeQuantization::Hundredth),
+		BonusValue(0),
+		ModifiersGeneration(0),
+		CachedBonusGeneration(0)
 	{
 	};
 	FGAAttributeBase(float BaseValueIn)
 		: BaseValue(BaseValueIn),
 		CurrentValue(BaseValue),
-		BonusValue(0)
+		Quantization(EGAAttributeQuantization::Hundredth),
+		BonusValue(0),
+		ModifiersGeneration(0),
+		CachedBonusGeneration(0)
 	{
 	};
 };
+template<>
+struct TStructOpsTypeTraits< FGAAttributeBase > : public TStructOpsTypeTraitsBase
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
 
 USTRUCT(BlueprintType)
 struct GAMEABILITIES_API FGAModifiedAttribute
@@ -170,4 +237,15 @@ public:
 
 	UPROPERTY()
 		TWeakObjectPtr<class UGAAbilitiesComponent> Causer;
+
+	/* Packed form. Value is sent with 0.1 precision, locations are rounded to whole units. */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+template<>
+struct TStructOpsTypeTraits< FGAModifiedAttribute > : public TStructOpsTypeTraitsBase
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
 };
\ No newline at end of file
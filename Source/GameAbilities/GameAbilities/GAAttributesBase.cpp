@@ -4,26 +4,108 @@
 #include "GAGlobalTypes.h"
 #include "GAAttributesBase.h"
 
+void FGAAttributeTable::Build(UClass* ClassIn)
+{
+	Properties.Reset();
+	StructProperties.Reset();
+	NumericProperties.Reset();
+	AttributeOffsets.Reset();
+	for (TFieldIterator<UProperty> PropIt(ClassIn, EFieldIteratorFlags::IncludeSuper); PropIt; ++PropIt)
+	{
+		UProperty* Prop = *PropIt;
+		int32 Index = FGAAttribute::RegisterAttributeName(Prop->GetFName());
+		if (Index >= Properties.Num())
+		{
+			int32 Count = Index + 1;
+			Properties.SetNumZeroed(Count);
+			StructProperties.SetNumZeroed(Count);
+			NumericProperties.SetNumZeroed(Count);
+			int32 OldCount = AttributeOffsets.Num();
+			AttributeOffsets.SetNumUninitialized(Count);
+			for (int32 Idx = OldCount; Idx < Count; Idx++)
+			{
+				AttributeOffsets[Idx] = INDEX_NONE;
+			}
+		}
+		//most derived property wins, iterator visits super class after child.
+		if (Properties[Index])
+			continue;
+		Properties[Index] = Prop;
+		NumericProperties[Index] = Cast<UNumericProperty>(Prop);
+		UStructProperty* StructProp = Cast<UStructProperty>(Prop);
+		StructProperties[Index] = StructProp;
+		if (StructProp && StructProp->Struct->IsChildOf(FGAAttributeBase::StaticStruct()))
+		{
+			AttributeOffsets[Index] = StructProp->GetOffset_ForInternal();
+		}
+	}
+}
+namespace GAAttributeTable
+{
+	/* Weak key, so table of class which was collected, is never found for new class at the same address. */
+	static TMap<TWeakObjectPtr<UClass>, TSharedPtr<FGAAttributeTable>> Tables;
+	static FDelegateHandle PostGarbageCollectHandle;
+
+	static void OnPostGarbageCollect()
+	{
+		for (auto It = Tables.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+const FGAAttributeTable* FGAAttributeTable::Get(UClass* ClassIn, bool bForceRebuild)
+{
+	TSharedPtr<FGAAttributeTable>& Table = GAAttributeTable::Tables.FindOrAdd(ClassIn);
+	if (!Table.IsValid())
+	{
+		Table = MakeShareable(new FGAAttributeTable());
+		Table->Build(ClassIn);
+	}
+	else if (bForceRebuild)
+	{
+		Table->Build(ClassIn);
+	}
+	return Table.Get();
+}
+void FGAAttributeTable::Startup()
+{
+	GAAttributeTable::PostGarbageCollectHandle = FCoreUObjectDelegates::PostGarbageCollect.AddStatic(
+		&GAAttributeTable::OnPostGarbageCollect);
+}
+void FGAAttributeTable::Shutdown()
+{
+	FCoreUObjectDelegates::PostGarbageCollect.Remove(GAAttributeTable::PostGarbageCollectHandle);
+	GAAttributeTable::Tables.Empty();
+}
+
 UGAAttributesBase::UGAAttributesBase(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
 	bNetAddressable = false;
-	LastAttributeProp = nullptr;
-	CachedFloatPropety = nullptr;
+	AttributeTable = nullptr;
 }
 UGAAttributesBase::~UGAAttributesBase()
 {
-	LastAttributeProp = nullptr; //make sure we clear this pointer.
-	CachedFloatPropety = nullptr;
+	AttributeTable = nullptr;
 }
 
 void UGAAttributesBase::InitializeAttributes()
 {
-	for (TFieldIterator<UStructProperty> StrIt(GetClass(), EFieldIteratorFlags::IncludeSuper); StrIt; ++StrIt)
+#if WITH_EDITOR
+	//blueprint classes can be recompiled in place, so make sure offsets are not stale.
+	AttributeTable = FGAAttributeTable::Get(GetClass(), true);
+#else
+	AttributeTable = FGAAttributeTable::Get(GetClass());
+#endif
+	for (int32 Offset : AttributeTable->AttributeOffsets)
 	{
-		FGAAttributeBase* attr = StrIt->ContainerPtrToValuePtr<FGAAttributeBase>(this);
-		if (attr)
+		if (Offset != INDEX_NONE)
 		{
+			FGAAttributeBase* attr = reinterpret_cast<FGAAttributeBase*>(reinterpret_cast<uint8*>(this) + Offset);
 			attr->InitializeAttribute();
 		}
 	}
@@ -48,31 +130,40 @@ void UGAAttributesBase::InitializeAttributes()
 
 UProperty* UGAAttributesBase::FindProperty(const FGAAttribute& AttributeIn)
 {
-	//if new attribute name is the same as last attribute name and pointer to last property
-	//is not null, then we just return last pointer instead of performing new search.
-	if ((AttributeIn.AttributeName == LastAttributeName) && LastAttributeProp)
-		return LastAttributeProp;
-
-	LastAttributeName = AttributeIn.AttributeName;
-	LastAttributeProp = FindFieldChecked<UProperty>(this->GetClass(), LastAttributeName);
-	return LastAttributeProp;
+	const FGAAttributeTable& Table = GetAttributeTable();
+	int32 Index = AttributeIn.GetAttributeIndex();
+	if (Table.Properties.IsValidIndex(Index))
+	{
+		return Table.Properties[Index];
+	}
 	return nullptr;
 }
 UStructProperty* UGAAttributesBase::GetStructAttribute(const FGAAttribute& Name)
 {
-	return FindField<UStructProperty>(this->GetClass(), Name.AttributeName);
+	const FGAAttributeTable& Table = GetAttributeTable();
+	int32 Index = Name.GetAttributeIndex();
+	if (Table.StructProperties.IsValidIndex(Index))
+	{
+		return Table.StructProperties[Index];
+	}
+	return nullptr;
 }
 FGAAttributeBase* UGAAttributesBase::GetAttribute(const FGAAttribute& Name)
 {
-	UStructProperty* tempStruct = FindField<UStructProperty>(this->GetClass(), Name.AttributeName);
-
-	FGAAttributeBase* attr = nullptr;
-	if (tempStruct)
+	return GetAttributeByIndex(Name.GetAttributeIndex());
+}
+FGAAttributeBase* UGAAttributesBase::GetAttributeByIndex(int32 IndexIn)
+{
+	const FGAAttributeTable& Table = GetAttributeTable();
+	if (Table.AttributeOffsets.IsValidIndex(IndexIn))
 	{
-		attr = tempStruct->ContainerPtrToValuePtr<FGAAttributeBase>(this);
-		return attr;
-	} 
-	return attr;
+		int32 Offset = Table.AttributeOffsets[IndexIn];
+		if (Offset != INDEX_NONE)
+		{
+			return reinterpret_cast<FGAAttributeBase*>(reinterpret_cast<uint8*>(this) + Offset);
+		}
+	}
+	return nullptr;
 }
 void UGAAttributesBase::SetAttribute(const FGAAttribute& NameIn, UObject* NewVal)
 {
@@ -80,7 +171,9 @@ void UGAAttributesBase::SetAttribute(const FGAAttribute& NameIn, UObject* NewVal
 }
 void UGAAttributesBase::SetAttributeAdditiveBonus(const FGAAttribute& NameIn, float NewValue)
 {
-	UStructProperty* tempStruct = FindField<UStructProperty>(this->GetClass(), NameIn.AttributeName);
+	UStructProperty* tempStruct = GetStructAttribute(NameIn);
+	if (!tempStruct)
+		return;
 	UScriptStruct* scriptStruct = tempStruct->Struct;
 
 	uint8* StructData = tempStruct->ContainerPtrToValuePtr<uint8>(this);
@@ -123,41 +216,23 @@ float UGAAttributesBase::GetCurrentAttributeValue(const FGAAttribute& Name)
 }
 float UGAAttributesBase::GetFloatValue(const FGAAttribute& AttributeIn)
 {
-	if ((AttributeIn.AttributeName == LastAttributeName))
-	{
-		if (CachedFloatPropety)
-		{
-			const void* ValuePtr = CachedFloatPropety->ContainerPtrToValuePtr<void>(this);
-			return CachedFloatPropety->GetFloatingPointPropertyValue(ValuePtr);
-		}
-	}
-	//LastAttributeName = AttributeIn.AttributeName;
-	UNumericProperty* NumericProperty = CastChecked<UNumericProperty>(FindProperty(AttributeIn));
-	CachedFloatPropety = NumericProperty;
+	const FGAAttributeTable& Table = GetAttributeTable();
+	int32 Index = AttributeIn.GetAttributeIndex();
+	check(Table.NumericProperties.IsValidIndex(Index) && Table.NumericProperties[Index]);
+	UNumericProperty* NumericProperty = Table.NumericProperties[Index];
 	const void* ValuePtr = NumericProperty->ContainerPtrToValuePtr<void>(this);
 	return NumericProperty->GetFloatingPointPropertyValue(ValuePtr);
-
-	return 0;
 }
 
 float UGAAttributesBase::SetFloatValue(const FGAAttribute& AttributeIn, float ValueIn)
 {
-	if ((AttributeIn.AttributeName == LastAttributeName))
-	{
-		if (CachedFloatPropety)
-		{
-			void* ValuePtr = CachedFloatPropety->ContainerPtrToValuePtr<void>(this);
-			CachedFloatPropety->SetFloatingPointPropertyValue(ValuePtr, ValueIn);
-			return CachedFloatPropety->GetFloatingPointPropertyValue(ValuePtr);
-		}
-	}
-	//LastAttributeName = AttributeIn.AttributeName;
-	UNumericProperty* NumericProperty = CastChecked<UNumericProperty>(FindProperty(AttributeIn));
-	CachedFloatPropety = NumericProperty;
-	void* ValuePtr = CachedFloatPropety->ContainerPtrToValuePtr<void>(this);
+	const FGAAttributeTable& Table = GetAttributeTable();
+	int32 Index = AttributeIn.GetAttributeIndex();
+	check(Table.NumericProperties.IsValidIndex(Index) && Table.NumericProperties[Index]);
+	UNumericProperty* NumericProperty = Table.NumericProperties[Index];
+	void* ValuePtr = NumericProperty->ContainerPtrToValuePtr<void>(this);
 	NumericProperty->SetFloatingPointPropertyValue(ValuePtr, ValueIn);
-	return CachedFloatPropety->GetFloatingPointPropertyValue(ValuePtr);
-	return 0;
+	return NumericProperty->GetFloatingPointPropertyValue(ValuePtr);
 }
 
 float UGAAttributesBase::AttributeOperation(const FGAAttribute& AttributeIn, float ValueIn, EGAAttributeMod Operation)
@@ -36,6 +36,30 @@
 	myriads of possible combinations of those tree systems. We would need to mix some instanced/non-instanced UObjects
 	along with plain structs. Which is probabaly going to be total mess.
 */
+/*
+	Dense table of properties for single attribute set class, indexed by FGAAttribute::GetAttributeIndex().
+	Built once per class, so finding attribute is just pointer arithmetic instead of
+	FindField name search trough entire class.
+	Tables of classes, which were garbage collected, are removed after garbage collection.
+*/
+struct GAMEABILITIES_API FGAAttributeTable
+{
+	/* All properties of class, nullptr if class does not have property with this index. */
+	TArray<UProperty*> Properties;
+	TArray<UStructProperty*> StructProperties;
+	TArray<UNumericProperty*> NumericProperties;
+	/* Byte offset of FGAAttributeBase inside object, INDEX_NONE if property is not FGAAttributeBase. */
+	TArray<int32> AttributeOffsets;
+
+	void Build(UClass* ClassIn);
+
+	static const FGAAttributeTable* Get(UClass* ClassIn, bool bForceRebuild = false);
+
+	/* Called by module. */
+	static void Startup();
+	static void Shutdown();
+};
+
 UCLASS(BlueprintType, Blueprintable, DefaultToInstanced, EditInlineNew)
 class GAMEABILITIES_API UGAAttributesBase : public UObject
 {
@@ -62,6 +86,15 @@ public:
 	class UGAAbilitiesComponent* OwningAttributeComp;
 protected:
 	UProperty* FindProperty(const FGAAttribute& AttributeIn);
+	/* Gets table for this class. Lazily built, in case InitializeAttributes() haven't been called. */
+	inline const FGAAttributeTable& GetAttributeTable()
+	{
+		if (!AttributeTable)
+		{
+			AttributeTable = FGAAttributeTable::Get(GetClass());
+		}
+		return *AttributeTable;
+	}
 
 public:
 	/*
@@ -79,6 +112,8 @@ public:
 		Gets pointer to compelx attribute.
 	*/
 	FGAAttributeBase* GetAttribute(const FGAAttribute& Name);
+	/* Gets attribute by already resolved FGAAttribute::GetAttributeIndex(). */
+	FGAAttributeBase* GetAttributeByIndex(int32 IndexIn);
 	/*
 		Deprecated. I'm going to remove it, since it does not work as intended!
 	*/
@@ -110,10 +145,8 @@ protected:
 	bool bNetAddressable;
 
 private:
-	UProperty* LastAttributeProp;
-	FName LastAttributeName;
-	// cached numeric property. WEll we probabaly don't need UProperty cache then..
-	UNumericProperty* CachedFloatPropety;
+	/* Shared by all instances of the same class. */
+	const FGAAttributeTable* AttributeTable;
 	
 	float AddAttributeFloat(float ValueA, float ValueB);
 	float SubtractAttributeFloat(float ValueA, float ValueB);
@@ -0,0 +1,442 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "GameAbilities.h"
+#include "GAAbilitiesComponent.h"
+#include "GAGameEffect.h"
+#include "GACombatTrace.h"
+
+bool FGACombatTrace::bCaptureAll = false;
+//"GACT"
+const uint32 FGACombatTrace::FileMagic = 0x54434147;
+const uint32 FGACombatTrace::FileVersion = 1;
+
+namespace GACombatTrace
+{
+	enum
+	{
+		BufferSize = 4096,
+		BufferMask = BufferSize - 1
+	};
+	enum EChunk
+	{
+		Chunk_Names = 1,
+		Chunk_Records = 2
+	};
+	static const float FlushInterval = 1.0f;
+
+	/*
+		Single producer, single consumer ring. Only owning thread writes Head,
+		only flushing thread writes Tail.
+	*/
+	struct FThreadBuffer
+	{
+		FGACombatTraceRecord Records[BufferSize];
+		volatile uint32 Head;
+		volatile uint32 Tail;
+
+		FThreadBuffer()
+			: Head(0),
+			Tail(0)
+		{}
+	};
+
+	static uint32 TlsSlot = 0xFFFFFFFF;
+	/* Taken only when thread records first event, and when flushing. */
+	static FCriticalSection BuffersLock;
+	static TArray<FThreadBuffer*> Buffers;
+	static FThreadSafeCounter NumDropped;
+
+	/* State of file being written. Game thread only. */
+	static IFileHandle* File = nullptr;
+	static FString FilePath;
+	static TMap<FName, uint32> NameIds;
+	static TArray<FGACombatTraceRecord> PendingRecords;
+	static TArray<uint8> WriteBuffer;
+	static FDelegateHandle TickerHandle;
+
+	static bool OpenFile()
+	{
+		if (File)
+		{
+			return true;
+		}
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		const FString Dir = FPaths::GameSavedDir() / TEXT("CombatTrace");
+		PlatformFile.CreateDirectoryTree(*Dir);
+		const FString Path = Dir / FString::Printf(TEXT("CombatTrace-%s.gact"), *FDateTime::Now().ToString());
+		File = PlatformFile.OpenWrite(*Path);
+		if (!File)
+		{
+			UE_LOG(GameAbilities, Warning, TEXT("CombatTrace: Can't open %s"), *Path);
+			return false;
+		}
+		NameIds.Reset();
+		WriteBuffer.Reset();
+		FMemoryWriter Writer(WriteBuffer);
+		uint32 Magic = FGACombatTrace::FileMagic;
+		uint32 Version = FGACombatTrace::FileVersion;
+		Writer << Magic;
+		Writer << Version;
+		File->Write(WriteBuffer.GetData(), WriteBuffer.Num());
+		FilePath = Path;
+		UE_LOG(GameAbilities, Log, TEXT("CombatTrace: Writing to %s"), *Path);
+		return true;
+	}
+	/* Returns id of name, and adds it to NewNames if it has not been written to file yet. */
+	static uint32 GetNameId(const FName& NameIn, TArray<FName>& NewNames)
+	{
+		if (NameIn.IsNone())
+		{
+			return 0;
+		}
+		const uint32* Id = NameIds.Find(NameIn);
+		if (Id)
+		{
+			return *Id;
+		}
+		NewNames.Add(NameIn);
+		return NameIds.Add(NameIn, NameIds.Num() + 1);
+	}
+	static bool Tick(float DeltaTime)
+	{
+		FGACombatTrace::Flush();
+		return true;
+	}
+}
+
+void FGACombatTrace::Startup()
+{
+	//slot and buffers survive Shutdown, so threads which already recorded keep using them.
+	if (!FPlatformTLS::IsValidTlsSlot(GACombatTrace::TlsSlot))
+	{
+		GACombatTrace::TlsSlot = FPlatformTLS::AllocTlsSlot();
+	}
+	GACombatTrace::TickerHandle = FTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateStatic(&GACombatTrace::Tick), GACombatTrace::FlushInterval);
+}
+void FGACombatTrace::Shutdown()
+{
+	FTicker::GetCoreTicker().RemoveTicker(GACombatTrace::TickerHandle);
+	//buffers are not freed. Other threads still point to them trough TLS slot, and might be
+	//recording right now. They are few and fixed size, and are reused if module starts again.
+	Close();
+}
+
+bool FGACombatTrace::IsCapturing(const UGAAbilitiesComponent* ComponentIn)
+{
+	return bCaptureAll || (ComponentIn && ComponentIn->bCaptureCombatTrace);
+}
+
+void FGACombatTrace::RecordModify(const FGAEffectHandle& HandleIn, const FGAAttribute& AttributeIn,
+	float OldValueIn, float NewValueIn)
+{
+	//handle can already be stale, when modification outlived it's effect.
+	const FGAEffect* Effect = HandleIn.GetEffectPtr();
+	if (!Effect)
+	{
+		return;
+	}
+	UGAAbilitiesComponent* Target = Effect->Context.TargetComp.Get();
+	if (!IsCapturing(Target))
+	{
+		return;
+	}
+	UWorld* World = Target ? Target->GetWorld() : nullptr;
+	UGAGameEffectSpec* Spec = Effect->GameEffect;
+	FGACombatTraceRecord Record;
+	Record.Frame = GFrameCounter;
+	Record.WorldTime = World ? World->GetTimeSeconds() : 0;
+	Record.EffectIndex = HandleIn.GetIndex();
+	Record.EffectGeneration = HandleIn.GetGeneration();
+	Record.AttributeIndex = AttributeIn.GetAttributeIndex();
+	Record.OldValue = OldValueIn;
+	Record.NewValue = NewValueIn;
+	Record.SpecName = Spec ? Spec->GetFName() : NAME_None;
+	Record.TargetName = Target && Target->GetOwner() ? Target->GetOwner()->GetFName() : NAME_None;
+	Record.Event = EGACombatTraceEvent::Modify;
+	Push(Record);
+}
+void FGACombatTrace::RecordEffect(const FGAEffectHandle& HandleIn, EGACombatTraceEvent EventIn)
+{
+	//handle can already be stale, when modification outlived it's effect.
+	const FGAEffect* Effect = HandleIn.GetEffectPtr();
+	if (!Effect)
+	{
+		return;
+	}
+	UGAAbilitiesComponent* Target = Effect->Context.TargetComp.Get();
+	if (!IsCapturing(Target))
+	{
+		return;
+	}
+	UWorld* World = Target ? Target->GetWorld() : nullptr;
+	UGAGameEffectSpec* Spec = Effect->GameEffect;
+	FGACombatTraceRecord Record;
+	Record.Frame = GFrameCounter;
+	Record.WorldTime = World ? World->GetTimeSeconds() : 0;
+	Record.EffectIndex = HandleIn.GetIndex();
+	Record.EffectGeneration = HandleIn.GetGeneration();
+	Record.AttributeIndex = Spec ? Spec->AtributeModifier.Attribute.GetAttributeIndex() : INDEX_NONE;
+	Record.OldValue = 0;
+	Record.NewValue = 0;
+	Record.SpecName = Spec ? Spec->GetFName() : NAME_None;
+	Record.TargetName = Target && Target->GetOwner() ? Target->GetOwner()->GetFName() : NAME_None;
+	Record.Event = EventIn;
+	Push(Record);
+}
+void FGACombatTrace::Push(const FGACombatTraceRecord& RecordIn)
+{
+	if (!FPlatformTLS::IsValidTlsSlot(GACombatTrace::TlsSlot))
+	{
+		return;
+	}
+	GACombatTrace::FThreadBuffer* Buffer = (GACombatTrace::FThreadBuffer*)FPlatformTLS::GetTlsValue(GACombatTrace::TlsSlot);
+	if (!Buffer)
+	{
+		Buffer = new GACombatTrace::FThreadBuffer();
+		{
+			FScopeLock Lock(&GACombatTrace::BuffersLock);
+			GACombatTrace::Buffers.Add(Buffer);
+		}
+		FPlatformTLS::SetTlsValue(GACombatTrace::TlsSlot, Buffer);
+	}
+	const uint32 Head = Buffer->Head;
+	if (Head - Buffer->Tail >= GACombatTrace::BufferSize)
+	{
+		GACombatTrace::NumDropped.Increment();
+		return;
+	}
+	Buffer->Records[Head & GACombatTrace::BufferMask] = RecordIn;
+	//record must be visible before flushing thread sees new head.
+	FPlatformMisc::MemoryBarrier();
+	Buffer->Head = Head + 1;
+}
+
+void FGACombatTrace::Flush()
+{
+	check(IsInGameThread());
+	TArray<FGACombatTraceRecord>& Pending = GACombatTrace::PendingRecords;
+	Pending.Reset();
+	{
+		FScopeLock Lock(&GACombatTrace::BuffersLock);
+		for (GACombatTrace::FThreadBuffer* Buffer : GACombatTrace::Buffers)
+		{
+			const uint32 Head = Buffer->Head;
+			FPlatformMisc::MemoryBarrier();
+			for (uint32 Tail = Buffer->Tail; Tail != Head; Tail++)
+			{
+				Pending.Add(Buffer->Records[Tail & GACombatTrace::BufferMask]);
+			}
+			//slots can't be reused before they are copied out.
+			FPlatformMisc::MemoryBarrier();
+			Buffer->Tail = Head;
+		}
+	}
+	if (Pending.Num() == 0 || !GACombatTrace::OpenFile())
+	{
+		return;
+	}
+	//events from different threads, put them back in order.
+	Pending.StableSort([](const FGACombatTraceRecord& A, const FGACombatTraceRecord& B)
+	{
+		return A.Frame < B.Frame;
+	});
+
+	TArray<FName> NewNames;
+	TArray<uint8> Records;
+	FMemoryWriter RecordWriter(Records);
+	for (const FGACombatTraceRecord& Record : Pending)
+	{
+		uint64 Frame = Record.Frame;
+		float WorldTime = Record.WorldTime;
+		int32 EffectIndex = Record.EffectIndex;
+		uint32 EffectGeneration = Record.EffectGeneration;
+		uint32 AttributeId = GACombatTrace::GetNameId(FGAAttribute::GetAttributeNameByIndex(Record.AttributeIndex), NewNames);
+		uint32 SpecId = GACombatTrace::GetNameId(Record.SpecName, NewNames);
+		uint32 TargetId = GACombatTrace::GetNameId(Record.TargetName, NewNames);
+		float OldValue = Record.OldValue;
+		float NewValue = Record.NewValue;
+		uint8 Event = (uint8)Record.Event;
+		RecordWriter << Frame << WorldTime << EffectIndex << EffectGeneration << AttributeId << SpecId << TargetId
+			<< OldValue << NewValue << Event;
+	}
+
+	TArray<uint8>& WriteBuffer = GACombatTrace::WriteBuffer;
+	WriteBuffer.Reset();
+	FMemoryWriter Writer(WriteBuffer);
+	//names go first, so decoder always knows them before they are referenced.
+	if (NewNames.Num() > 0)
+	{
+		uint32 Chunk = GACombatTrace::Chunk_Names;
+		uint32 Count = NewNames.Num();
+		Writer << Chunk << Count;
+		for (const FName& Name : NewNames)
+		{
+			uint32 Id = GACombatTrace::NameIds.FindChecked(Name);
+			FString NameString = Name.ToString();
+			Writer << Id << NameString;
+		}
+	}
+	uint32 Chunk = GACombatTrace::Chunk_Records;
+	uint32 Count = Pending.Num();
+	Writer << Chunk << Count;
+	Writer.Serialize(Records.GetData(), Records.Num());
+	GACombatTrace::File->Write(WriteBuffer.GetData(), WriteBuffer.Num());
+	GACombatTrace::File->Flush();
+}
+void FGACombatTrace::Close()
+{
+	Flush();
+	if (GACombatTrace::File)
+	{
+		delete GACombatTrace::File;
+		GACombatTrace::File = nullptr;
+	}
+	GACombatTrace::NameIds.Reset();
+	GACombatTrace::FilePath.Empty();
+}
+FString FGACombatTrace::GetCurrentFile()
+{
+	return GACombatTrace::FilePath;
+}
+int32 FGACombatTrace::GetNumDropped()
+{
+	return GACombatTrace::NumDropped.GetValue();
+}
+
+int32 FGACombatTrace::DecodeToCSV(const FString& TraceFileIn, const FString& CSVFileOut)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *TraceFileIn))
+	{
+		return -1;
+	}
+	FMemoryReader Reader(Data);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Reader << Magic << Version;
+	if (Magic != FileMagic || Version != FileVersion)
+	{
+		UE_LOG(GameAbilities, Warning, TEXT("CombatTrace: %s is not combat trace file, or has unsupported version"), *TraceFileIn);
+		return -1;
+	}
+	TMap<uint32, FString> Names;
+	Names.Add(0, FString());
+	FString CSV = TEXT("Frame,WorldTime,Event,Target,Spec,EffectIndex,EffectGeneration,Attribute,OldValue,NewValue\n");
+	int32 NumRecords = 0;
+	while (!Reader.AtEnd() && !Reader.IsError())
+	{
+		uint32 Chunk = 0;
+		uint32 Count = 0;
+		Reader << Chunk << Count;
+		if (Chunk == GACombatTrace::Chunk_Names)
+		{
+			for (uint32 Idx = 0; Idx < Count && !Reader.IsError(); Idx++)
+			{
+				uint32 Id = 0;
+				FString Name;
+				Reader << Id << Name;
+				Names.Add(Id, Name);
+			}
+		}
+		else if (Chunk == GACombatTrace::Chunk_Records)
+		{
+			for (uint32 Idx = 0; Idx < Count && !Reader.IsError(); Idx++)
+			{
+				uint64 Frame;
+				float WorldTime;
+				int32 EffectIndex;
+				uint32 EffectGeneration;
+				uint32 AttributeId;
+				uint32 SpecId;
+				uint32 TargetId;
+				float OldValue;
+				float NewValue;
+				uint8 Event;
+				Reader << Frame << WorldTime << EffectIndex << EffectGeneration << AttributeId << SpecId << TargetId
+					<< OldValue << NewValue << Event;
+
+				const TCHAR* EventName = TEXT("Unknown");
+				switch ((EGACombatTraceEvent)Event)
+				{
+				case EGACombatTraceEvent::Modify:
+					EventName = TEXT("Modify");
+					break;
+				case EGACombatTraceEvent::Apply:
+					EventName = TEXT("Apply");
+					break;
+				case EGACombatTraceEvent::Remove:
+					EventName = TEXT("Remove");
+					break;
+				}
+				CSV += FString::Printf(TEXT("%llu,%f,%s,%s,%s,%d,%u,%s,%f,%f\n"), Frame, WorldTime, EventName,
+					*Names.FindRef(TargetId), *Names.FindRef(SpecId), EffectIndex, EffectGeneration,
+					*Names.FindRef(AttributeId), OldValue, NewValue);
+				NumRecords++;
+			}
+		}
+		else
+		{
+			UE_LOG(GameAbilities, Warning, TEXT("CombatTrace: Unknown chunk %u in %s"), Chunk, *TraceFileIn);
+			break;
+		}
+	}
+	if (!FFileHelper::SaveStringToFile(CSV, *CSVFileOut))
+	{
+		return -1;
+	}
+	return NumRecords;
+}
+
+static void GACombatTraceCapture(const TArray<FString>& Args, UWorld* World)
+{
+	if (Args.Num() < 1)
+	{
+		UE_LOG(GameAbilities, Log, TEXT("Usage: GA.CombatTrace.Capture <ActorName|All> <0|1>"));
+		return;
+	}
+	const bool bEnable = Args.Num() < 2 || FCString::Atoi(*Args[1]) != 0;
+	if (Args[0] == TEXT("All"))
+	{
+		FGACombatTrace::bCaptureAll = bEnable;
+		UE_LOG(GameAbilities, Log, TEXT("CombatTrace: Capture all %s"), bEnable ? TEXT("enabled") : TEXT("disabled"));
+		return;
+	}
+	int32 NumChanged = 0;
+	for (TObjectIterator<UGAAbilitiesComponent> It; It; ++It)
+	{
+		AActor* Owner = It->GetOwner();
+		if (It->GetWorld() == World && Owner && Owner->GetName() == Args[0])
+		{
+			It->bCaptureCombatTrace = bEnable;
+			NumChanged++;
+		}
+	}
+	UE_LOG(GameAbilities, Log, TEXT("CombatTrace: Capture %s on %d components"), bEnable ? TEXT("enabled") : TEXT("disabled"), NumChanged);
+}
+static void GACombatTraceDecode(const TArray<FString>& Args)
+{
+	if (Args.Num() < 1)
+	{
+		UE_LOG(GameAbilities, Log, TEXT("Usage: GA.CombatTrace.Decode <File> [OutFile]"));
+		return;
+	}
+	const FString OutFile = Args.Num() > 1 ? Args[1] : FPaths::ChangeExtension(Args[0], TEXT("csv"));
+	const int32 NumRecords = FGACombatTrace::DecodeToCSV(Args[0], OutFile);
+	UE_LOG(GameAbilities, Log, TEXT("CombatTrace: Decoded %d records to %s"), NumRecords, *OutFile);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GACombatTraceCaptureCmd(
+	TEXT("GA.CombatTrace.Capture"),
+	TEXT("Records attribute changes and effects of actor to combat trace. GA.CombatTrace.Capture <ActorName|All> <0|1>"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&GACombatTraceCapture));
+
+static FAutoConsoleCommand GACombatTraceFlushCmd(
+	TEXT("GA.CombatTrace.Flush"),
+	TEXT("Writes captured combat events to file, and starts new file."),
+	FConsoleCommandDelegate::CreateStatic(&FGACombatTrace::Close));
+
+static FAutoConsoleCommandWithArgs GACombatTraceDecodeCmd(
+	TEXT("GA.CombatTrace.Decode"),
+	TEXT("Decodes combat trace file to CSV. GA.CombatTrace.Decode <File> [OutFile]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&GACombatTraceDecode));
@@ -0,0 +1,78 @@
+#pragma once
+#include "GAGlobalTypes.h"
+
+enum class EGACombatTraceEvent : uint8
+{
+	/* Instant modification of attribute current value. */
+	Modify,
+	/* Effect has been applied to target. */
+	Apply,
+	/* Effect has been removed from target (expired or removed manually). */
+	Remove
+};
+
+/*
+	Single event captured by FGACombatTrace. Plain data, names are resolved only when records
+	are flushed to file.
+*/
+struct GAMEABILITIES_API FGACombatTraceRecord
+{
+	uint64 Frame;
+	float WorldTime;
+	int32 EffectIndex;
+	uint32 EffectGeneration;
+	int32 AttributeIndex;
+	float OldValue;
+	float NewValue;
+	FName SpecName;
+	FName TargetName;
+	EGACombatTraceEvent Event;
+};
+
+/*
+	Binary trace of combat events (attribute modifications, applied and removed effects),
+	meant for post-mortem of damage and effect issues, without formatting strings on hot path.
+
+	Every thread which records events gets it's own single producer ring buffer, so recording
+	does not take any lock. When buffer is full, events are dropped and counted.
+	Buffers are drained on game thread, periodically or trough GA.CombatTrace.Flush, and appended
+	to file in Saved/CombatTrace. Names of specs, targets and attributes are written once per file,
+	records only refer to them by id.
+
+	File can be decoded to CSV, with GA.CombatTrace.Decode <File> [OutFile].
+	Capture is enabled per actor, with GA.CombatTrace.Capture <ActorName|All> <0|1>.
+*/
+class GAMEABILITIES_API FGACombatTrace
+{
+public:
+	/* Called by module. */
+	static void Startup();
+	static void Shutdown();
+
+	/* Returns true if events on this component should be recorded. */
+	static bool IsCapturing(const class UGAAbilitiesComponent* ComponentIn);
+
+	static void RecordModify(const FGAEffectHandle& HandleIn, const FGAAttribute& AttributeIn,
+		float OldValueIn, float NewValueIn);
+	static void RecordEffect(const FGAEffectHandle& HandleIn, EGACombatTraceEvent EventIn);
+
+	/* Drains all thread buffers into trace file. Game thread only. */
+	static void Flush();
+	/* Flushes pending events and closes current file. Next flush will start new file. */
+	static void Close();
+	/* Path of file, to which events are currently written. Empty if there is none. */
+	static FString GetCurrentFile();
+	/* Decodes trace file into CSV. Returns number of decoded records, or -1 if file couldn't be read. */
+	static int32 DecodeToCSV(const FString& TraceFileIn, const FString& CSVFileOut);
+
+	/* Captures events on every component, regardless of it's own setting. */
+	static bool bCaptureAll;
+	/* Number of events dropped, because buffer of recording thread was full. */
+	static int32 GetNumDropped();
+
+	static const uint32 FileMagic;
+	static const uint32 FileVersion;
+private:
+	/* Copies record to ring buffer of calling thread. */
+	static void Push(const FGACombatTraceRecord& RecordIn);
+};
@@ -1,15 +1,15 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "GameAbilities.h"
+#include "AbilityCues/GACueActorPool.h"
 #include "GAEffectCue.h"
 
 
 // Sets default values
-AGAEffectCue::AGAEffectCue()
+AGAEffectCue::AGAEffectCue(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
-
+	Lifetime = 2;
 }
 
 // Called when the game starts or when spawned
@@ -19,10 +19,22 @@ void AGAEffectCue::BeginPlay()
 	
 }
 
-// Called every frame
-void AGAEffectCue::Tick( float DeltaTime )
+void AGAEffectCue::PlayCue(const FGAEffectCueParams& CueParamsIn)
 {
-	Super::Tick( DeltaTime );
-
+	const FHitResult& Hit = CueParamsIn.HitResult;
+	if (!Hit.ImpactNormal.IsNearlyZero())
+	{
+		SetActorRotation(Hit.ImpactNormal.Rotation());
+	}
+	OnCuePlayed(CueParamsIn);
+	if (Lifetime > 0)
+	{
+		FTimerHandle ReleaseHandle;
+		GetWorldTimerManager().SetTimer(ReleaseHandle, this, &AGAEffectCue::ReturnToPool, Lifetime, false);
+	}
 }
 
+void AGAEffectCue::ReturnToPool()
+{
+	FGACueActorPool::Release(this);
+}
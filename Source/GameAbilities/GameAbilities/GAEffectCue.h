@@ -2,24 +2,36 @@
 
 #pragma once
 
-#include "GameFramework/Actor.h"
+#include "AbilityCues/GACueActor.h"
+#include "GAGlobalTypes.h"
 #include "GAEffectCue.generated.h"
 
+/*
+	Actor played where effect hit (UGAGameEffectSpec::EffectCue).
+	Effect cues are taken from FGACueActorPool, so make sure to stop everything
+	in OnReturnedToPool, actor will be reused.
+*/
 UCLASS()
-class GAMEABILITIES_API AGAEffectCue : public AActor
+class GAMEABILITIES_API AGAEffectCue : public AGACueActor
 {
 	GENERATED_BODY()
-	
+public:
+	/* Cue goes back to pool after this time. If 0, it stays until target is gone. */
+	UPROPERTY(EditDefaultsOnly, Category = "Pool")
+		float Lifetime;
+
 public:	
 	// Sets default values for this actor's properties
-	AGAEffectCue();
+	AGAEffectCue(const FObjectInitializer& ObjectInitializer);
 
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
-	
-	// Called every frame
-	virtual void Tick( float DeltaSeconds ) override;
 
-	
-	
+	/* Called by FGameCueContainer, after actor is taken from pool. */
+	void PlayCue(const FGAEffectCueParams& CueParamsIn);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Game Abilities")
+		void OnCuePlayed(const FGAEffectCueParams& CueParams);
+protected:
+	void ReturnToPool();
 };
@@ -0,0 +1,256 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "GameAbilities.h"
+#include "GAAbilitiesComponent.h"
+#include "GAGameEffect.h"
+#include "IGAAbilities.h"
+#include "GAEffectCueBatcher.h"
+
+static TAutoConsoleVariable<float> CVarCueCullDistance(
+	TEXT("GA.CueBatch.CullDistance"),
+	10000.0f,
+	TEXT("Effect cues further than this from connection view point are not sent to it."));
+
+static TAutoConsoleVariable<int32> CVarCueMaxPerTag(
+	TEXT("GA.CueBatch.MaxPerTag"),
+	10,
+	TEXT("Max number of cues with the same tag sent to single connection per second. 0 is unlimited."));
+
+namespace GAEffectCueBatcher
+{
+	static TMap<UWorld*, TArray<FGAEffectCueEvent>> PendingCues;
+	static TMap<TWeakObjectPtr<APlayerController>, FGACueViewer> Viewers;
+	static FDelegateHandle PostActorTickHandle;
+	static FDelegateHandle WorldCleanupHandle;
+
+	static void OnPostActorTick(UWorld* WorldIn, ELevelTick TickTypeIn, float DeltaTimeIn)
+	{
+		FGAEffectCueBatcher::Flush(WorldIn);
+	}
+	static void OnWorldCleanup(UWorld* WorldIn, bool bSessionEnded, bool bCleanupResources)
+	{
+		PendingCues.Remove(WorldIn);
+	}
+	/* Cues are batched only, when there is someone to send them to. */
+	static bool ShouldBatch(UWorld* WorldIn)
+	{
+		const ENetMode NetMode = WorldIn->GetNetMode();
+		return NetMode == NM_DedicatedServer || NetMode == NM_ListenServer;
+	}
+}
+
+void FGAEffectCueBatcher::Startup()
+{
+	GAEffectCueBatcher::PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(
+		&GAEffectCueBatcher::OnPostActorTick);
+	GAEffectCueBatcher::WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(
+		&GAEffectCueBatcher::OnWorldCleanup);
+}
+void FGAEffectCueBatcher::Shutdown()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(GAEffectCueBatcher::PostActorTickHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(GAEffectCueBatcher::WorldCleanupHandle);
+	GAEffectCueBatcher::PendingCues.Empty();
+	GAEffectCueBatcher::Viewers.Empty();
+}
+
+void FGAEffectCueBatcher::QueueCue(class UGAAbilitiesComponent* SourceCompIn, const FGAEffectHandle& HandleIn,
+	const FGAEffectCueParams& CueParamsIn)
+{
+	UWorld* World = SourceCompIn ? SourceCompIn->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+	FGAEffectCueEvent Cue;
+	Cue.SourceComp = SourceCompIn;
+	Cue.Instigator = CueParamsIn.Instigator;
+	Cue.EffectCauser = CueParamsIn.EffectCauser;
+	const FHitResult& Hit = CueParamsIn.HitResult;
+	Cue.Target = Hit.GetActor();
+	Cue.Location = Hit.bBlockingHit ? Hit.ImpactPoint : Hit.Location;
+	Cue.Normal = Hit.ImpactNormal;
+	if (HandleIn.IsValid())
+	{
+		UGAGameEffectSpec* Spec = HandleIn.GetEffectSpec();
+		const FGAEffectContext& Context = HandleIn.GetContextRef();
+		Cue.SpecClass = Spec->GetClass();
+		Cue.CueTag = Spec->EffectTag;
+		if (!Cue.Target.IsValid())
+		{
+			Cue.Target = Cast<AActor>(Context.Target.Get());
+		}
+		if (!Hit.bBlockingHit)
+		{
+			Cue.Location = Context.TargetHitLocation;
+		}
+		if (!Cue.Instigator.IsValid())
+		{
+			Cue.Instigator = Context.Instigator.Get();
+		}
+		if (!Cue.EffectCauser.IsValid())
+		{
+			Cue.EffectCauser = Cast<AActor>(Context.Causer.Get());
+		}
+	}
+
+	if (GAEffectCueBatcher::ShouldBatch(World))
+	{
+		GAEffectCueBatcher::PendingCues.FindOrAdd(World).Add(Cue);
+	}
+	else
+	{
+		PlayCue(Cue);
+	}
+}
+
+void FGAEffectCueBatcher::Flush(UWorld* WorldIn)
+{
+	TArray<FGAEffectCueEvent>* Cues = GAEffectCueBatcher::PendingCues.Find(WorldIn);
+	if (!Cues || Cues->Num() == 0)
+	{
+		return;
+	}
+	const float Time = WorldIn->GetTimeSeconds();
+	bool bPlayedLocally = false;
+	TArray<FGAEffectCueEvent> ViewerCues;
+	for (FConstPlayerControllerIterator It = WorldIn->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PC = It->Get();
+		if (!PC)
+		{
+			continue;
+		}
+		if (PC->IsLocalController())
+		{
+			//host sees everything, same as with multicast.
+			if (!bPlayedLocally)
+			{
+				for (const FGAEffectCueEvent& Cue : *Cues)
+				{
+					PlayCue(Cue);
+				}
+				bPlayedLocally = true;
+			}
+			continue;
+		}
+		IIGAAbilities* PawnInt = Cast<IIGAAbilities>(PC->GetPawn());
+		UGAAbilitiesComponent* ReceiverComp = PawnInt ? PawnInt->GetAbilityComp() : nullptr;
+		if (!ReceiverComp)
+		{
+			continue;
+		}
+		FGACueViewer& Viewer = GAEffectCueBatcher::Viewers.FindOrAdd(PC);
+		Viewer.Controller = PC;
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(Viewer.ViewLocation, ViewRotation);
+
+		ViewerCues.Reset();
+		FilterForViewer(*Cues, Viewer, Time, ViewerCues);
+		if (ViewerCues.Num() > 0)
+		{
+			ReceiverComp->ClientPlayEffectCues(ViewerCues);
+		}
+	}
+	Cues->Reset();
+
+	for (auto It = GAEffectCueBatcher::Viewers.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+int32 FGAEffectCueBatcher::FilterForViewer(const TArray<FGAEffectCueEvent>& CuesIn, FGACueViewer& ViewerIn,
+	float TimeIn, TArray<FGAEffectCueEvent>& CuesOut)
+{
+	const float CullDistance = CVarCueCullDistance.GetValueOnGameThread();
+	const float CullDistanceSq = CullDistance * CullDistance;
+	const int32 MaxPerTag = CVarCueMaxPerTag.GetValueOnGameThread();
+	AActor* ViewTarget = ViewerIn.Controller ? ViewerIn.Controller->GetViewTarget() : nullptr;
+
+	struct FCandidate
+	{
+		int32 Index;
+		float DistanceSq;
+	};
+	TArray<FCandidate, TInlineAllocator<32>> Candidates;
+	for (int32 Idx = 0; Idx < CuesIn.Num(); Idx++)
+	{
+		const FGAEffectCueEvent& Cue = CuesIn[Idx];
+		const float DistanceSq = FVector::DistSquared(Cue.Location, ViewerIn.ViewLocation);
+		if (DistanceSq > CullDistanceSq)
+		{
+			continue;
+		}
+		AActor* Target = Cue.Target.Get();
+		if (ViewerIn.Controller && Target
+			&& !Target->IsNetRelevantFor(ViewerIn.Controller, ViewTarget, ViewerIn.ViewLocation))
+		{
+			continue;
+		}
+		FCandidate& Candidate = Candidates[Candidates.AddUninitialized()];
+		Candidate.Index = Idx;
+		Candidate.DistanceSq = DistanceSq;
+	}
+	//when rate limit is hit, closest cues are the ones worth keeping.
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B)
+	{
+		return A.DistanceSq < B.DistanceSq;
+	});
+
+	const int32 NumBefore = CuesOut.Num();
+	for (const FCandidate& Candidate : Candidates)
+	{
+		const FGAEffectCueEvent& Cue = CuesIn[Candidate.Index];
+		if (MaxPerTag > 0 && Cue.CueTag.IsValid())
+		{
+			FGACueViewer::FRateWindow& Rate = ViewerIn.Rates.FindOrAdd(Cue.CueTag);
+			if (Rate.Count == 0 || TimeIn - Rate.WindowStart >= 1.0f)
+			{
+				Rate.WindowStart = TimeIn;
+				Rate.Count = 0;
+			}
+			if (Rate.Count >= MaxPerTag)
+			{
+				continue;
+			}
+			Rate.Count++;
+		}
+		CuesOut.Add(Cue);
+	}
+	return CuesIn.Num() - (CuesOut.Num() - NumBefore);
+}
+
+void FGAEffectCueBatcher::PlayCue(const FGAEffectCueEvent& CueIn)
+{
+	UGAAbilitiesComponent* SourceComp = CueIn.SourceComp.Get();
+	AActor* Instigator = CueIn.Instigator.Get();
+	if (!SourceComp)
+	{
+		//source is often not relevant for client (out of range, or already gone), but hit still
+		//should be seen. Play it trough target, without instigator.
+		IIGAAbilities* TargetInt = Cast<IIGAAbilities>(CueIn.Target.Get());
+		SourceComp = TargetInt ? TargetInt->GetAbilityComp() : nullptr;
+		Instigator = nullptr;
+	}
+	if (!SourceComp)
+	{
+		return;
+	}
+	FGAEffectCueParams CueParams(FHitResult(), Instigator, CueIn.EffectCauser.Get());
+	CueParams.HitResult.Actor = CueIn.Target;
+	CueParams.HitResult.Location = CueIn.Location;
+	CueParams.HitResult.ImpactPoint = CueIn.Location;
+	CueParams.HitResult.ImpactNormal = CueIn.Normal;
+	//handles can't be resolved on clients, cue is found trough spec class.
+	SourceComp->ActiveCues.PlayCue(CueIn.SpecClass, CueParams);
+}
+
+int32 FGAEffectCueBatcher::GetNumPending(UWorld* WorldIn)
+{
+	const TArray<FGAEffectCueEvent>* Cues = GAEffectCueBatcher::PendingCues.Find(WorldIn);
+	return Cues ? Cues->Num() : 0;
+}
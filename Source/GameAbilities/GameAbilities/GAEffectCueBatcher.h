@@ -0,0 +1,64 @@
+#pragma once
+#include "GAGlobalTypes.h"
+
+/* Point of view of single connection, and it's cue rate limits. */
+struct GAMEABILITIES_API FGACueViewer
+{
+	/* Used for relevancy of cue targets. Cues are only distance culled without it. */
+	class APlayerController* Controller;
+	FVector ViewLocation;
+
+	struct FRateWindow
+	{
+		float WindowStart;
+		int32 Count;
+
+		FRateWindow()
+			: WindowStart(0),
+			Count(0)
+		{}
+	};
+	/* Cues sent to this viewer in current second, by cue tag. */
+	TMap<FGameplayTag, FRateWindow> Rates;
+
+	FGACueViewer()
+		: Controller(nullptr),
+		ViewLocation(ForceInitToZero)
+	{}
+};
+
+/*
+	Gathers effect cues produced during server frame, and sends them after actors ticked,
+	as single unreliable RPC per connection.
+	Every connection gets only cues, which target actors relevant to it, and which are within
+	GA.CueBatch.CullDistance from it's view point. Cues with the same tag are limited to
+	GA.CueBatch.MaxPerTag per second per connection, closest ones are kept.
+
+	Connection receives batch trough abilities component of it's pawn, so connections
+	without pawn don't get cues.
+	Standalone games and clients play cues immediately, listen server plays all cues locally.
+*/
+class GAMEABILITIES_API FGAEffectCueBatcher
+{
+public:
+	/* Called by module. */
+	static void Startup();
+	static void Shutdown();
+
+	static void QueueCue(class UGAAbilitiesComponent* SourceCompIn, const FGAEffectHandle& HandleIn,
+		const FGAEffectCueParams& CueParamsIn);
+	/* Sends all cues queued in world. Called automatically after actors ticked. */
+	static void Flush(UWorld* WorldIn);
+	/* Plays received cue on client. If source is not known to client, cue plays on target. */
+	static void PlayCue(const FGAEffectCueEvent& CueIn);
+
+	/*
+		Picks cues which should be sent to viewer, closest first. Updates rate limits of viewer.
+		Returns number of culled cues.
+	*/
+	static int32 FilterForViewer(const TArray<FGAEffectCueEvent>& CuesIn, FGACueViewer& ViewerIn,
+		float TimeIn, TArray<FGAEffectCueEvent>& CuesOut);
+
+	/* Number of cues waiting for flush in world. */
+	static int32 GetNumPending(UWorld* WorldIn);
+};
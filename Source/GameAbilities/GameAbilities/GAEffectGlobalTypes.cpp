@@ -158,7 +158,7 @@ float FGACurveBasedModifier::GetValue(const FGAEffectContext& ContextIn)
 	default:
 		return 0;
 	}
-	FString ContextString(TEXT("Evaluating modifier value."));
+	static const FString ContextString(TEXT("Evaluating modifier value."));
 	Result = CurveTable.Eval(attr->GetFinalValue(), ContextString);
 	return Result;
 }
@@ -177,7 +177,7 @@ float FGACurveBasedModifier::GetValue(const FGAEffectContext& ContextIn) const
 	default:
 		return 0;
 	}
-	FString ContextString(TEXT("Evaluating modifier value."));
+	static const FString ContextString(TEXT("Evaluating modifier value."));
 	Result = CurveTable.Eval(attr->GetFinalValue(), ContextString);
 	return Result;
 }
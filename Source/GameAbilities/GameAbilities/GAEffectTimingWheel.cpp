@@ -0,0 +1,334 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "GameAbilities.h"
+#include "GAEffectTimingWheel.h"
+
+const double FGAEffectTimingWheel::Resolution = 1.0 / 64.0;
+
+FGAEffectTimingWheel::FGAEffectTimingWheel()
+	: DueCursor(0),
+	CurrentTime(0),
+	CurrentTick(0),
+	NumActive(0),
+	NumInBuckets(0),
+	SerialCounter(0),
+	DueStampCounter(0)
+{
+	for (int32 Idx = 0; Idx < NumLevels * NumSlots; Idx++)
+	{
+		Buckets[Idx] = INDEX_NONE;
+	}
+}
+
+int64 FGAEffectTimingWheel::TimeToTick(double TimeIn)
+{
+	//round up, so timer is never collected before it's due time.
+	int64 Tick = (int64)(TimeIn / Resolution);
+	if ((double)Tick * Resolution < TimeIn)
+	{
+		Tick++;
+	}
+	return Tick;
+}
+
+FGAEffectTimerHandle FGAEffectTimingWheel::Schedule(const FGAEffectHandle& HandleIn, EGAEffectTimerType TypeIn,
+	float DelayIn, float IntervalIn)
+{
+	int32 Index = INDEX_NONE;
+	if (FreeTimers.Num() > 0)
+	{
+		Index = FreeTimers.Pop(false);
+	}
+	else
+	{
+		Index = Timers.AddUninitialized(1);
+	}
+	SerialCounter++;
+	//0 is reserved for unset handles.
+	if (SerialCounter == 0)
+	{
+		SerialCounter++;
+	}
+	FTimer& Timer = Timers[Index];
+	Timer.Handle = HandleIn;
+	Timer.Type = TypeIn;
+	Timer.Interval = FMath::Max(IntervalIn, 0.f);
+	Timer.DueTime = CurrentTime + FMath::Max(DelayIn, 0.f);
+	Timer.DueTick = 0;
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = INDEX_NONE;
+	Timer.Bucket = INDEX_NONE;
+	Timer.Serial = SerialCounter;
+	Timer.DueStamp = 0;
+	NumActive++;
+
+	if (Timer.DueTime <= CurrentTime)
+	{
+		MakeDue(Index);
+	}
+	else
+	{
+		Insert(Index);
+	}
+	return FGAEffectTimerHandle(Index, Timer.Serial);
+}
+
+bool FGAEffectTimingWheel::Cancel(FGAEffectTimerHandle& TimerIn)
+{
+	if (!IsValidTimer(TimerIn))
+	{
+		TimerIn.Invalidate();
+		return false;
+	}
+	Unlink(TimerIn.Index);
+	Free(TimerIn.Index);
+	TimerIn.Invalidate();
+	return true;
+}
+
+bool FGAEffectTimingWheel::Reschedule(const FGAEffectTimerHandle& TimerIn, float DelayIn)
+{
+	if (!IsValidTimer(TimerIn))
+	{
+		return false;
+	}
+	FTimer& Timer = Timers[TimerIn.Index];
+	Timer.DueTime = CurrentTime + FMath::Max(DelayIn, 0.f);
+	if (Timer.DueTime <= CurrentTime)
+	{
+		//if it's already waiting to be popped, don't add it twice.
+		if (Timer.Bucket != DueBucket)
+		{
+			Unlink(TimerIn.Index);
+			MakeDue(TimerIn.Index);
+		}
+	}
+	else
+	{
+		//entry left in DueTimers will be skipped.
+		Unlink(TimerIn.Index);
+		Insert(TimerIn.Index);
+	}
+	return true;
+}
+
+float FGAEffectTimingWheel::GetRemaining(const FGAEffectTimerHandle& TimerIn) const
+{
+	if (!IsValidTimer(TimerIn))
+	{
+		return -1;
+	}
+	return FMath::Max<float>(Timers[TimerIn.Index].DueTime - CurrentTime, 0);
+}
+
+bool FGAEffectTimingWheel::IsActive(const FGAEffectTimerHandle& TimerIn) const
+{
+	return IsValidTimer(TimerIn);
+}
+
+void FGAEffectTimingWheel::AdvanceTo(double TimeIn)
+{
+	if (DueCursor > 0)
+	{
+		DueTimers.RemoveAt(0, DueCursor, false);
+		DueCursor = 0;
+	}
+	if (TimeIn > CurrentTime)
+	{
+		CurrentTime = TimeIn;
+		const int64 TargetTick = (int64)(TimeIn / Resolution);
+		if (NumInBuckets == 0)
+		{
+			//nothing to collect, just jump.
+			CurrentTick = FMath::Max(CurrentTick, TargetTick);
+		}
+		while (CurrentTick < TargetTick)
+		{
+			CurrentTick++;
+			//cascade from highest level which wrapped, so timers moved down can cascade again
+			//in the same tick.
+			int32 TopLevel = 0;
+			while (TopLevel + 1 < NumLevels
+				&& (CurrentTick & (((int64)1 << ((TopLevel + 1) * SlotBits)) - 1)) == 0)
+			{
+				TopLevel++;
+			}
+			for (int32 Level = TopLevel; Level > 0; Level--)
+			{
+				Cascade(Level);
+			}
+			CollectSlot((int32)(CurrentTick & SlotMask));
+		}
+	}
+	if (DueTimers.Num() > 1)
+	{
+		TArray<FTimer>& TimersRef = Timers;
+		DueTimers.Sort([&TimersRef](const FDueEntry& A, const FDueEntry& B)
+		{
+			const FTimer& TimerA = TimersRef[A.Index];
+			const FTimer& TimerB = TimersRef[B.Index];
+			if (TimerA.DueTime != TimerB.DueTime)
+				return TimerA.DueTime < TimerB.DueTime;
+			if (TimerA.Type != TimerB.Type)
+				return TimerA.Type < TimerB.Type;
+			return TimerA.Serial < TimerB.Serial;
+		});
+	}
+}
+
+bool FGAEffectTimingWheel::PopDue(FGAEffectTimerEvent& EventOut)
+{
+	while (DueCursor < DueTimers.Num())
+	{
+		const FDueEntry Entry = DueTimers[DueCursor++];
+		FTimer& Timer = Timers[Entry.Index];
+		if (Timer.Bucket != DueBucket || Timer.DueStamp != Entry.Stamp)
+		{
+			continue;
+		}
+		EventOut.Handle = Timer.Handle;
+		EventOut.Type = Timer.Type;
+		if (Timer.Interval > 0)
+		{
+			//keep schedule, even if we are late. Insert will never put it back to current tick.
+			Timer.DueTime += Timer.Interval;
+			Insert(Entry.Index);
+		}
+		else
+		{
+			Free(Entry.Index);
+		}
+		return true;
+	}
+	DueTimers.Reset();
+	DueCursor = 0;
+	return false;
+}
+
+double FGAEffectTimingWheel::GetNextAdvanceTime() const
+{
+	if (DueCursor < DueTimers.Num())
+	{
+		return CurrentTime;
+	}
+	if (NumInBuckets == 0)
+	{
+		return -1;
+	}
+	//first non empty slot on every level. Slot on higher level is reached, when it is cascaded.
+	int64 NextTick = MAX_int64;
+	for (int32 Level = 0; Level < NumLevels; Level++)
+	{
+		const int64 LevelTick = CurrentTick >> (Level * SlotBits);
+		for (int64 Step = 1; Step <= NumSlots; Step++)
+		{
+			if (Buckets[Level * NumSlots + (int32)((LevelTick + Step) & SlotMask)] != INDEX_NONE)
+			{
+				NextTick = FMath::Min(NextTick, (LevelTick + Step) << (Level * SlotBits));
+				break;
+			}
+		}
+	}
+	return (double)NextTick * Resolution;
+}
+
+void FGAEffectTimingWheel::Insert(int32 IndexIn)
+{
+	FTimer& Timer = Timers[IndexIn];
+	Timer.DueTick = TimeToTick(Timer.DueTime);
+	//current slot is already collected.
+	int64 Delta = FMath::Max<int64>(Timer.DueTick - CurrentTick, 1);
+	int64 Tick = CurrentTick + Delta;
+	int32 Level = 0;
+	while (Level + 1 < NumLevels && Delta >= ((int64)1 << ((Level + 1) * SlotBits)))
+	{
+		Level++;
+	}
+	const int64 WheelSpan = (int64)1 << (NumLevels * SlotBits);
+	if (Delta >= WheelSpan)
+	{
+		//too far, park it in the last slot. It will be inserted again when it cascades.
+		Tick = CurrentTick + WheelSpan - 1;
+	}
+	const int32 Bucket = Level * NumSlots + (int32)((Tick >> (Level * SlotBits)) & SlotMask);
+
+	Timer.Bucket = Bucket;
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = Buckets[Bucket];
+	if (Timer.Next != INDEX_NONE)
+	{
+		Timers[Timer.Next].Prev = IndexIn;
+	}
+	Buckets[Bucket] = IndexIn;
+	NumInBuckets++;
+}
+
+void FGAEffectTimingWheel::Unlink(int32 IndexIn)
+{
+	FTimer& Timer = Timers[IndexIn];
+	if (Timer.Bucket >= 0)
+	{
+		if (Timer.Prev != INDEX_NONE)
+		{
+			Timers[Timer.Prev].Next = Timer.Next;
+		}
+		else
+		{
+			Buckets[Timer.Bucket] = Timer.Next;
+		}
+		if (Timer.Next != INDEX_NONE)
+		{
+			Timers[Timer.Next].Prev = Timer.Prev;
+		}
+		NumInBuckets--;
+	}
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = INDEX_NONE;
+	Timer.Bucket = INDEX_NONE;
+}
+
+void FGAEffectTimingWheel::MakeDue(int32 IndexIn)
+{
+	FTimer& Timer = Timers[IndexIn];
+	DueStampCounter++;
+	Timer.Bucket = DueBucket;
+	Timer.DueStamp = DueStampCounter;
+	FDueEntry Entry;
+	Entry.Index = IndexIn;
+	Entry.Stamp = DueStampCounter;
+	DueTimers.Add(Entry);
+}
+
+void FGAEffectTimingWheel::Free(int32 IndexIn)
+{
+	Timers[IndexIn].Bucket = INDEX_NONE;
+	FreeTimers.Push(IndexIn);
+	NumActive--;
+}
+
+void FGAEffectTimingWheel::Cascade(int32 LevelIn)
+{
+	CollectSlot(LevelIn * NumSlots + (int32)((CurrentTick >> (LevelIn * SlotBits)) & SlotMask));
+}
+
+void FGAEffectTimingWheel::CollectSlot(int32 BucketIn)
+{
+	//move every timer out of bucket, either to due list or closer to current tick.
+	int32 Index = Buckets[BucketIn];
+	Buckets[BucketIn] = INDEX_NONE;
+	while (Index != INDEX_NONE)
+	{
+		FTimer& Timer = Timers[Index];
+		const int32 Next = Timer.Next;
+		NumInBuckets--;
+		if (Timer.DueTick <= CurrentTick)
+		{
+			MakeDue(Index);
+		}
+		else
+		{
+			Insert(Index);
+		}
+		Index = Next;
+	}
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include "GAGlobalTypes.h"
+
+enum class EGAEffectTimerType : uint8
+{
+	/* One shot, effect expires when it fires. */
+	Duration,
+	/* Repeats every interval, executes effect. */
+	Period
+};
+
+/* Handle to timer scheduled in FGAEffectTimingWheel. */
+struct GAMEABILITIES_API FGAEffectTimerHandle
+{
+	int32 Index;
+	uint32 Serial;
+
+	inline bool IsSet() const { return Index != INDEX_NONE; }
+	inline void Invalidate()
+	{
+		Index = INDEX_NONE;
+		Serial = 0;
+	}
+
+	FGAEffectTimerHandle()
+		: Index(INDEX_NONE),
+		Serial(0)
+	{}
+	FGAEffectTimerHandle(int32 IndexIn, uint32 SerialIn)
+		: Index(IndexIn),
+		Serial(SerialIn)
+	{}
+};
+
+struct GAMEABILITIES_API FGAEffectTimerEvent
+{
+	FGAEffectHandle Handle;
+	EGAEffectTimerType Type;
+};
+
+/*
+	Hierarchical timing wheel for period and expiration events of active effects.
+
+	Timers are bucketed by the wheel tick they are due in, so scheduling, cancelling and
+	rescheduling (extending duration) are O(1). Advancing time moves every bucket which became due
+	to single list, which is sorted by due time, so events are fired in deterministic order.
+	When duration and period are due at the same time, duration goes first,
+	so effect never ticks at the moment it expires.
+
+	Timer never fires before it's due time, but it can fire up to one wheel tick late.
+*/
+class GAMEABILITIES_API FGAEffectTimingWheel
+{
+public:
+	FGAEffectTimingWheel();
+
+	/*
+		Schedules timer, which fires after DelayIn seconds.
+		If IntervalIn is greater than zero, timer is rescheduled every IntervalIn after firing.
+	*/
+	FGAEffectTimerHandle Schedule(const FGAEffectHandle& HandleIn, EGAEffectTimerType TypeIn,
+		float DelayIn, float IntervalIn = 0);
+	/* Removes timer and invalidates handle. Returns false, if timer was not active. */
+	bool Cancel(FGAEffectTimerHandle& TimerIn);
+	/* Moves timer, so it fires DelayIn seconds from now. */
+	bool Reschedule(const FGAEffectTimerHandle& TimerIn, float DelayIn);
+	/* Time left until timer fires, or -1 if timer is not active. */
+	float GetRemaining(const FGAEffectTimerHandle& TimerIn) const;
+	bool IsActive(const FGAEffectTimerHandle& TimerIn) const;
+
+	/* Advances wheel to TimeIn and collects every timer which is due. */
+	void AdvanceTo(double TimeIn);
+	/* Pops next due event. Returns false, when there is nothing left to fire. */
+	bool PopDue(FGAEffectTimerEvent& EventOut);
+
+	/*
+		Time at which wheel must be advanced next, either because timer becomes due, or because
+		higher level slot must be cascaded. -1 if there are no timers.
+	*/
+	double GetNextAdvanceTime() const;
+
+	inline bool IsEmpty() const { return NumActive == 0; }
+	inline int32 Num() const { return NumActive; }
+	inline double GetTime() const { return CurrentTime; }
+
+	/* Length of single wheel tick in seconds. */
+	static const double Resolution;
+private:
+	enum
+	{
+		SlotBits = 6,
+		NumSlots = 1 << SlotBits,
+		SlotMask = NumSlots - 1,
+		NumLevels = 4,
+		/* Timer is waiting in DueTimers to be popped. */
+		DueBucket = -2
+	};
+	struct FTimer
+	{
+		FGAEffectHandle Handle;
+		double DueTime;
+		int64 DueTick;
+		float Interval;
+		int32 Prev;
+		int32 Next;
+		int32 Bucket;
+		uint32 Serial;
+		/* Identifies entry in DueTimers, so entries left by cancel or reschedule are skipped. */
+		uint32 DueStamp;
+		EGAEffectTimerType Type;
+	};
+	struct FDueEntry
+	{
+		int32 Index;
+		uint32 Stamp;
+	};
+	inline bool IsValidTimer(const FGAEffectTimerHandle& TimerIn) const
+	{
+		return Timers.IsValidIndex(TimerIn.Index) && Timers[TimerIn.Index].Serial == TimerIn.Serial
+			&& Timers[TimerIn.Index].Bucket != INDEX_NONE;
+	}
+	void Insert(int32 IndexIn);
+	void Unlink(int32 IndexIn);
+	void MakeDue(int32 IndexIn);
+	void Free(int32 IndexIn);
+	void Cascade(int32 LevelIn);
+	void CollectSlot(int32 BucketIn);
+	static int64 TimeToTick(double TimeIn);
+
+	TArray<FTimer> Timers;
+	TArray<int32> FreeTimers;
+	/* Heads of timer lists for every slot on every level. */
+	int32 Buckets[NumLevels * NumSlots];
+	/* Timers which are due, sorted by due time. Popped from DueCursor. */
+	TArray<FDueEntry> DueTimers;
+	int32 DueCursor;
+
+	double CurrentTime;
+	int64 CurrentTick;
+	int32 NumActive;
+	/* Timers linked into buckets, not counting due ones. */
+	int32 NumInBuckets;
+	uint32 SerialCounter;
+	uint32 DueStampCounter;
+};
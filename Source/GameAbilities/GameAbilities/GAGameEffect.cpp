@@ -9,82 +9,269 @@
 #include "GAAbilitiesComponent.h"
 #include "GAEffectExecution.h"
 #include "GAEffectExtension.h"
+#include "GACustomCalculation.h"
+#include "GAEffectCue.h"
+#include "AbilityCues/GACueActorPool.h"
 #include "GAGlobalTypes.h"
 #include "GAGameEffect.h"
+#include "GACombatTrace.h"
 
 DEFINE_STAT(STAT_GatherModifiers);
+DEFINE_STAT(STAT_EffectTimers);
 
-void FGAEffectRepInfo::OnApplied()
+float FGAEffectRepInfo::GetRemainingTime(float ServerTimeIn) const
 {
-	/*UGAEffectCue* NewCue = NewObject<UGAEffectCue>(EffectCueClass);
-	if (NewCue)
+	if (Duration <= 0)
 	{
-		if (Context.TargetComp.IsValid())
-		{
-			NewCue->Owner = Context.Target.Get();
-			NewCue->Context = Context;
-			OnAppliedDelegate.CreateUObject(NewCue, &UGAEffectCue::OnEffectApplied);
-			Context.TargetComp->GameEffectContainer.EffectCues.Add(Handle, NewCue);
-			OnAppliedDelegate.ExecuteIfBound();
-		}
-	}*/
-}
-void FGAEffectRepInfo::OnPeriod()
-{
-
+		return -1;
+	}
+	return FMath::Max(AppliedTime + Duration - ServerTimeIn, 0.f);
 }
-void FGAEffectRepInfo::OnRemoved()
+float FGAEffectRepInfo::GetTimeToNextPeriod(float ServerTimeIn) const
 {
-
+	if (PeriodTime <= 0)
+	{
+		return -1;
+	}
+	//first period is executed on application.
+	const float Elapsed = FMath::Max(ServerTimeIn - AppliedTime, 0.f);
+	return PeriodTime - FMath::Fmod(Elapsed, PeriodTime);
 }
 
 void FGAEffectRepInfo::PreReplicatedRemove(const struct FGAEffectContainer& InArraySerializer)
 {
-
+	if (InArraySerializer.OwningComp.IsValid())
+	{
+		InArraySerializer.OwningComp->OnEffectInfoRemoved.Broadcast(*this);
+	}
 }
 void FGAEffectRepInfo::PostReplicatedAdd(const struct FGAEffectContainer& InArraySerializer)
 {
-		OnApplied();
+	if (InArraySerializer.OwningComp.IsValid())
+	{
+		InArraySerializer.OwningComp->OnEffectInfoAdded.Broadcast(*this);
+	}
 }
 void FGAEffectRepInfo::PostReplicatedChange(const struct FGAEffectContainer& InArraySerializer)
 {
-
+	if (InArraySerializer.OwningComp.IsValid())
+	{
+		InArraySerializer.OwningComp->OnEffectInfoChanged.Broadcast(*this);
+	}
 }
 float FGAMagnitude::GetFloatValue(const FGAEffectContext& Context)
+{
+	return GetEvaluator().Evaluate(Context, FGAEffectHandle());
+}
+const FGAMagnitudeEvaluator& FGAMagnitude::GetEvaluator()
+{
+	if (!bCompiled)
+		Compile();
+	return Evaluator;
+}
+void FGAMagnitude::Compile()
+{
+	Evaluator.Compile(*this);
+	bCompiled = true;
+}
+bool FGAMagnitude::IsInstigatorOnly() const
 {
 	switch (CalculationType)
 	{
 	case EGAMagnitudeCalculation::Direct:
+		return true;
+	case EGAMagnitudeCalculation::AttributeBased:
+		return AttributeBased.Source == EGAAttributeSource::Instigator
+			&& (!AttributeBased.bUseSecondaryAttribute || AttributeBased.SecondarySource == EGAAttributeSource::Instigator);
+	case EGAMagnitudeCalculation::SummedAttributeBased:
 	{
-		return DirectModifier.GetValue();
+		for (const FGAAttributeBasedModifier& Attribute : SummedAttributeBased.AttributeBased)
+		{
+			if (Attribute.Source != EGAAttributeSource::Instigator
+				|| (Attribute.bUseSecondaryAttribute && Attribute.SecondarySource != EGAAttributeSource::Instigator))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	case EGAMagnitudeCalculation::CurveBased:
+		return CurveBased.Source == EGAAttributeSource::Instigator;
+	default:
+		//custom calculations can look at anything.
+		return false;
 	}
+}
+void FGAMagnitudeEvaluator::Compile(const FGAMagnitude& MagnitudeIn)
+{
+	CalculationType = MagnitudeIn.CalculationType;
+	DirectValue = MagnitudeIn.DirectModifier.Value;
+	Terms.Reset();
+	CurveTable = nullptr;
+	CurveRowName = NAME_None;
+	CustomCalculation = MagnitudeIn.Custom.CustomCalculation;
+
+	auto AddTerm = [this](const FGAAttributeBasedModifier& ModIn)
+	{
+		FAttributeTerm& Term = Terms[Terms.AddUninitialized()];
+		Term.Source = ModIn.Source;
+		Term.AttributeIndex = ModIn.Attribute.GetAttributeIndex();
+		Term.Coefficient = ModIn.Coefficient;
+		Term.PreMultiply = ModIn.PreMultiply;
+		Term.PostMultiply = ModIn.PostMultiply;
+		Term.PostCoefficient = ModIn.PostCoefficient;
+		Term.bUseSecondaryAttribute = ModIn.bUseSecondaryAttribute;
+		Term.SecondaryMod = ModIn.SecondaryMod;
+	};
+	switch (CalculationType)
+	{
 	case EGAMagnitudeCalculation::AttributeBased:
+		AddTerm(MagnitudeIn.AttributeBased);
+		break;
+	case EGAMagnitudeCalculation::SummedAttributeBased:
+		for (const FGAAttributeBasedModifier& Mod : MagnitudeIn.SummedAttributeBased.AttributeBased)
+		{
+			AddTerm(Mod);
+		}
+		break;
+	case EGAMagnitudeCalculation::CurveBased:
+	{
+		//only Source and Attribute are used, curve is evaluated directly.
+		FGAAttributeBasedModifier CurveMod;
+		CurveMod.Source = MagnitudeIn.CurveBased.Source;
+		CurveMod.Attribute = MagnitudeIn.CurveBased.Attribute;
+		AddTerm(CurveMod);
+		if (!MagnitudeIn.CurveBased.CurveTable.IsNull())
+		{
+			CurveTable = MagnitudeIn.CurveBased.CurveTable.CurveTable;
+			CurveRowName = MagnitudeIn.CurveBased.CurveTable.RowName;
+			//warn about missing row once, evaluation will quietly return 0.
+			static const FString ContextString(TEXT("Compiling magnitude."));
+			MagnitudeIn.CurveBased.CurveTable.GetCurve(ContextString);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+}
+static UGAAttributesBase* GetMagnitudeSourceAttributes(EGAAttributeSource SourceIn, const FGAEffectContext& ContextIn)
+{
+	UGAAttributesBase* Attributes = nullptr;
+	UObject* SourceObject = nullptr;
+	switch (SourceIn)
+	{
+	case EGAAttributeSource::Instigator:
+		Attributes = ContextIn.InstigatorAttributes.Get();
+		SourceObject = ContextIn.Instigator.Get();
+		break;
+	case EGAAttributeSource::Target:
+		Attributes = ContextIn.TargetAttributes.Get();
+		SourceObject = ContextIn.Target.Get();
+		break;
+	case EGAAttributeSource::Causer:
+		SourceObject = ContextIn.Causer.Get();
+		break;
+	default:
+		break;
+	}
+	//context made by hand might not have attributes cached.
+	if (!Attributes)
+	{
+		IIGAAbilities* AttrInt = Cast<IIGAAbilities>(SourceObject);
+		Attributes = AttrInt ? AttrInt->GetAttributes() : nullptr;
+	}
+	return Attributes;
+}
+float FGAMagnitudeEvaluator::EvaluateTerm(const FAttributeTerm& TermIn, const FGAEffectContext& ContextIn)
+{
+	UGAAttributesBase* Attributes = GetMagnitudeSourceAttributes(TermIn.Source, ContextIn);
+	FGAAttributeBase* Attribute = Attributes ? Attributes->GetAttributeByIndex(TermIn.AttributeIndex) : nullptr;
+	if (!Attribute)
+	{
+		return 0;
+	}
+	const float AttributeValue = Attribute->GetFinalValue();
+	float Result = (TermIn.Coefficient * (TermIn.PreMultiply + AttributeValue) + TermIn.PostMultiply) * TermIn.PostCoefficient;
+	if (!TermIn.bUseSecondaryAttribute)
+		return Result;
+
+	switch (TermIn.SecondaryMod)
+	{
+	case EGAAttributeMagCalc::Add:
+		return Result + AttributeValue;
+	case EGAAttributeMagCalc::Subtract:
+		return Result - AttributeValue;
+	case EGAAttributeMagCalc::Multiply:
+		return Result * AttributeValue;
+	case EGAAttributeMagCalc::Divide:
+		return Result / AttributeValue;
+	case EGAAttributeMagCalc::PrecentageIncrease:
+		return Result + (Result * AttributeValue);
+	case EGAAttributeMagCalc::PrecentageDecrease:
+		return Result - (Result * AttributeValue);
+	default:
+		return Result;
+	}
+}
+const FRichCurve* FGAMagnitudeEvaluator::FindCurve() const
+{
+	const UCurveTable* Table = CurveTable.Get();
+	if (!Table)
 	{
-		return AttributeBased.GetValue(Context);
+		return nullptr;
 	}
+	static const FString ContextString(TEXT("Evaluating magnitude."));
+	return Table->FindCurve(CurveRowName, ContextString, false);
+}
+float FGAMagnitudeEvaluator::Evaluate(const FGAEffectContext& ContextIn, const FGAEffectHandle& HandleIn) const
+{
+	switch (CalculationType)
+	{
+	case EGAMagnitudeCalculation::Direct:
+		return DirectValue;
+	case EGAMagnitudeCalculation::AttributeBased:
 	case EGAMagnitudeCalculation::SummedAttributeBased:
 	{
-		return SummedAttributeBased.GetValue(Context);
+		float FinalValue = 0;
+		for (const FAttributeTerm& Term : Terms)
+		{
+			FinalValue += EvaluateTerm(Term, ContextIn);
+		}
+		return FinalValue;
 	}
 	case EGAMagnitudeCalculation::CurveBased:
 	{
-		return CurveBased.GetValue(Context);
+		const FRichCurve* Curve = FindCurve();
+		if (!Curve || Terms.Num() == 0 || Terms[0].Source == EGAAttributeSource::Causer)
+		{
+			return 0;
+		}
+		UGAAttributesBase* Attributes = GetMagnitudeSourceAttributes(Terms[0].Source, ContextIn);
+		FGAAttributeBase* Attribute = Attributes ? Attributes->GetAttributeByIndex(Terms[0].AttributeIndex) : nullptr;
+		return Attribute ? Curve->Eval(Attribute->GetFinalValue()) : 0;
 	}
 	case EGAMagnitudeCalculation::CustomCalculation:
-	{
-		//return  Custom.GetValue(*this);
-	}
+		//custom calculation works on effect, there is nothing to calculate without it.
+		if (CustomCalculation && HandleIn.IsValid())
+		{
+			return CustomCalculation->NativeCalculateMagnitude(HandleIn);
+		}
+		return 0;
 	default:
 		return 0;
 	}
-
-	return 0;
 }
 FGAEffect::FGAEffect(class UGAGameEffectSpec* GameEffectIn,
 	const FGAEffectContext& ContextIn)
 	: GameEffect(GameEffectIn),
 	Context(ContextIn),
-	Execution(GameEffect->ExecutionType.GetDefaultObject())
+	Execution(GameEffect->ExecutionType.GetDefaultObject()),
+	TargetWorld(nullptr),
+	bHasCachedMagnitude(false),
+	CachedMagnitude(0),
+	ActiveRow(INDEX_NONE),
+	RepInfoIndex(INDEX_NONE)
 {
 	OwnedTags = GameEffectIn->OwnedTags;
 	if (ContextIn.TargetComp.IsValid())
@@ -109,9 +296,97 @@ void FGAEffect::SetContext(const FGAEffectContext& ContextIn)
 	Context = ContextIn;
 }
 
+namespace GAEffectPool
+{
+	static FGAEffectPool* Instance = nullptr;
+}
+void FGAEffectPool::Startup()
+{
+	if (!GAEffectPool::Instance)
+	{
+		GAEffectPool::Instance = new FGAEffectPool();
+	}
+}
+void FGAEffectPool::Shutdown()
+{
+	delete GAEffectPool::Instance;
+	GAEffectPool::Instance = nullptr;
+}
+FGAEffectPool& FGAEffectPool::Get()
+{
+	checkf(GAEffectPool::Instance, TEXT("FGAEffectPool used before GameAbilities module startup or after shutdown"));
+	return *GAEffectPool::Instance;
+}
+FGAEffectPool* FGAEffectPool::GetIfStarted()
+{
+	return GAEffectPool::Instance;
+}
+FGAEffectPool::FGAEffectPool()
+	: NumSlots(0),
+	NumInUse(0)
+{
+}
+FGAEffectPool::~FGAEffectPool()
+{
+	for (FSlot* Chunk : Chunks)
+	{
+		delete[] Chunk;
+	}
+	Chunks.Empty();
+}
+FGAEffectHandle FGAEffectPool::Allocate(class UGAGameEffectSpec* SpecIn, const FGAEffectContext& ContextIn)
+{
+	check(IsInGameThread());
+	int32 Index = INDEX_NONE;
+	if (FreeSlots.Num() > 0)
+	{
+		Index = FreeSlots.Pop(false);
+	}
+	else
+	{
+		if (NumSlots == Chunks.Num() * ChunkSize)
+		{
+			Chunks.Add(new FSlot[ChunkSize]);
+		}
+		Index = NumSlots++;
+	}
+	FSlot& Slot = GetSlot(Index);
+	Slot.Effect = FGAEffect(SpecIn, ContextIn);
+	Slot.bInUse = true;
+	NumInUse++;
+
+	FGAEffectHandle Handle(Index, Slot.Generation);
+	Slot.Effect.Handle = Handle;
+	return Handle;
+}
+bool FGAEffectPool::Release(const FGAEffectHandle& HandleIn)
+{
+	check(IsInGameThread());
+	if (!Find(HandleIn))
+	{
+		return false;
+	}
+	FSlot& Slot = GetSlot(HandleIn.GetIndex());
+	//drop context, tags and bound delegates, so released effect doesn't hold on to anything.
+	Slot.Effect = FGAEffect();
+	Slot.bInUse = false;
+	//0 is reserved for invalid handles.
+	Slot.Generation = Slot.Generation == MAX_uint32 ? 1 : Slot.Generation + 1;
+	FreeSlots.Push(HandleIn.GetIndex());
+	NumInUse--;
+	return true;
+}
+
 FGAEffectMod FGAEffect::GetAttributeModifier()
 {
-	return GetMod(GameEffect->AtributeModifier);
+	if (!GameEffect)
+	{
+		return FGAEffectMod();
+	}
+	const FGAAttributeModifier& ModInfo = GameEffect->AtributeModifier;
+	float Magnitude = bHasCachedMagnitude ? CachedMagnitude
+		: GameEffect->GetModifierEvaluator().Evaluate(Context, Handle);
+	return FGAEffectMod(ModInfo.Attribute, Magnitude, ModInfo.AttributeMod, Handle);
 }
 void FGAEffect::OnApplied()
 {
@@ -139,41 +414,11 @@ void FGAEffect::DurationExpired()
 
 float FGAEffect::GetDurationTime()
 {
-	return GetFloatFromAttributeMagnitude(GameEffect->Duration);
+	return GameEffect->GetDurationEvaluator().Evaluate(Context, Handle);
 }
 float FGAEffect::GetPeriodTime()
 {
-	return GetFloatFromAttributeMagnitude(GameEffect->Period);
-}
-float FGAEffect::GetFloatFromAttributeMagnitude(const FGAMagnitude& AttributeIn)
-{
-	switch (AttributeIn.CalculationType)
-	{
-	case EGAMagnitudeCalculation::Direct:
-	{
-		return AttributeIn.DirectModifier.GetValue();
-	}
-	case EGAMagnitudeCalculation::AttributeBased:
-	{
-		return AttributeIn.AttributeBased.GetValue(Context);
-	}
-	case EGAMagnitudeCalculation::SummedAttributeBased:
-	{
-		return AttributeIn.SummedAttributeBased.GetValue(Context);
-	}
-	case EGAMagnitudeCalculation::CurveBased:
-	{
-		return AttributeIn.CurveBased.GetValue(Context);
-	}
-	case EGAMagnitudeCalculation::CustomCalculation:
-	{
-		return AttributeIn.Custom.GetValue(Handle);
-	}
-	default:
-		break;
-	}
-
-	return 0;
+	return GameEffect->GetPeriodEvaluator().Evaluate(Context, Handle);
 }
 float FGAEffect::GetCurrentActivationTime()
 {
@@ -193,63 +438,22 @@ float FGAEffect::GetCurrentTickTime()
 	return CurrentTime - LastTickTime;
 }
 
-FGAEffectMod FGAEffect::GetMod(FGAAttributeModifier& ModInfoIn)
+void FGameCueContainer::PlayCue(TSubclassOf<class UGAGameEffectSpec> SpecClassIn, const FGAEffectCueParams& CueParamsIn)
 {
-	FGAEffectMod ModOut;
-	if (GameEffect)
-	{
-			switch (ModInfoIn.Magnitude.CalculationType)
-			{
-			case EGAMagnitudeCalculation::Direct:
-			{
-				return FGAEffectMod (ModInfoIn.Attribute, 
-					ModInfoIn.Magnitude.DirectModifier.GetValue(), ModInfoIn.AttributeMod, Handle);
-			}
-			case EGAMagnitudeCalculation::AttributeBased:
-			{
-				return FGAEffectMod (ModInfoIn.Attribute, 
-					ModInfoIn.Magnitude.AttributeBased.GetValue(Context), ModInfoIn.AttributeMod, Handle);
-
-			}
-			case EGAMagnitudeCalculation::SummedAttributeBased:
-			{
-				return FGAEffectMod (ModInfoIn.Attribute, 
-					ModInfoIn.Magnitude.SummedAttributeBased.GetValue(Context), ModInfoIn.AttributeMod, Handle);
-
-			}
-			case EGAMagnitudeCalculation::CurveBased:
-			{
-				return FGAEffectMod (ModInfoIn.Attribute, 
-					ModInfoIn.Magnitude.CurveBased.GetValue(Context), ModInfoIn.AttributeMod, Handle);
-
-			}
-			case EGAMagnitudeCalculation::CustomCalculation:
-			{
-				return FGAEffectMod (ModInfoIn.Attribute, 
-					ModInfoIn.Magnitude.Custom.GetValue(Handle), ModInfoIn.AttributeMod, Handle);
-
-			}
-			default:
-				break;
-			}
-	}
-	return ModOut;
-}
-
-void FGameCueContainer::AddCue(FGAEffectHandle EffectHandle, FGAEffectCueParams CueParams)
-{
-	/*if (!EffectCue)
+	UGAAbilitiesComponent* Comp = OwningComp.Get();
+	const UGAGameEffectSpec* Spec = SpecClassIn ? SpecClassIn.GetDefaultObject() : nullptr;
+	if (!Comp || !Spec || !Spec->EffectCue)
 	{
 		return;
 	}
-	AActor* Instigator = EffectHandle.GetContext().Instigator.Get();
-	UGAEffectCue* NewCue = NewObject<UGAEffectCue>(Instigator, EffectCue);
-	if (NewCue && Instigator)
+	const FHitResult& Hit = CueParamsIn.HitResult;
+	AActor* Owner = Hit.GetActor() ? Hit.GetActor() : Comp->GetOwner();
+	AGAEffectCue* Cue = Cast<AGAEffectCue>(FGACueActorPool::Acquire(Comp->GetWorld(), Spec->EffectCue,
+		Hit.ImpactPoint, Owner, Cast<APawn>(CueParamsIn.Instigator.Get())));
+	if (Cue)
 	{
-		NewCue->SetParameters(Instigator, CueParams);
-		NewCue->Context = EffectHandle.GetContext();
-		NewCue->BeginCue();
-	}*/
+		Cue->PlayCue(CueParamsIn);
+	}
 }
 
 void FGAEffectContainer::ApplyEffect(const FGAEffect& EffectIn
@@ -259,7 +463,7 @@ void FGAEffectContainer::ApplyEffect(const FGAEffect& EffectIn
 	//just make effect and run it trough modifiers.
 
 	//FGAEffect Effect = EfNoConst.Calculation->ModiifyEffect(EffectIn);
-	UE_LOG(GameAttributesEffects, Log, TEXT("UGAAbilitiesComponent:: Apply periodic effect: %s"), *EffectIn.GameEffect->GetName());
+	FGACombatTrace::RecordEffect(HandleIn, EGACombatTraceEvent::Apply);
 	switch (EffectIn.GameEffect->EffectType)
 	{
 	case EGAEffectType::Instant:
@@ -270,19 +474,16 @@ void FGAEffectContainer::ApplyEffect(const FGAEffect& EffectIn
 	}
 	case EGAEffectType::Periodic:
 	{
-		UE_LOG(GameAttributesEffects, Log, TEXT("UGAAbilitiesComponent:: Apply periodic effect"));
 		InternalCheckPeriodicEffectStacking(HandleIn);
 		break;
 	}
 	case EGAEffectType::Duration:
 	{
-		UE_LOG(GameAttributesEffects, Log, TEXT("UGAAbilitiesComponent:: Apply effect for duration"));
 		InternalCheckDurationEffectStacking(HandleIn);
 		break;
 	}
 	case EGAEffectType::Infinite:
 	{
-		UE_LOG(GameAttributesEffects, Log, TEXT("UGAAbilitiesComponent:: Apply periodic effect with infinite duration"));
 		InternalCheckInfiniteEffectStacking(HandleIn);
 		break;
 	}
@@ -301,14 +502,71 @@ void FGAEffectContainer::ApplyEffect(const FGAEffect& EffectIn
 }
 void FGAEffectContainer::ApplyReplicationInfo(const FGAEffectHandle& HandleIn)
 {
-	//TSharedPtr<FGAEffect> EffectPtr = HandleIn.GetEffectPtr();
-	//UGAGameEffectSpec* EffectSpec = HandleIn.GetEffectSpec();
-	//if (EffectPtr.IsValid() && EffectSpec && EffectSpec->EffectCue)
-	//{
-	//	FGAEffectRepInfo RepInfo(0, EffectSpec->Period, EffectSpec->Duration, 0);
-	////	RepInfo.EffectCueClass = EffectSpec->EffectCue;
-	//	MarkItemDirty(RepInfo);
-	//}
+	//OnApplied might have removed effect already.
+	if (!HandleIn.IsValid())
+	{
+		return;
+	}
+	FGAEffect& Effect = HandleIn.GetEffectRef();
+	UGAGameEffectSpec* Spec = Effect.GameEffect;
+	UWorld* World = GetWorld();
+	//instant effects, and effects which only extended other effect, are not active on their own.
+	if (!World || Effect.RepInfoIndex != INDEX_NONE
+		|| (Spec->EffectType != EGAEffectType::Infinite && !EffectTimers.IsActive(Effect.DurationTimerHandle)))
+	{
+		return;
+	}
+	Effect.RepInfoIndex = ActiveEffectInfos.AddDefaulted();
+	FGAEffectRepInfo& Info = ActiveEffectInfos[Effect.RepInfoIndex];
+	Info.Handle = HandleIn;
+	Info.SpecClass = Spec->GetClass();
+	Info.AppliedTime = World->GetTimeSeconds();
+	Info.Duration = FMath::Max(EffectTimers.GetRemaining(Effect.DurationTimerHandle), 0.f);
+	Info.PeriodTime = EffectTimers.IsActive(Effect.PeriodTimerHandle) ? Effect.GetPeriodTime() : 0;
+	Info.StackCount = 1;
+	MarkItemDirty(Info);
+	//listen server doesn't get replication callbacks.
+	OwningComp->OnEffectInfoAdded.Broadcast(Info);
+}
+void FGAEffectContainer::InternalUpdateReplicationInfo(const FGAEffectHandle& HandleIn, float DurationIn, int32 StackCountDelta)
+{
+	FGAEffect& Effect = HandleIn.GetEffectRef();
+	UWorld* World = GetWorld();
+	if (!World || !ActiveEffectInfos.IsValidIndex(Effect.RepInfoIndex))
+	{
+		return;
+	}
+	FGAEffectRepInfo& Info = ActiveEffectInfos[Effect.RepInfoIndex];
+	Info.AppliedTime = World->GetTimeSeconds();
+	Info.Duration = DurationIn;
+	Info.StackCount += StackCountDelta;
+	MarkItemDirty(Info);
+	OwningComp->OnEffectInfoChanged.Broadcast(Info);
+}
+void FGAEffectContainer::InternalRemoveReplicationInfo(const FGAEffectHandle& HandleIn)
+{
+	FGAEffect& Effect = HandleIn.GetEffectRef();
+	const int32 Index = Effect.RepInfoIndex;
+	if (!ActiveEffectInfos.IsValidIndex(Index))
+	{
+		return;
+	}
+	if (OwningComp.IsValid())
+	{
+		OwningComp->OnEffectInfoRemoved.Broadcast(ActiveEffectInfos[Index]);
+	}
+	//order doesn't matter for fast array, items are matched by ReplicationID.
+	ActiveEffectInfos.RemoveAtSwap(Index, 1, false);
+	if (ActiveEffectInfos.IsValidIndex(Index))
+	{
+		FGAEffect* Moved = ActiveEffectInfos[Index].Handle.GetEffectPtr();
+		if (Moved)
+		{
+			Moved->RepInfoIndex = Index;
+		}
+	}
+	Effect.RepInfoIndex = INDEX_NONE;
+	MarkArrayDirty();
 }
 void FGAEffectContainer::InternalCheckDurationEffectStacking(const FGAEffectHandle& HandleIn)
 {
@@ -316,30 +574,7 @@ void FGAEffectContainer::InternalCheckDurationEffectStacking(const FGAEffectHand
 	//sEGAEffectStacking Stacking = Spec->EffectStacking;
 	EGAEffectAggregation Aggregation = Spec->EffectAggregation;
 	EGAEffectStacking Stacking = HandleIn.GetEffectSpec()->EffectStacking;
-	UE_LOG(GameAttributes, Log, TEXT("Stacking Type: %s"), *EnumToString::GetStatckingAsString(Stacking));
-	FGAEffectHandle* Handle = nullptr;
-	switch (Aggregation)
-	{
-		case EGAEffectAggregation::AggregateByInstigator:
-		{
-			TMap<FName, TSet<FGAEffectHandle>>* EffectHandle = InstigatorEffectHandles.Find(HandleIn.GetContextRef().Instigator.Get());
-			TSet<FGAEffectHandle>* HandleSet = nullptr;
-			if (EffectHandle)
-			{
-				HandleSet = EffectHandle->Find(HandleIn.GetEffectSpec()->GetFName());
-				if (HandleSet)
-				{
-					Handle = HandleSet->Find(HandleIn);
-				}
-			}
-		}
-		case EGAEffectAggregation::AggregateByTarget:
-		{
-			Handle = TargetEffectByType.Find(HandleIn.GetEffectSpec()->GetFName());
-			
-			break;
-		}
-	}
+	FGAEffectHandle Handle = FindHandleByAggregation(HandleIn);
 	switch (Stacking)
 	{
 		case EGAEffectStacking::Add:
@@ -349,28 +584,27 @@ void FGAEffectContainer::InternalCheckDurationEffectStacking(const FGAEffectHand
 		}
 		case EGAEffectStacking::Duration:
 		{
-			if (Handle)
-			{
-				InternalExtendEffectDuration(*Handle, HandleIn);
-			}
-			else
+			if (Handle.IsValid())
 			{
-				FGAEffectHandle InvalidHandle;
-				InternalExtendEffectDuration(HandleIn, InvalidHandle);
+				InternalExtendEffectDuration(Handle, HandleIn);
+				//only existing effect was extended, new one is never active on it's own.
+				return;
 			}
+			FGAEffectHandle InvalidHandle;
+			InternalExtendEffectDuration(HandleIn, InvalidHandle);
 			break;
 		}
 		case EGAEffectStacking::Intensity:
 		{
 			//Add new modifiers to existing effect without affecting old effect duration ?
-			break;
+			//nothing is applied yet, don't keep effect without timers around.
+			return;
 		}
 		case EGAEffectStacking::Override:
 		{
-			if (Handle)
+			if (Handle.IsValid())
 			{
-				//RemoveEffect(*Handle);
-				RemoveOverrideEffects(*Handle);
+				RemoveOverrideEffects(Handle);
 			}
 			else
 			{
@@ -399,56 +633,26 @@ bool FGAEffectContainer::RemoveEffectsByTags(const FGameplayTagContainer& TagsIn
 {
 	return false;
 }
-TSharedPtr<FGAEffect> FGAEffectContainer::RemoveEffectByAggregation(const FGAEffectHandle& HandleIn)
+bool FGAEffectContainer::RemoveEffectByAggregation(const FGAEffectHandle& HandleIn)
 {
-	EGAEffectAggregation aggregatiopn = HandleIn.GetEffectRef().GameEffect->EffectAggregation;
-	UObject* Instigator = HandleIn.GetContextRef().Instigator.Get();
 	UGAAbilitiesComponent* Target = HandleIn.GetContextRef().TargetComp.Get();
-	TSharedPtr<FGAEffect> Effect = ActiveEffects.FindRef(HandleIn);
-	if (!Effect.IsValid())
-		return nullptr;
+	FGAEffect* Effect = GetEffectByHandle(HandleIn);
+	if (!Effect)
+		return false;
 
-	switch (aggregatiopn)
-	{
-	case EGAEffectAggregation::AggregateByInstigator:
-	{
-		TMap<FGAEffectHandle, TSharedPtr<FGAEffect>>* effects = InstigatorEffects.Find(Instigator);
-		TMap<FName, TSet<FGAEffectHandle>>* EffectByClass = InstigatorEffectHandles.Find(Instigator);
-		if (EffectByClass)
-		{
-			//Probabaly need another path for removing just single effect from stack.
-			EffectByClass->Remove(HandleIn.GetEffectSpec()->GetFName());
-		}
-		if (effects)
-		{
-			effects->FindAndRemoveChecked(HandleIn);
-			if (effects->Num() == 0)
-			{
-				InstigatorEffects.Remove(Instigator);
-			}
-		}
-		break;
-	}
-	case EGAEffectAggregation::AggregateByTarget:
-	{
-		//TargetEffects.FindAndRemoveChecked(HandleIn);
-		//check aggregation type to know which effect to remove exactly ?
-		TargetEffectByType.Remove(HandleIn.GetEffectSpec()->GetFName());
-		break;
-	}
-	}
+	ActiveEffects.Remove(HandleIn);
 	Target->AppliedTags.RemoveTagContainer(Effect->ApplyTags);
 	Effect->OnEffectRemoved.ExecuteIfBound();
-	ActiveEffects.Remove(HandleIn);
-	UE_LOG(GameAttributesEffects, Log, TEXT("FGAEffectContainer:: Removing Effect %s "), *Effect->GameEffect->GetName())
-	return Effect;
+	FGACombatTrace::RecordEffect(HandleIn, EGACombatTraceEvent::Remove);
+	InternalReleaseEffect(HandleIn);
+	return true;
 }
 bool FGAEffectContainer::RemoveWeakerEffect(const FGAEffectHandle& HandleIn)
 {
 	bool bRemoved = false;
 	if (!ActiveEffects.Contains(HandleIn))
 	{
-		UE_LOG(GameAttributes, Log, TEXT("RemoveEffect Effect %s Is not applied"), *HandleIn.GetEffectRef().ToString());
+		UE_LOG(GameAttributes, Log, TEXT("RemoveEffect Effect %d:%u Is not applied"), HandleIn.GetIndex(), HandleIn.GetGeneration());
 		return bRemoved;
 	}
 	UGAAbilitiesComponent* Target = HandleIn.GetContextRef().TargetComp.Get();
@@ -458,9 +662,9 @@ bool FGAEffectContainer::RemoveWeakerEffect(const FGAEffectHandle& HandleIn)
 		{
 			if (attr->CheckIfStronger(HandleIn))
 			{
-				UE_LOG(GameAttributes, Log, TEXT("Value Before bonus of attribute = %f"), attr->GetFinalValue());
+				const float OldValue = attr->GetFinalValue();
 				attr->RemoveBonus(HandleIn);
-				UE_LOG(GameAttributes, Log, TEXT("Value After bonus of attribute = %f"), attr->GetFinalValue());
+				FGACombatTrace::RecordModify(HandleIn, HandleIn.GetAttribute(), OldValue, attr->GetFinalValue());
 				RemoveEffectByAggregation(HandleIn);
 				bRemoved = true;
 			}
@@ -475,8 +679,6 @@ void FGAEffectContainer::InternalCheckPeriodicEffectStacking(const FGAEffectHand
 	//sEGAEffectStacking Stacking = Spec->EffectStacking;
 	EGAEffectAggregation Aggregation = Spec->EffectAggregation;
 	EGAEffectStacking Stacking = HandleIn.GetEffectSpec()->EffectStacking;
-	UE_LOG(GameAttributes, Log, TEXT("Stacking Type: %s"), *EnumToString::GetStatckingAsString(Stacking));
-	FGAEffectHandle* Handle = FindHandlePtrByAggregation(HandleIn);
 	switch (Stacking)
 	{
 		case EGAEffectStacking::Add:
@@ -506,29 +708,21 @@ void FGAEffectContainer::InternalCheckPeriodicEffectStacking(const FGAEffectHand
 void FGAEffectContainer::InternalApplyPeriodic(const FGAEffectHandle& HandleIn)
 {
 	FGAEffect& EffectRef = HandleIn.GetEffectRef();
-	FTimerDelegate delPeriod = FTimerDelegate::CreateUObject(HandleIn.GetContext().TargetComp.Get(), &UGAAbilitiesComponent::ExecuteEffect, HandleIn);
-	FTimerManager& PeriodicTimer = EffectRef.Context.TargetComp->GetWorld()->GetTimerManager();
-	
 	float period = EffectRef.GetPeriodTime();
-	PeriodicTimer.SetTimer(EffectRef.PeriodTimerHandle, delPeriod,
-		period, true, 0);
+	InternalSetEffectTimer(EffectRef.PeriodTimerHandle, HandleIn, EGAEffectTimerType::Period,
+		0, period);
 
-	FTimerDelegate delDuration = FTimerDelegate::CreateUObject(HandleIn.GetContext().TargetComp.Get(), &UGAAbilitiesComponent::ExpireEffect, HandleIn);
-	FTimerManager& timerDuration = EffectRef.Context.TargetComp->GetWorld()->GetTimerManager();
 	float Duration = EffectRef.GetDurationTime();
-	timerDuration.SetTimer(EffectRef.DurationTimerHandle, delDuration,
-		Duration, false, Duration);
+	InternalSetEffectTimer(EffectRef.DurationTimerHandle, HandleIn, EGAEffectTimerType::Duration,
+		Duration);
 
 	InternalApplyEffectTags(HandleIn);
 }
 void FGAEffectContainer::InternalApplyDuration(const FGAEffectHandle& HandleIn)
 {
 	FGAEffect& EffectRef = HandleIn.GetEffectRef();
-	FTimerDelegate delDuration = FTimerDelegate::CreateUObject(HandleIn.GetContext().TargetComp.Get(), &UGAAbilitiesComponent::ExpireEffect, HandleIn);
-	FTimerManager& timerDuration = EffectRef.Context.TargetComp->GetWorld()->GetTimerManager();
-
-	timerDuration.SetTimer(EffectRef.DurationTimerHandle, delDuration,
-		EffectRef.GetDurationTime(), false, EffectRef.GetDurationTime());
+	InternalSetEffectTimer(EffectRef.DurationTimerHandle, HandleIn, EGAEffectTimerType::Duration,
+		EffectRef.GetDurationTime());
 
 	InternalApplyEffectTags(HandleIn);
 	HandleIn.GetContext().TargetComp->ExecuteEffect(HandleIn);
@@ -542,11 +736,9 @@ void FGAEffectContainer::InternalCheckInfiniteEffectStacking(const FGAEffectHand
 void FGAEffectContainer::InternalApplyInfiniteEffect(const FGAEffectHandle& HandleIn)
 {
 	FGAEffect& EffectRef = HandleIn.GetEffectRef();
-	FTimerDelegate delPeriod = FTimerDelegate::CreateUObject(HandleIn.GetContext().TargetComp.Get(), &UGAAbilitiesComponent::ExecuteEffect, HandleIn);
-	FTimerManager& PeriodicTimer = EffectRef.Context.TargetComp->GetWorld()->GetTimerManager();
 	float period = EffectRef.GetPeriodTime();
-	PeriodicTimer.SetTimer(EffectRef.PeriodTimerHandle, delPeriod,
-		period, true, 0);
+	InternalSetEffectTimer(EffectRef.PeriodTimerHandle, HandleIn, EGAEffectTimerType::Period,
+		0, period);
 
 	InternalApplyEffectTags(HandleIn);
 	HandleIn.GetContext().TargetComp->ExecuteEffect(HandleIn);
@@ -561,52 +753,19 @@ void FGAEffectContainer::InternalApplyEffectTags(const FGAEffectHandle& HandleIn
 }
 void FGAEffectContainer::InternalApplyEffectByAggregation(const FGAEffectHandle& HandleIn)
 {
-	EGAEffectAggregation Aggregation = HandleIn.GetEffectRef().GameEffect->EffectAggregation;
-
-	switch (Aggregation)
-	{
-	case EGAEffectAggregation::AggregateByInstigator:
-	{
-		TMap<FGAEffectHandle, TSharedPtr<FGAEffect>>& EffectMap = InstigatorEffects.FindOrAdd(HandleIn.GetContextRef().Instigator.Get());
-		EffectMap.Add(HandleIn, HandleIn.GetEffectPtr());
-		TMap<FName, TSet<FGAEffectHandle>>& EffectByClass = InstigatorEffectHandles.FindOrAdd(HandleIn.GetContextRef().Instigator.Get());
-		TSet<FGAEffectHandle>& EffectSet = EffectByClass.FindOrAdd(HandleIn.GetEffectSpec()->GetFName());
-		EffectSet.Add(HandleIn);
-
-		break;
-	}
-	case EGAEffectAggregation::AggregateByTarget:
-	{
-		//only one effect of given class can exist when aggregated by target.
-		FGAEffectHandle& Handle = TargetEffectByType.FindOrAdd(HandleIn.GetEffectSpec()->GetFName());
-		
-		Handle = HandleIn;
-		//TargetEffects.Add(HandleIn, HandleIn.GetEffectPtr());
-
-		break;
-	}
-	}
-	TSet<FGAEffectHandle>& Effects = EffectByAttribute.FindOrAdd(HandleIn.GetAttribute());
-	Effects.Add(HandleIn);
-	ActiveEffects.Add(HandleIn, HandleIn.GetEffectPtr());
+	//store indexes effect by attribute, instigator and spec, aggregation is resolved trough those.
+	ActiveEffects.Add(HandleIn);
 }
 void FGAEffectContainer::InternalApplyEffect(const FGAEffectHandle& HandleIn)
 {
-	UE_LOG(GameAttributesEffects, Log, TEXT("InternalApplyEffect"));
 	FGAEffect& Effect = HandleIn.GetEffectRef();
 	if (HandleIn.GetEffectSpec()->EffectType == EGAEffectType::Periodic)
 	{
-		FTimerDelegate delPeriod = FTimerDelegate::CreateUObject(HandleIn.GetContext().TargetComp.Get(), &UGAAbilitiesComponent::ExecuteEffect, HandleIn);
-		FTimerManager& PeriodicTimer = Effect.Context.TargetComp->GetWorld()->GetTimerManager();
-
-		PeriodicTimer.SetTimer(Effect.PeriodTimerHandle, delPeriod,
-			Effect.GetPeriodTime(), true, 0);
+		InternalSetEffectTimer(Effect.PeriodTimerHandle, HandleIn, EGAEffectTimerType::Period,
+			0, Effect.GetPeriodTime());
 	}
-	FTimerDelegate delDuration = FTimerDelegate::CreateUObject(HandleIn.GetContext().TargetComp.Get(), &UGAAbilitiesComponent::ExpireEffect, HandleIn);
-	FTimerManager& timerDuration = Effect.Context.TargetComp->GetWorld()->GetTimerManager();
-
-	timerDuration.SetTimer(Effect.DurationTimerHandle, delDuration,
-		Effect.GetDurationTime(), false);
+	InternalSetEffectTimer(Effect.DurationTimerHandle, HandleIn, EGAEffectTimerType::Duration,
+		Effect.GetDurationTime());
 
 	HandleIn.GetEffectRef().OnApplied();
 }
@@ -616,14 +775,15 @@ void FGAEffectContainer::InternalExtendEffectDuration(const FGAEffectHandle& Han
 	{
 		FGAEffect& ExtEffect = ExtendingHandleIn.GetEffectRef();
 		FGAEffect& Effect = HandleIn.GetEffectRef();
-		FTimerManager& DurationTimer = HandleIn.GetContext().TargetComp->GetWorld()->GetTimerManager();
-		float RemainingTime = DurationTimer.GetTimerRemaining(Effect.DurationTimerHandle);
+		float RemainingTime = FMath::Max(EffectTimers.GetRemaining(Effect.DurationTimerHandle), 0.f);
 		float NewDuration = RemainingTime + ExtEffect.GetDurationTime();
-		DurationTimer.ClearTimer(Effect.DurationTimerHandle);
-
-		FTimerDelegate delDuration = FTimerDelegate::CreateUObject(HandleIn.GetContext().TargetComp.Get(), &UGAAbilitiesComponent::ExpireEffect, HandleIn);
-		DurationTimer.SetTimer(Effect.DurationTimerHandle, delDuration,
-			NewDuration, false);
+		//move existing timer, instead of removing and adding new one.
+		if (!EffectTimers.Reschedule(Effect.DurationTimerHandle, NewDuration))
+		{
+			InternalSetEffectTimer(Effect.DurationTimerHandle, HandleIn, EGAEffectTimerType::Duration,
+				NewDuration);
+		}
+		InternalUpdateReplicationInfo(HandleIn, NewDuration, 1);
 	}
 	else
 	{
@@ -633,22 +793,16 @@ void FGAEffectContainer::InternalExtendEffectDuration(const FGAEffectHandle& Han
 int32 FGAEffectContainer::RemoveOverrideEffects(const FGAEffectHandle& HandleIn)
 {
 	int32 EffectsRemoved = 0;
-	if (!ActiveEffects.Contains(HandleIn))
+	const TArray<int32>* Rows = ActiveEffects.GetRowsByAttribute(HandleIn.GetAttribute());
+	if (!Rows)
 	{
-		UE_LOG(GameAttributes, Log, TEXT("RemoveOverrideEffects Effect %s Is not applied"), *HandleIn.GetEffectRef().ToString());
-	//	return EffectsRemoved;
+		return EffectsRemoved;
 	}
-	TSet<FGAEffectHandle> Effects = EffectByAttribute.FindRef(HandleIn.GetAttribute());
+	//removing effect moves rows around, collect handles first.
 	TArray<FGAEffectHandle> EffectsToRemove;
-	FGameplayTagQuery Q;
-	
-	for (const FGAEffectHandle& Handle : Effects)
+	for (int32 Row : *Rows)
 	{
-		Q.BuildQuery(FGameplayTagQueryExpression()
-			.AllTagsMatch()
-			.AddTags(Handle.GetOwnedTags())
-		);
-		bool queryMatch = HandleIn.GetOwnedTags().MatchesQuery(Q);
+		const FGAEffectHandle& Handle = ActiveEffects.GetHandle(Row);
 		if (Handle.HasAllTags(HandleIn.GetOwnedTags()) //add checking for number of tags ?
 			&& Handle.GetAttributeMod() == HandleIn.GetAttributeMod())
 		{
@@ -667,15 +821,15 @@ int32 FGAEffectContainer::RemoveOverrideEffects(const FGAEffectHandle& HandleIn)
 int32 FGAEffectContainer::RemoveStrongerOverrideEffects(const FGAEffectHandle& HandleIn)
 {
 	int32 EffectsRemoved = 0;
-	if (!ActiveEffects.Contains(HandleIn))
+	const TArray<int32>* Rows = ActiveEffects.GetRowsByAttribute(HandleIn.GetAttribute());
+	if (!Rows)
 	{
-		UE_LOG(GameAttributes, Log, TEXT("RemoveOverrideEffects Effect %s Is not applied"), *HandleIn.GetEffectRef().ToString());
-		//	return EffectsRemoved;
+		return EffectsRemoved;
 	}
-	TSet<FGAEffectHandle> Effects = EffectByAttribute.FindRef(HandleIn.GetAttribute());
 	TArray<FGAEffectHandle> EffectsToRemove;
-	for (const FGAEffectHandle& Handle : Effects)
+	for (int32 Row : *Rows)
 	{
+		const FGAEffectHandle& Handle = ActiveEffects.GetHandle(Row);
 		if (Handle.HasAllTags(HandleIn.GetOwnedTags())
 			&& HandleIn.GetAttributeModifier() > Handle.GetAttributeModifier())
 		{
@@ -693,99 +847,149 @@ int32 FGAEffectContainer::RemoveStrongerOverrideEffects(const FGAEffectHandle& H
 }
 void FGAEffectContainer::RemoveEffect(FGAEffectHandle& HandleIn)
 {
-	if (!ActiveEffects.Contains(HandleIn))
+	FGAEffect* effect = GetEffectByHandle(HandleIn);
+	if (!effect)
 	{
-		UE_LOG(GameAttributes, Log, TEXT("RemoveEffect Effect %s Is not applied"), *HandleIn.GetEffectRef().ToString());
+		UE_LOG(GameAttributes, Log, TEXT("RemoveEffect Effect %d:%u Is not applied"), HandleIn.GetIndex(), HandleIn.GetGeneration());
 		return;
 	}
-	EGAEffectAggregation aggregatiopn = HandleIn.GetEffectRef().GameEffect->EffectAggregation;
-	UObject* Instigator = HandleIn.GetContextRef().Instigator.Get();
 	UGAAbilitiesComponent* Target = HandleIn.GetContextRef().TargetComp.Get();
-	TSharedPtr<FGAEffect> effect = ActiveEffects.FindAndRemoveChecked(HandleIn);
-	TSet<FGAEffectHandle> Effects = EffectByAttribute.FindRef(HandleIn.GetAttribute());
-	
-	//if (Effects)
+	//released handles must not stay in store, they can't be resolved anymore.
+	ActiveEffects.Remove(HandleIn);
+
+	Target->AppliedTags.RemoveTagContainer(effect->ApplyTags);
+	FGAAttributeBase* attr = Target->GetAttribute(HandleIn.GetEffectSpec()->AtributeModifier.Attribute);
+	if (attr)
 	{
-		Effects.Remove(HandleIn);
-		if (Effects.Num() == 0)
-		{
-			EffectByAttribute.Remove(HandleIn.GetAttribute());
-		}
+		const float OldValue = attr->GetFinalValue();
+		attr->RemoveBonus(HandleIn);
+		FGACombatTrace::RecordModify(HandleIn, HandleIn.GetEffectSpec()->AtributeModifier.Attribute, OldValue, attr->GetFinalValue());
 	}
-	if (effect.IsValid())
+	effect->OnEffectRemoved.ExecuteIfBound();
+	FGACombatTrace::RecordEffect(HandleIn, EGACombatTraceEvent::Remove);
+	InternalReleaseEffect(HandleIn);
+}
+void FGAEffectContainer::InternalReleaseEffect(const FGAEffectHandle& HandleIn)
+{
+	InternalRemoveReplicationInfo(HandleIn);
+	FGAEffect& Effect = HandleIn.GetEffectRef();
+	//timers hold copy of handle, they would only fire on stale handle.
+	EffectTimers.Cancel(Effect.PeriodTimerHandle);
+	EffectTimers.Cancel(Effect.DurationTimerHandle);
+	FGAEffectPool::Get().Release(HandleIn);
+}
+void FGAEffectContainer::InternalSetEffectTimer(FGAEffectTimerHandle& TimerInOut, const FGAEffectHandle& HandleIn,
+	EGAEffectTimerType TypeIn, float DelayIn, float IntervalIn)
+{
+	EffectTimers.Cancel(TimerInOut);
+	//same as timer manager, non positive time means no timer.
+	if ((TypeIn == EGAEffectTimerType::Period ? IntervalIn : DelayIn) <= 0)
 	{
-		switch (aggregatiopn)
-		{
-			case EGAEffectAggregation::AggregateByInstigator:
-			{
-				TMap<FGAEffectHandle, TSharedPtr<FGAEffect>>* effects = InstigatorEffects.Find(Instigator);
-				TMap<FName, TSet<FGAEffectHandle>>* EffectByClass = InstigatorEffectHandles.Find(Instigator);
-				if (EffectByClass)
-				{
-					//Probabaly need another path for removing just single effect from stack.
-					EffectByClass->Remove(HandleIn.GetEffectSpec()->GetFName());
-				}
-				if (effects)
-				{
-					effects->FindAndRemoveChecked(HandleIn);
-					if (effects->Num() == 0)
-					{
-						InstigatorEffects.Remove(Instigator);
-					}
-				}
-				break;
-			}
-			case EGAEffectAggregation::AggregateByTarget:
-			{
-				//TargetEffects.FindAndRemoveChecked(HandleIn);
-				//check aggregation type to know which effect to remove exactly ?
-				TargetEffectByType.Remove(HandleIn.GetEffectSpec()->GetFName());
-				break;
-			}
-		}
-		Target->AppliedTags.RemoveTagContainer(effect->ApplyTags);
-		FGAAttributeBase* attr = Target->GetAttribute(HandleIn.GetEffectSpec()->AtributeModifier.Attribute);
-		if (attr)
+		return;
+	}
+	UGAAbilitiesComponent* Comp = OwningComp.Get();
+	UWorld* World = Comp ? Comp->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+	//wheel might lag behind (or not be advanced at all while empty), delay is from current time.
+	EffectTimers.AdvanceTo(World->GetTimeSeconds());
+	TimerInOut = EffectTimers.Schedule(HandleIn, TypeIn, DelayIn, IntervalIn);
+	InternalArmEffectTimers(false);
+}
+void FGAEffectContainer::InternalArmEffectTimers(bool bForceIn)
+{
+	UGAAbilitiesComponent* Comp = OwningComp.Get();
+	UWorld* World = Comp ? Comp->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+	FTimerManager& TimerManager = World->GetTimerManager();
+	const double NextTime = EffectTimers.GetNextAdvanceTime();
+	if (NextTime < 0)
+	{
+		TimerManager.ClearTimer(EffectTimersHandle);
+		return;
+	}
+	if (!bForceIn && TimerManager.IsTimerActive(EffectTimersHandle) && NextTime >= EffectTimersArmedTime)
+	{
+		return;
+	}
+	EffectTimersArmedTime = NextTime;
+	//non positive rate would clear timer, due timers will fire next frame.
+	const float Delay = FMath::Max<float>(NextTime - World->GetTimeSeconds(), KINDA_SMALL_NUMBER);
+	FTimerDelegate Del = FTimerDelegate::CreateUObject(Comp, &UGAAbilitiesComponent::TickEffectTimers);
+	TimerManager.SetTimer(EffectTimersHandle, Del, Delay, false);
+}
+void FGAEffectContainer::TickEffectTimers()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EffectTimers);
+	UGAAbilitiesComponent* Comp = OwningComp.Get();
+	UWorld* World = Comp ? Comp->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+	EffectTimers.AdvanceTo(World->GetTimeSeconds());
+	FGAEffectTimerEvent Event;
+	while (EffectTimers.PopDue(Event))
+	{
+		switch (Event.Type)
 		{
-			UE_LOG(GameAttributes, Log, TEXT("Value Before bonus of attribute = %f"), attr->GetFinalValue());
-			attr->RemoveBonus(HandleIn);
-			UE_LOG(GameAttributes, Log, TEXT("Value After bonus of attribute = %f"), attr->GetFinalValue());
+		case EGAEffectTimerType::Period:
+			Comp->ExecuteEffect(Event.Handle);
+			break;
+		case EGAEffectTimerType::Duration:
+			Comp->ExpireEffect(Event.Handle);
+			break;
 		}
-		effect->OnEffectRemoved.ExecuteIfBound();
-		UE_LOG(GameAttributesEffects, Log, TEXT("FGAEffectContainer:: Removing Effect %s "), *effect->GameEffect->GetName())
-		//effect.Reset();
 	}
+	//handle is still executing, so it must be armed again even if it looks active.
+	InternalArmEffectTimers(true);
 }
-FGAEffectHandle* FGAEffectContainer::FindHandlePtrByAggregation(const FGAEffectHandle& HandleIn)
+FGAEffectHandle FGAEffectContainer::FindHandleByAggregation(const FGAEffectHandle& HandleIn)
 {
 	UGAGameEffectSpec* Spec = HandleIn.GetEffectSpec();
-	//sEGAEffectStacking Stacking = Spec->EffectStacking;
-	EGAEffectAggregation Aggregation = Spec->EffectAggregation;
-	FGAEffectHandle* Handle = nullptr;
-	switch (Aggregation)
+	const TArray<int32>* Rows = ActiveEffects.GetRowsBySpec(Spec->GetFName());
+	if (!Rows)
 	{
-	case EGAEffectAggregation::AggregateByInstigator:
+		return FGAEffectHandle();
+	}
+	UObject* Instigator = HandleIn.GetContextRef().Instigator.Get();
+	for (int32 Row : *Rows)
 	{
-		TMap<FName, TSet<FGAEffectHandle>>* EffectHandle = InstigatorEffectHandles.Find(HandleIn.GetContextRef().Instigator.Get());
-		TSet<FGAEffectHandle>* HandleSet = nullptr;
-		if (EffectHandle)
+		const FGAEffectHandle& Handle = ActiveEffects.GetHandle(Row);
+		if (Handle == HandleIn)
+		{
+			continue;
+		}
+		switch (Spec->EffectAggregation)
+		{
+		case EGAEffectAggregation::AggregateByInstigator:
 		{
-			HandleSet = EffectHandle->Find(HandleIn.GetEffectSpec()->GetFName());
-			if (HandleSet)
+			if (ActiveEffects.GetInstigator(Row) == Instigator)
 			{
-				Handle = HandleSet->Find(HandleIn);
+				return Handle;
 			}
+			break;
+		}
+		case EGAEffectAggregation::AggregateByTarget:
+		{
+			//only one effect of given spec can exist when aggregated by target.
+			if (ActiveEffects.GetEffect(Row)->GameEffect->EffectAggregation == EGAEffectAggregation::AggregateByTarget)
+			{
+				return Handle;
+			}
+			break;
+		}
 		}
 	}
-	case EGAEffectAggregation::AggregateByTarget:
-	{
-		Handle = TargetEffectByType.Find(HandleIn.GetEffectSpec()->GetFName());
-		break;
-	}
-	}
-	return Handle;
+	return FGAEffectHandle();
 }
 FGAEffectContainer::FGAEffectContainer()
+	: EffectTimersArmedTime(0)
 {
 }
 
@@ -820,7 +1024,7 @@ void FGAEffectContainer::RemoveEffectInstance(class UGAEffectExtension* EffectIn
 			Effects->Effects.Remove(EffectIn);
 			if (Effects->Effects.Num() == 0)
 			{
-				InstigatorEffects.Remove(EffectIn->Context.Instigator.Get());
+				InstigatorInstancedEffects.Remove(EffectIn->Context.Instigator.Get());
 			}
 		}
 		break;
@@ -835,26 +1039,170 @@ void FGAEffectContainer::RemoveEffectInstance(class UGAEffectExtension* EffectIn
 
 bool FGAEffectContainer::IsEffectActive(const FGAEffectHandle& HandleIn)
 {
-	if (ActiveEffects.Contains(HandleIn))
+	return ActiveEffects.Contains(HandleIn);
+}
+FGAEffect* FGAEffectContainer::GetEffectByHandle(const FGAEffectHandle& HandleIn)
+{
+	int32 Row = ActiveEffects.FindRow(HandleIn);
+	return Row != INDEX_NONE ? ActiveEffects.GetEffect(Row) : nullptr;
+}
+
+int32 FGAActiveEffectStore::Add(const FGAEffectHandle& HandleIn)
+{
+	FGAEffect* Effect = HandleIn.GetEffectPtr();
+	check(Effect);
+	int32 Row = FindRow(HandleIn);
+	if (Row != INDEX_NONE)
 	{
-		return true;
+		return Row;
 	}
-	return false;
+	Row = Handles.Add(HandleIn);
+	Effects.Add(Effect);
+	Effect->ActiveRow = Row;
+
+	const int32 AttributeIndex = HandleIn.GetAttribute().GetAttributeIndex();
+	AttributeIndices.Add(AttributeIndex);
+	if (AttributeIndex != INDEX_NONE)
+	{
+		if (RowsByAttribute.Num() <= AttributeIndex)
+		{
+			RowsByAttribute.SetNum(AttributeIndex + 1);
+		}
+		AttributeSlots.Add(AddToList(RowsByAttribute[AttributeIndex], Row));
+	}
+	else
+	{
+		AttributeSlots.Add(INDEX_NONE);
+	}
+	UObject* Instigator = Effect->Context.Instigator.Get();
+	Instigators.Add(Instigator);
+	InstigatorSlots.Add(AddToList(RowsByInstigator.FindOrAdd(Instigator), Row));
+
+	const FName SpecName = Effect->GameEffect->GetFName();
+	SpecNames.Add(SpecName);
+	SpecSlots.Add(AddToList(RowsBySpec.FindOrAdd(SpecName), Row));
+	return Row;
 }
-TSharedPtr<FGAEffect> FGAEffectContainer::GetEffectByHandle(const FGAEffectHandle& HandleIn)
+bool FGAActiveEffectStore::Remove(const FGAEffectHandle& HandleIn)
 {
-	return ActiveEffects.FindRef(HandleIn);
+	const int32 Row = FindRow(HandleIn);
+	if (Row == INDEX_NONE)
+	{
+		return false;
+	}
+	if (AttributeIndices[Row] != INDEX_NONE)
+	{
+		RemoveFromList(RowsByAttribute[AttributeIndices[Row]], AttributeSlots[Row], AttributeSlots);
+	}
+	TArray<int32>& InstigatorRows = RowsByInstigator.FindChecked(Instigators[Row]);
+	RemoveFromList(InstigatorRows, InstigatorSlots[Row], InstigatorSlots);
+	if (InstigatorRows.Num() == 0)
+	{
+		//instigators come and go, don't keep empty lists for them.
+		RowsByInstigator.Remove(Instigators[Row]);
+	}
+	RemoveFromList(RowsBySpec.FindChecked(SpecNames[Row]), SpecSlots[Row], SpecSlots);
+	Effects[Row]->ActiveRow = INDEX_NONE;
+
+	//move last row in place of removed one, and point lists to it's new position.
+	const int32 LastRow = Handles.Num() - 1;
+	if (Row != LastRow)
+	{
+		if (AttributeIndices[LastRow] != INDEX_NONE)
+		{
+			RowsByAttribute[AttributeIndices[LastRow]][AttributeSlots[LastRow]] = Row;
+		}
+		RowsByInstigator.FindChecked(Instigators[LastRow])[InstigatorSlots[LastRow]] = Row;
+		RowsBySpec.FindChecked(SpecNames[LastRow])[SpecSlots[LastRow]] = Row;
+		Effects[LastRow]->ActiveRow = Row;
+	}
+	Handles.RemoveAtSwap(Row, 1, false);
+	Effects.RemoveAtSwap(Row, 1, false);
+	AttributeIndices.RemoveAtSwap(Row, 1, false);
+	Instigators.RemoveAtSwap(Row, 1, false);
+	SpecNames.RemoveAtSwap(Row, 1, false);
+	AttributeSlots.RemoveAtSwap(Row, 1, false);
+	InstigatorSlots.RemoveAtSwap(Row, 1, false);
+	SpecSlots.RemoveAtSwap(Row, 1, false);
+	return true;
+}
+int32 FGAActiveEffectStore::FindRow(const FGAEffectHandle& HandleIn) const
+{
+	FGAEffect* Effect = HandleIn.GetEffectPtr();
+	if (!Effect)
+	{
+		return INDEX_NONE;
+	}
+	//effect is active in single container, make sure it is this one.
+	const int32 Row = Effect->ActiveRow;
+	if (Handles.IsValidIndex(Row) && Handles[Row] == HandleIn)
+	{
+		return Row;
+	}
+	return INDEX_NONE;
+}
+const TArray<int32>* FGAActiveEffectStore::GetRowsByAttribute(const FGAAttribute& AttributeIn) const
+{
+	const int32 AttributeIndex = AttributeIn.GetAttributeIndex();
+	if (RowsByAttribute.IsValidIndex(AttributeIndex) && RowsByAttribute[AttributeIndex].Num() > 0)
+	{
+		return &RowsByAttribute[AttributeIndex];
+	}
+	return nullptr;
+}
+const TArray<int32>* FGAActiveEffectStore::GetRowsByInstigator(UObject* InstigatorIn) const
+{
+	return RowsByInstigator.Find(InstigatorIn);
+}
+const TArray<int32>* FGAActiveEffectStore::GetRowsBySpec(const FName& SpecNameIn) const
+{
+	const TArray<int32>* Rows = RowsBySpec.Find(SpecNameIn);
+	return Rows && Rows->Num() > 0 ? Rows : nullptr;
+}
+int32 FGAActiveEffectStore::AddToList(TArray<int32>& ListIn, int32 RowIn)
+{
+	return ListIn.Add(RowIn);
+}
+void FGAActiveEffectStore::RemoveFromList(TArray<int32>& ListIn, int32 SlotIn, TArray<int32>& SlotsIn)
+{
+	ListIn.RemoveAtSwap(SlotIn, 1, false);
+	if (ListIn.IsValidIndex(SlotIn))
+	{
+		SlotsIn[ListIn[SlotIn]] = SlotIn;
+	}
 }
 UWorld* FGAEffectContainer::GetWorld() const
 {
-	if (OwningComponent)
+	if (OwningComp.IsValid())
 	{
-		return OwningComponent->GetWorld();
+		return OwningComp->GetWorld();
 	}
 	return nullptr;
 }
 
 UGAGameEffectSpec::UGAGameEffectSpec()
+	: bMagnitudesCompiled(false)
 {
 	ExecutionType = UGAEffectExecution::StaticClass();
+}
+void UGAGameEffectSpec::PostLoad()
+{
+	Super::PostLoad();
+	CompileMagnitudes();
+}
+#if WITH_EDITOR
+void UGAGameEffectSpec::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	CompileMagnitudes();
+}
+#endif
+void UGAGameEffectSpec::CompileMagnitudes()
+{
+	Duration.Compile();
+	Period.Compile();
+	AtributeModifier.Magnitude.Compile();
+	DenyTagsMask = FGATagMask::Make(DenyTags);
+	RequiredTagsMask = FGATagMask::Make(RequiredTags);
+	bMagnitudesCompiled = true;
 }
\ No newline at end of file
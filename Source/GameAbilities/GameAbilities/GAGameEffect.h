@@ -1,12 +1,14 @@
 #pragma once
 //#include "GAGlobalTypes.h"
 #include "GAEffectGlobalTypes.h"
+#include "GAEffectTimingWheel.h"
 #include "GameplayTagContainer.h"
 //#include "NetSerialization.h"
 #include "GAGameEffect.generated.h"
 
 DECLARE_STATS_GROUP(TEXT("GameEffect"), STATGROUP_GameEffect, STATCAT_Advanced);
 DECLARE_CYCLE_STAT_EXTERN(TEXT("GatherModifiers"), STAT_GatherModifiers, STATGROUP_GameEffect, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("EffectTimers"), STAT_EffectTimers, STATGROUP_GameEffect, );
 
 /*
 	Modifier type for simple attribute operatinos.
@@ -29,6 +31,48 @@ enum class EGAMakeSpecResult : uint8
 	Invalid
 };
 
+/*
+	FGAMagnitude compiled for evaluation. Attributes are resolved to dense attribute indices,
+	so evaluating it doesn't allocate nor search attributes by name.
+*/
+struct GAMEABILITIES_API FGAMagnitudeEvaluator
+{
+	struct FAttributeTerm
+	{
+		EGAAttributeSource Source;
+		int32 AttributeIndex;
+		float Coefficient;
+		float PreMultiply;
+		float PostMultiply;
+		float PostCoefficient;
+		bool bUseSecondaryAttribute;
+		EGAAttributeMagCalc SecondaryMod;
+	};
+	EGAMagnitudeCalculation CalculationType;
+	float DirectValue;
+	/* Single term for AttributeBased and CurveBased, any number for SummedAttributeBased. */
+	TArray<FAttributeTerm, TInlineAllocator<1>> Terms;
+	/*
+		Table is not owned and row is looked up on every evaluation, so reimported
+		or unloaded table is never read trough dangling curve.
+	*/
+	TWeakObjectPtr<const class UCurveTable> CurveTable;
+	FName CurveRowName;
+	class UGACustomCalculation* CustomCalculation;
+
+	void Compile(const struct FGAMagnitude& MagnitudeIn);
+	float Evaluate(const FGAEffectContext& ContextIn, const FGAEffectHandle& HandleIn) const;
+
+	FGAMagnitudeEvaluator()
+		: CalculationType(EGAMagnitudeCalculation::Direct),
+		DirectValue(0),
+		CustomCalculation(nullptr)
+	{}
+private:
+	static float EvaluateTerm(const FAttributeTerm& TermIn, const FGAEffectContext& ContextIn);
+	const FRichCurve* FindCurve() const;
+};
+
 USTRUCT(BlueprintType)
 struct GAMEABILITIES_API FGAMagnitude
 {
@@ -65,7 +109,25 @@ public:
 	UPROPERTY(EditAnywhere)
 		FGACustomCalculationModifier Custom;
 
+	/* Evaluates compiled magnitude. */
 	float GetFloatValue(const FGAEffectContext& Context);
+	/*
+		True if value is taken only from instigator, so it will be the same for every target
+		and can be calculated once for many targets.
+	*/
+	bool IsInstigatorOnly() const;
+
+	/* Evaluator compiled from this magnitude. It's compiled on first use. */
+	const FGAMagnitudeEvaluator& GetEvaluator();
+	/* Compiles evaluator again. Call it after changing magnitude. */
+	void Compile();
+
+	FGAMagnitude()
+		: bCompiled(false)
+	{}
+private:
+	FGAMagnitudeEvaluator Evaluator;
+	bool bCompiled;
 };
 USTRUCT(BlueprintType)
 struct GAMEABILITIES_API FGAAttributeModifier
@@ -97,7 +159,6 @@ public:
 	UPROPERTY(EditAnywhere)
 		FGAMagnitude Magnitude;
 };
-
 UCLASS(Blueprintable, BlueprintType, EditInLineNew)
 class GAMEABILITIES_API UGAGameEffectSpec : public UObject
 {
@@ -143,6 +204,10 @@ public:
 
 	UPROPERTY(EditAnywhere, Category = "Modifiers")
 		TSubclassOf<class UGAEffectExtension> Extension;
+
+	/* Actor played on clients where effect hit. Taken from FGACueActorPool. */
+	UPROPERTY(EditAnywhere, Category = "Cues")
+		TSubclassOf<class AGAEffectCue> EffectCue;
 	/* 
 		Effects applied when this effect is applied. 
 		These effects will be applied with the same context and the same target as
@@ -188,8 +253,52 @@ public:
 	/* Tags, required for this effect to be active. If these tags are not present, effect will be ignored. */
 	UPROPERTY(EditAnywhere, Category = "Tags")
 		FGameplayTagContainer OngoingRequiredTags;
+protected:
+	FGATagMask DenyTagsMask;
+	FGATagMask RequiredTagsMask;
+	bool bMagnitudesCompiled;
 public:
 	UGAGameEffectSpec();
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	/*
+		Compiles Duration, Period, AtributeModifier and tag masks of DenyTags and RequiredTags.
+		Call it after changing them at runtime.
+	*/
+	void CompileMagnitudes();
+
+	inline const FGAMagnitudeEvaluator& GetDurationEvaluator()
+	{
+		if (!bMagnitudesCompiled)
+			CompileMagnitudes();
+		return Duration.GetEvaluator();
+	}
+	inline const FGAMagnitudeEvaluator& GetPeriodEvaluator()
+	{
+		if (!bMagnitudesCompiled)
+			CompileMagnitudes();
+		return Period.GetEvaluator();
+	}
+	inline const FGAMagnitudeEvaluator& GetModifierEvaluator()
+	{
+		if (!bMagnitudesCompiled)
+			CompileMagnitudes();
+		return AtributeModifier.Magnitude.GetEvaluator();
+	}
+	inline const FGATagMask& GetDenyTagsMask()
+	{
+		if (!bMagnitudesCompiled)
+			CompileMagnitudes();
+		return DenyTagsMask;
+	}
+	inline const FGATagMask& GetRequiredTagsMask()
+	{
+		if (!bMagnitudesCompiled)
+			CompileMagnitudes();
+		return RequiredTagsMask;
+	}
 };
 
 USTRUCT(BlueprintType)
@@ -215,7 +324,7 @@ struct FGAEffectActive
 	Calculcated magnitudes, captured attributes and tags, set duration.
 	Final effect which then is used to apply custom calculations and attribute changes.
 */
-struct GAMEABILITIES_API FGAEffect : public TSharedFromThis<FGAEffect>
+struct GAMEABILITIES_API FGAEffect
 {
 	/* Cached pointer to original effect spec. */
 	class UGAGameEffectSpec* GameEffect;
@@ -238,8 +347,9 @@ public:
 
 	FGAEffectHandle Handle;
 
-	FTimerHandle PeriodTimerHandle;
-	FTimerHandle DurationTimerHandle;
+	/* Timers in owning FGAEffectContainer::EffectTimers. */
+	FGAEffectTimerHandle PeriodTimerHandle;
+	FGAEffectTimerHandle DurationTimerHandle;
 	/* Spawmed by which ability. */
 	TWeakObjectPtr<class UGAAbilityBase> Ability;
 //because I'm fancy like that and like to make spearate public for fields and functions.
@@ -251,9 +361,23 @@ public:
 
 	float AppliedTime;
 	float LastTickTime;
+protected:
+	/* Magnitude calculated up front, when it was shared between many targets. */
+	bool bHasCachedMagnitude;
+	float CachedMagnitude;
 public:
+	/* Row in FGAActiveEffectStore of container, in which effect is active. */
+	int32 ActiveRow;
+	/* Index in FGAEffectContainer::ActiveEffectInfos, if effect is replicated. */
+	int32 RepInfoIndex;
+
 	void SetContext(const FGAEffectContext& ContextIn);
 	FGAEffectMod GetAttributeModifier();
+	inline void SetCachedMagnitude(float MagnitudeIn)
+	{
+		bHasCachedMagnitude = true;
+		CachedMagnitude = MagnitudeIn;
+	}
 
 	class UGAAbilitiesComponent* GetInstigatorComp() { return Context.InstigatorComp.Get(); }
 	class UGAAbilitiesComponent* GetTargetComp() { return Context.TargetComp.Get(); }
@@ -271,7 +395,6 @@ public:
 	float GetCurrentActivationTime();
 	float GetCurrentActivationTime() const;
 	float GetCurrentTickTime();
-	float GetFloatFromAttributeMagnitude(const FGAMagnitude& AttributeIn);
 	bool IsValid() const
 	{
 		return GameEffect != nullptr;
@@ -285,15 +408,85 @@ public:
 		return FString();
 	}
 	FGAEffect()
-		: GameEffect(nullptr)
+		: GameEffect(nullptr),
+		Execution(nullptr),
+		TargetWorld(nullptr),
+		bHasCachedMagnitude(false),
+		CachedMagnitude(0),
+		ActiveRow(INDEX_NONE),
+		RepInfoIndex(INDEX_NONE)
 	{}
 	FGAEffect(class UGAGameEffectSpec* GameEffectIn, 
 		const FGAEffectContext& ContextIn);
 
 	~FGAEffect();
+};
 
+/*
+	Owns every FGAEffect created trough FGAEffectHandle::GenerateHandle.
+	Effects are kept in fixed size chunks, so pointers to them stay stable when pool grows
+	and released slots are reused, instead of allocating new effect for every application.
+	Each slot have generation, which is bumped when effect is released, so stale handles
+	are detected, instead of keeping effect alive trough reference counting.
+
+	Effects are only created and released on game thread.
+	Pool is owned by module, it's created on Startup and destroyed, with every effect left in it,
+	on Shutdown.
+*/
+class GAMEABILITIES_API FGAEffectPool
+{
+public:
+	/* Called by module. */
+	static void Startup();
+	static void Shutdown();
+
+	/* Pool owned by module. Asserts if module is not started. */
+	static FGAEffectPool& Get();
+	/* Pool owned by module, or nullptr before Startup and after Shutdown. */
+	static FGAEffectPool* GetIfStarted();
+
+	FGAEffectHandle Allocate(class UGAGameEffectSpec* SpecIn, const FGAEffectContext& ContextIn);
+	/* Returns nullptr if slot is not in use or generation does not match. */
+	inline FGAEffect* Find(int32 IndexIn, uint32 GenerationIn) const
+	{
+		if (IndexIn < 0 || IndexIn >= NumSlots)
+			return nullptr;
+		FSlot& Slot = GetSlot(IndexIn);
+		return Slot.Generation == GenerationIn && Slot.bInUse ? &Slot.Effect : nullptr;
+	}
+	/* Effect handle points to. Returns nullptr for invalid or stale handle, never asserts. */
+	inline FGAEffect* Find(const FGAEffectHandle& HandleIn) const
+	{
+		return Find(HandleIn.GetIndex(), HandleIn.GetGeneration());
+	}
+	/* Frees slot. Every handle pointing to it becomes invalid. */
+	bool Release(const FGAEffectHandle& HandleIn);
+
+	inline int32 Num() const { return NumInUse; }
+	inline int32 GetCapacity() const { return NumSlots; }
+
+	FGAEffectPool();
+	~FGAEffectPool();
 private:
-	FGAEffectMod GetMod(FGAAttributeModifier& ModInfoIn);
+	enum { ChunkSize = 256 };
+	struct FSlot
+	{
+		FGAEffect Effect;
+		uint32 Generation;
+		bool bInUse;
+		FSlot()
+			: Generation(1),
+			bInUse(false)
+		{}
+	};
+	inline FSlot& GetSlot(int32 IndexIn) const
+	{
+		return Chunks[IndexIn / ChunkSize][IndexIn % ChunkSize];
+	}
+	TArray<FSlot*> Chunks;
+	TArray<int32> FreeSlots;
+	int32 NumSlots;
+	int32 NumInUse;
 };
 
 /*
@@ -368,52 +561,54 @@ struct GAMEABILITIES_API FGAInstigatorInstancedEffectContainer
 	effects.
 */
 
+/*
+	Replicated state of single active effect. Marked dirty only when effect is applied, extended
+	(stacked) or removed. Clients derive timers from AppliedTime, Duration and PeriodTime
+	instead of being told about every period.
+*/
 USTRUCT(BlueprintType)
 struct GAMEABILITIES_API FGAEffectRepInfo : public FFastArraySerializerItem
 {
 	GENERATED_USTRUCT_BODY()
 
 public:
-	//Handle to effect, which is using this info.
+	/* Handle to effect on server. Identifies effect, but can't be resolved on clients. */
 	UPROPERTY()
 		FGAEffectHandle Handle;
-	UPROPERTY()
+	/* Class of effect spec. Use it to find out how effect should be displayed. */
+	UPROPERTY(BlueprintReadOnly, Category = "Effect")
+		TSubclassOf<class UGAGameEffectSpec> SpecClass;
+	/* Server world time at which effect has been applied or last extended. */
+	UPROPERTY(BlueprintReadOnly, Category = "Effect")
 		float AppliedTime;
-	UPROPERTY()
-		float PeriodTime;
-	UPROPERTY()
+	/* Duration from AppliedTime. 0 for infinite effects. */
+	UPROPERTY(BlueprintReadOnly, Category = "Effect")
 		float Duration;
-	UPROPERTY()
-		float ReplicationTime;
-
-	FSimpleDelegate OnAppliedDelegate;
-
-	UPROPERTY()
-		FGAEffectContext Context;
+	UPROPERTY(BlueprintReadOnly, Category = "Effect")
+		float PeriodTime;
+	UPROPERTY(BlueprintReadOnly, Category = "Effect")
+		int32 StackCount;
 
-	void OnApplied();
-	void OnPeriod();
-	void OnRemoved();
+	/* Time left, or -1 for infinite effects. */
+	float GetRemainingTime(float ServerTimeIn) const;
+	/* Time until next period, or -1 if effect is not periodic. */
+	float GetTimeToNextPeriod(float ServerTimeIn) const;
 
 	void PreReplicatedRemove(const struct FGAEffectContainer& InArraySerializer);
 	void PostReplicatedAdd(const struct FGAEffectContainer& InArraySerializer);
 	void PostReplicatedChange(const struct FGAEffectContainer& InArraySerializer);
 
-
 	FGAEffectRepInfo()
+		: AppliedTime(0),
+		Duration(0),
+		PeriodTime(0),
+		StackCount(0)
 	{};
 
 	const bool operator==(const FGAEffectRepInfo& Other) const
 	{
 		return Handle == Other.Handle;
 	}
-
-	FGAEffectRepInfo(float AppliedTimeIn, float PeriodTimeIn, float DurationIn, float ReplicationTimeIn)
-		: AppliedTime(AppliedTimeIn),
-		PeriodTime(PeriodTimeIn),
-		Duration(DurationIn),
-		ReplicationTime(ReplicationTimeIn)
-	{};
 };
 
 USTRUCT()
@@ -434,8 +629,62 @@ struct GAMEABILITIES_API FGameCueContainer
 
 	TWeakObjectPtr<UGAAbilitiesComponent> OwningComp;
 public:
-	void AddCue(FGAEffectHandle EffectHandle, FGAEffectCueParams CueParams);
+	/*
+		Takes EffectCue of spec from FGACueActorPool and plays it at hit location.
+		Cue is owned by hit actor (or by owner of component), so it goes back to pool when
+		that actor is gone.
+	*/
+	void PlayCue(TSubclassOf<class UGAGameEffectSpec> SpecClassIn, const FGAEffectCueParams& CueParamsIn);
+};
+/*
+	Dense table of effects active in single FGAEffectContainer.
+	Every effect is single row in struct of arrays. Removing effect moves last row in it's place,
+	so rows are always contiguous and iterating all active effects is just walking arrays.
+	Rows are also listed by attribute, instigator and spec. Lists are updated in O(1) on add and remove
+	(every row remembers it's position in lists), and are returned directly, without copying.
+*/
+struct GAMEABILITIES_API FGAActiveEffectStore
+{
+public:
+	/* Adds effect, returns it's row. */
+	int32 Add(const FGAEffectHandle& HandleIn);
+	bool Remove(const FGAEffectHandle& HandleIn);
+	int32 FindRow(const FGAEffectHandle& HandleIn) const;
+	inline bool Contains(const FGAEffectHandle& HandleIn) const { return FindRow(HandleIn) != INDEX_NONE; }
+
+	inline int32 Num() const { return Handles.Num(); }
+	inline const TArray<FGAEffectHandle>& GetHandles() const { return Handles; }
+	inline const FGAEffectHandle& GetHandle(int32 RowIn) const { return Handles[RowIn]; }
+	inline FGAEffect* GetEffect(int32 RowIn) const { return Effects[RowIn]; }
+	inline UObject* GetInstigator(int32 RowIn) const { return Instigators[RowIn]; }
+
+	/* Rows of effects, which modify attribute. nullptr if there are none. */
+	const TArray<int32>* GetRowsByAttribute(const FGAAttribute& AttributeIn) const;
+	const TArray<int32>* GetRowsByInstigator(UObject* InstigatorIn) const;
+	/* Rows of effects made from spec with given name. */
+	const TArray<int32>* GetRowsBySpec(const FName& SpecNameIn) const;
+private:
+	static int32 AddToList(TArray<int32>& ListIn, int32 RowIn);
+	/* Removes row from list, and updates position of row which has been moved in it's place. */
+	static void RemoveFromList(TArray<int32>& ListIn, int32 SlotIn, TArray<int32>& SlotsIn);
+
+	TArray<FGAEffectHandle> Handles;
+	TArray<FGAEffect*> Effects;
+	/* Keys are stored in row, because they can't be reliably read from effect on removal. */
+	TArray<int32> AttributeIndices;
+	TArray<UObject*> Instigators;
+	TArray<FName> SpecNames;
+	/* Position of row in each of lists. */
+	TArray<int32> AttributeSlots;
+	TArray<int32> InstigatorSlots;
+	TArray<int32> SpecSlots;
+
+	/* Indexed by FGAAttribute::GetAttributeIndex(). */
+	TArray<TArray<int32>> RowsByAttribute;
+	TMap<UObject*, TArray<int32>> RowsByInstigator;
+	TMap<FName, TArray<int32>> RowsBySpec;
 };
+
 USTRUCT(BlueprintType)
 struct GAMEABILITIES_API FGAEffectContainer : public FFastArraySerializer
 {
@@ -446,40 +695,21 @@ public:
 	UPROPERTY()
 		TArray<FGAEffectRepInfo> ActiveEffectInfos;
 
-	TMap<FGAAttribute, TSet<FGAEffectHandle>> EffectByAttribute;
-
-	TMap<FGAEffectHandle, TSharedPtr<FGAEffect>> ActiveEffects;
-
-	/* 
-		Contains effects with infinite duration.
-		Infinite effects are considred to be special case, where they can only be self spplied
-		and must be manually removed.
-	*/
-	TMap<FGAEffectHandle, TSharedPtr<FGAEffect>> InfiniteEffects;
 	/*
-		Both of these maps are for determining how effects should stack.
+		All active effects, with indices by attribute, instigator and spec
+		used to determine how effects should stack.
 	*/
-	/* Effects grouped by their instigator. */
-	TMap<UObject*, TMap<FGAEffectHandle, TSharedPtr<FGAEffect>>> InstigatorEffects;
-	/* Groups effects by their class, needed to handle overriding and effect stacking. */
-	//TMap<UObject*, TMap<UClass*, FGAEffectHandle>> InstigatorEffectHandles;
-	
-	//not really sure if we really need set.\
-	// it could be usefull, for effects which stack in add.
-	/*
-		UObject* - Instigator
-		FName = Effect class name
-		FGAEffectHandle = handle to effect of class.
-	*/
-	TMap<UObject*, TMap<FName, TSet<FGAEffectHandle>>> InstigatorEffectHandles;
+	FGAActiveEffectStore ActiveEffects;
 
-	/* Effects grouped by their targer */
-	TMap<FGAEffectHandle, TSharedPtr<FGAEffect>> TargetEffects;
+	/* Period and expiration events of all effects in this container. */
+	FGAEffectTimingWheel EffectTimers;
 	/*
-		FName = Effect class name
-		FGAEffectHandle = handle to effect of class.
+		One shot timer, armed for next time EffectTimers must be advanced and armed again
+		after every advance, so there is no timer at all while wheel is empty.
 	*/
-	TMap<FName, FGAEffectHandle> TargetEffectByType;
+	FTimerHandle EffectTimersHandle;
+	/* World time, for which EffectTimersHandle is armed. */
+	double EffectTimersArmedTime;
 
 	/* Add Handle for instanced effects ? */
 	/* Keeps effects instanced per instigator */
@@ -490,13 +720,12 @@ public:
 	UPROPERTY(NotReplicated)
 	TArray<class UGAEffectExtension*> TargetInstancedEffects;
 
-	UPROPERTY(NotReplicated)
-		class UGAAbilitiesComponent* OwningComponent;
 public:
 	FGAEffectContainer();
 
 	void ApplyEffect(const FGAEffect& EffectIn, const FGAEffectHandle& HandleIn);
 	void RemoveEffect(FGAEffectHandle& HandleIn);
+	/* Adds replicated info of active effect, if it is not replicated already. */
 	void ApplyReplicationInfo(const FGAEffectHandle& HandleIn);
 
 	void ApplyEffectInstance(class UGAEffectExtension* EffectIn);
@@ -505,6 +734,8 @@ public:
 	void ApplyEffectsFromMods() {};
 	void DoesQualify() {};
 	bool IsEffectActive(const FGAEffectHandle& HandleIn);
+	/* Fires every period and expiration, which is due. */
+	void TickEffectTimers();
 protected:
 	void InternalApplyPeriodic(const FGAEffectHandle& HandleIn);
 	void InternalApplyDuration(const FGAEffectHandle& HandleIn);
@@ -520,13 +751,24 @@ protected:
 	bool RemoveEffectsByTags(const FGameplayTagContainer& TagsIn);
 	int32 RemoveOverrideEffects(const FGAEffectHandle& HandleIn);
 	int32 RemoveStrongerOverrideEffects(const FGAEffectHandle& HandleIn);
-	TSharedPtr<FGAEffect> RemoveEffectByAggregation(const FGAEffectHandle& HandleIn);
-	FGAEffectHandle* FindHandlePtrByAggregation(const FGAEffectHandle& HandleIn);
-	TSharedPtr<FGAEffect> GetEffectByHandle(const FGAEffectHandle& HandleIn);
+	bool RemoveEffectByAggregation(const FGAEffectHandle& HandleIn);
+	/* Finds active effect, with which HandleIn should stack. Invalid handle, if there is none. */
+	FGAEffectHandle FindHandleByAggregation(const FGAEffectHandle& HandleIn);
+	FGAEffect* GetEffectByHandle(const FGAEffectHandle& HandleIn);
+	/* Clears timers of removed effect and gives it back to FGAEffectPool. */
+	void InternalReleaseEffect(const FGAEffectHandle& HandleIn);
+	void InternalUpdateReplicationInfo(const FGAEffectHandle& HandleIn, float DurationIn, int32 StackCountDelta);
+	void InternalRemoveReplicationInfo(const FGAEffectHandle& HandleIn);
+	void InternalSetEffectTimer(FGAEffectTimerHandle& TimerInOut, const FGAEffectHandle& HandleIn,
+		EGAEffectTimerType TypeIn, float DelayIn, float IntervalIn = 0);
+	/*
+		Arms EffectTimersHandle for next advance of EffectTimers, or clears it if wheel is empty.
+		Unless forced, timer is only moved to earlier time.
+	*/
+	void InternalArmEffectTimers(bool bForceIn);
 public:
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo & DeltaParms)
 	{
-		//return FastArrayDeltaSerialize<FGAEffectRepInfo>(ActiveEffectInfos, DeltaParms, *this);
 		return FFastArraySerializer::FastArrayDeltaSerialize<FGAEffectRepInfo, FGAEffectContainer>(ActiveEffectInfos, DeltaParms, *this);
 	}
 	UWorld* GetWorld() const;
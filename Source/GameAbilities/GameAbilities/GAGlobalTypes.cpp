@@ -9,47 +9,53 @@
 #include "IGAAbilities.h"
 #include "GACustomCalculation.h"
 
-FGAEffectHandle::~FGAEffectHandle()
+bool FGAEffectHandle::IsValid() const
 {
-	Reset();
+	return GetEffectPtr() != nullptr;
 }
-FGAEffectContext& FGAEffectHandle::GetContextRef() { return EffectPtr->Context; }
-FGAEffectContext& FGAEffectHandle::GetContextRef() const { return EffectPtr->Context; }
+FGAEffectContext& FGAEffectHandle::GetContextRef() { return GetEffectRef().Context; }
+FGAEffectContext& FGAEffectHandle::GetContextRef() const { return GetEffectRef().Context; }
 
-UGAGameEffectSpec* FGAEffectHandle::GetEffectSpec() { return EffectPtr->GameEffect; }
-UGAGameEffectSpec* FGAEffectHandle::GetEffectSpec() const { return EffectPtr->GameEffect; }
+UGAGameEffectSpec* FGAEffectHandle::GetEffectSpec() { return GetEffectRef().GameEffect; }
+UGAGameEffectSpec* FGAEffectHandle::GetEffectSpec() const { return GetEffectRef().GameEffect; }
 
-uint32 FGAEffectHandle::GetHandle() const { return Handle; }
+FGAEffect FGAEffectHandle::GetEffect() { return GetEffectRef(); }
+FGAEffect FGAEffectHandle::GetEffect() const { return GetEffectRef(); }
 
-FGAEffect FGAEffectHandle::GetEffect() { return *EffectPtr.Get(); }
-FGAEffect FGAEffectHandle::GetEffect() const { return *EffectPtr.Get(); }
-
-FGAEffect& FGAEffectHandle::GetEffectRef() { return EffectPtr.ToSharedRef().Get(); }
-FGAEffect& FGAEffectHandle::GetEffectRef() const { return EffectPtr.ToSharedRef().Get(); };
+FGAEffect& FGAEffectHandle::GetEffectRef() { return const_cast<const FGAEffectHandle*>(this)->GetEffectRef(); }
+FGAEffect& FGAEffectHandle::GetEffectRef() const
+{
+	FGAEffect* Effect = FGAEffectPool::Get().Find(*this);
+	checkf(Effect, TEXT("FGAEffectHandle: Stale handle %d:%u"), Index, Generation);
+	return *Effect;
+}
 
-TSharedPtr<FGAEffect> FGAEffectHandle::GetEffectPtr() { return EffectPtr; };
-TSharedPtr<FGAEffect> FGAEffectHandle::GetEffectPtr() const { return EffectPtr; };
+FGAEffect* FGAEffectHandle::GetEffectPtr() { return const_cast<const FGAEffectHandle*>(this)->GetEffectPtr(); };
+FGAEffect* FGAEffectHandle::GetEffectPtr() const
+{
+	//handles can outlive module, when objects holding them are destroyed on exit.
+	const FGAEffectPool* Pool = FGAEffectPool::GetIfStarted();
+	return Pool ? Pool->Find(*this) : nullptr;
+}
 
-void FGAEffectHandle::SetContext(const FGAEffectContext& ContextIn) { EffectPtr->SetContext(ContextIn); }
-void FGAEffectHandle::SetContext(const FGAEffectContext& ContextIn) const { EffectPtr->SetContext(ContextIn); }
+void FGAEffectHandle::SetContext(const FGAEffectContext& ContextIn) { GetEffectRef().SetContext(ContextIn); }
+void FGAEffectHandle::SetContext(const FGAEffectContext& ContextIn) const { GetEffectRef().SetContext(ContextIn); }
 
-FGAEffectContext& FGAEffectHandle::GetContext() { return EffectPtr->Context; }
-FGAEffectContext& FGAEffectHandle::GetContext() const { return EffectPtr->Context; }
+FGAEffectContext& FGAEffectHandle::GetContext() { return GetEffectRef().Context; }
+FGAEffectContext& FGAEffectHandle::GetContext() const { return GetEffectRef().Context; }
 /* Executes effect trough provided execution class. */
 
-FGAEffectHandle FGAEffectHandle::GenerateHandle(FGAEffect* EffectIn)
+FGAEffectHandle FGAEffectHandle::GenerateHandle(class UGAGameEffectSpec* SpecIn, const FGAEffectContext& ContextIn)
 {
-	static uint32 Handle;
-	Handle++;
-	return FGAEffectHandle(Handle, EffectIn);
+	return FGAEffectPool::Get().Allocate(SpecIn, ContextIn);
 }
 void FGAEffectHandle::AppendOwnedTags(const FGameplayTagContainer& TagsIn)
 {
-	GetEffectPtr()->OwnedTags.AppendTags(TagsIn);
+	GetEffectRef().OwnedTags.AppendTags(TagsIn);
 }
 void FGAEffectHandle::AppendOwnedTags(const FGameplayTagContainer& TagsIn) const
 {
-	GetEffectPtr()->OwnedTags.AppendTags(TagsIn);
+	GetEffectRef().OwnedTags.AppendTags(TagsIn);
 }
 void FGAEffectHandle::ExecuteEffect(FGAEffectHandle& HandleIn, FGAEffectMod& ModIn, FGAEffectContext& Context)
 {
@@ -57,19 +63,19 @@ void FGAEffectHandle::ExecuteEffect(FGAEffectHandle& HandleIn, FGAEffectMod& Mod
 }
 bool FGAEffectHandle::HasAllTags(const FGameplayTagContainer& TagsIn) const
 {
-	return EffectPtr->OwnedTags.HasAll(TagsIn);
+	return GetEffectRef().OwnedTags.HasAll(TagsIn);
 }
 bool FGAEffectHandle::HasAllTagsExact(const FGameplayTagContainer& TagsIn) const
 {
-	return EffectPtr->OwnedTags.HasAllExact(TagsIn);
+	return GetEffectRef().OwnedTags.HasAllExact(TagsIn);
 }
 FGameplayTagContainer& FGAEffectHandle::GetOwnedTags() const
 {
-	return EffectPtr->OwnedTags;
+	return GetEffectRef().OwnedTags;
 }
 FGAEffectMod FGAEffectHandle::GetAttributeModifier() const
 {
-	return EffectPtr->GetAttributeModifier();
+	return GetEffectRef().GetAttributeModifier();
 }
 
 FGAAttribute FGAEffectHandle::GetAttribute() const
@@ -82,24 +88,67 @@ EGAAttributeMod FGAEffectHandle::GetAttributeMod() const
 }
 void FGAEffectHandle::Reset()
 {
-	Handle = 0;
-	EffectPtr.Reset();
+	Index = INDEX_NONE;
+	Generation = 0;
+}
+static TMap<FName, int32>& GetAttributeNameIndices()
+{
+	static TMap<FName, int32> AttributeNameIndices;
+	return AttributeNameIndices;
+}
+int32 FGAAttribute::RegisterAttributeName(const FName& NameIn)
+{
+	if (NameIn.IsNone())
+		return INDEX_NONE;
+
+	TMap<FName, int32>& Indices = GetAttributeNameIndices();
+	const int32* Index = Indices.Find(NameIn);
+	if (Index)
+	{
+		return *Index;
+	}
+	return Indices.Add(NameIn, Indices.Num());
+}
+FName FGAAttribute::GetAttributeNameByIndex(int32 IndexIn)
+{
+	for (const TPair<FName, int32>& Pair : GetAttributeNameIndices())
+	{
+		if (Pair.Value == IndexIn)
+		{
+			return Pair.Key;
+		}
+	}
+	return NAME_None;
+}
+int32 FGAAttribute::GetAttributeIndex() const
+{
+	//name can be changed trough editor after index has been cached.
+	if (AttributeIndex == INDEX_NONE || IndexedName != AttributeName)
+	{
+		AttributeIndex = RegisterAttributeName(AttributeName);
+		IndexedName = AttributeName;
+	}
+	return AttributeIndex;
 }
 FGAHashedGameplayTagContainer::FGAHashedGameplayTagContainer(const FGameplayTagContainer& TagsIn)
-	: Tags(TagsIn)
+	: Tags(TagsIn),
+	Hash(0)
 {
-	GenerateFNameKey();
+	GenerateHash();
 }
-void FGAHashedGameplayTagContainer::GenerateFNameKey()
+void FGAHashedGameplayTagContainer::GenerateHash()
 {
-	FString RetString;
-	for (const FGameplayTag& tag : Tags)
+	Hash = GetTagsHash(Tags);
+}
+uint32 FGAHashedGameplayTagContainer::GetTagsHash(const FGameplayTagContainer& TagsIn)
+{
+	//summed, so the same tags in different order give the same hash.
+	uint32 TagsHash = 0;
+	for (const FGameplayTag& tag : TagsIn)
 	{
-		RetString += TEXT(".");
-		RetString += tag.ToString();
-		RetString += TEXT(".");
+		TagsHash += ::GetTypeHash(tag.GetTagName());
 	}
-	Key = *RetString;
+	return TagsHash;
 }
 
 void FGAEffectContext::Reset()
@@ -165,109 +214,223 @@ FGAEffectContext::~FGAEffectContext()
 	InstigatorComp.Reset();
 }
 
-void FGACountedTagContainer::AddTag(const FGameplayTag& TagIn)
+static TMap<FName, int32>& GetTagIndices()
 {
-	int32& count = CountedTags.FindOrAdd(TagIn);
-	//if (count)
-	//{
-	//	*count += 1;
-	//	return;
-	//}
-	count++;
-	//CountedTags.Add(TagIn, 1);
-	AllTags.AddTag(TagIn);
+	static TMap<FName, int32> TagIndices;
+	return TagIndices;
 }
-void FGACountedTagContainer::AddTagContainer(const FGameplayTagContainer& TagsIn)
+/* For every tag index, index of tag itself followed by indices of all it's parents. */
+static TArray<TArray<int32>>& GetTagParentIndices()
 {
-	for (auto TagIt = TagsIn.CreateConstIterator(); TagIt; ++TagIt)
+	static TArray<TArray<int32>> TagParentIndices;
+	return TagParentIndices;
+}
+int32 FGACountedTagContainer::GetTagIndex(const FGameplayTag& TagIn)
+{
+	if (!TagIn.IsValid())
+		return INDEX_NONE;
+
+	const FName TagName = TagIn.GetTagName();
+	const int32* Index = GetTagIndices().Find(TagName);
+	if (Index)
 	{
-		int32* count = CountedTags.Find(*TagIt);
-		if (count)
-		{
-			*count += 1;
-		}
-		else
+		return *Index;
+	}
+	const int32 NewIndex = GetTagIndices().Add(TagName, GetTagIndices().Num());
+	GetTagParentIndices().AddDefaulted();
+	TArray<int32> Chain;
+	Chain.Add(NewIndex);
+	//registering parents adds to arrays, don't hold references trough it.
+	FGameplayTagContainer Parents = TagIn.GetGameplayTagParents();
+	for (const FGameplayTag& Parent : Parents)
+	{
+		if (Parent != TagIn)
 		{
-			CountedTags.Add(*TagIt, 1);
-			AllTags.AddTag(*TagIt);
+			Chain.Add(GetTagIndex(Parent));
 		}
 	}
+	GetTagParentIndices()[NewIndex] = Chain;
+	return NewIndex;
 }
-void FGACountedTagContainer::RemoveTag(const FGameplayTag& TagIn)
+
+void FGATagMask::SetBit(int32 IndexIn)
 {
-	int32* count = CountedTags.Find(TagIn);
-	if (count)
+	if (IndexIn == INDEX_NONE)
+		return;
+	const int32 Word = IndexIn / 64;
+	if (Words.Num() <= Word)
 	{
-		*count -= 1;
-		if (*count <= 0)
-		{
-			CountedTags.Remove(TagIn);
-			AllTags.RemoveTag(TagIn);
-		}
+		Words.AddZeroed(Word + 1 - Words.Num());
 	}
+	Words[Word] |= (uint64)1 << (IndexIn % 64);
 }
-void FGACountedTagContainer::RemoveTagContainer(const FGameplayTagContainer& TagsIn)
+FGATagMask FGATagMask::Make(const FGameplayTagContainer& TagsIn)
 {
-	for (auto TagIt = TagsIn.CreateConstIterator(); TagIt; ++TagIt)
+	FGATagMask Mask;
+	for (const FGameplayTag& Tag : TagsIn)
+	{
+		Mask.SetBit(FGACountedTagContainer::GetTagIndex(Tag));
+	}
+	return Mask;
+}
+
+void FGACountedTagContainer::AddTagIndex(int32 IndexIn)
+{
+	if (ExplicitCounts.Num() <= IndexIn)
+	{
+		ExplicitCounts.AddZeroed(IndexIn + 1 - ExplicitCounts.Num());
+		ExplicitBits.AddZeroed(IndexIn / 64 + 1 - ExplicitBits.Num());
+	}
+	if (ExplicitCounts[IndexIn]++ > 0)
 	{
-		int32* count = CountedTags.Find(*TagIt);
-		if (count)
+		return;
+	}
+	ExplicitBits[IndexIn / 64] |= (uint64)1 << (IndexIn % 64);
+	for (int32 Index : GetTagParentIndices()[IndexIn])
+	{
+		if (MatchCounts.Num() <= Index)
+		{
+			MatchCounts.AddZeroed(Index + 1 - MatchCounts.Num());
+			MatchBits.AddZeroed(Index / 64 + 1 - MatchBits.Num());
+		}
+		if (MatchCounts[Index]++ == 0)
 		{
-			*count -= 1;
+			MatchBits[Index / 64] |= (uint64)1 << (Index % 64);
 		}
-		if (*count <= 0)
+	}
+	Generation++;
+}
+void FGACountedTagContainer::RemoveTagIndex(int32 IndexIn)
+{
+	if (!ExplicitCounts.IsValidIndex(IndexIn) || ExplicitCounts[IndexIn] <= 0)
+	{
+		return;
+	}
+	if (--ExplicitCounts[IndexIn] > 0)
+	{
+		return;
+	}
+	ExplicitBits[IndexIn / 64] &= ~((uint64)1 << (IndexIn % 64));
+	for (int32 Index : GetTagParentIndices()[IndexIn])
+	{
+		if (--MatchCounts[Index] == 0)
 		{
-			CountedTags.Remove(*TagIt);
-			AllTags.RemoveTag(*TagIt);
+			MatchBits[Index / 64] &= ~((uint64)1 << (Index % 64));
 		}
 	}
+	Generation++;
 }
-bool FGACountedTagContainer::HasTag(const FGameplayTag& TagIn)
+void FGACountedTagContainer::AddTag(const FGameplayTag& TagIn)
 {
-	return AllTags.HasTag(TagIn);
+	const int32 Index = GetTagIndex(TagIn);
+	if (Index == INDEX_NONE)
+		return;
+
+	AddTagIndex(Index);
+	if (ExplicitCounts[Index] == 1)
+	{
+		AllTags.AddTag(TagIn);
+	}
 }
-bool FGACountedTagContainer::HasTagExact(const FGameplayTag TagIn)
+void FGACountedTagContainer::AddTagContainer(const FGameplayTagContainer& TagsIn)
+{
+	for (const FGameplayTag& Tag : TagsIn)
+	{
+		AddTag(Tag);
+	}
+}
+void FGACountedTagContainer::RemoveTag(const FGameplayTag& TagIn)
 {
-	return AllTags.HasTagExact(TagIn);
+	const int32 Index = GetTagIndex(TagIn);
+	if (!ExplicitCounts.IsValidIndex(Index) || ExplicitCounts[Index] <= 0)
+		return;
+
+	RemoveTagIndex(Index);
+	if (ExplicitCounts[Index] == 0)
+	{
+		AllTags.RemoveTag(TagIn);
+	}
 }
-bool FGACountedTagContainer::HasAny(const FGameplayTagContainer& TagsIn)
+void FGACountedTagContainer::RemoveTagContainer(const FGameplayTagContainer& TagsIn)
 {
-	return AllTags.HasAny(TagsIn);
+	for (const FGameplayTag& Tag : TagsIn)
+	{
+		RemoveTag(Tag);
+	}
 }
-bool FGACountedTagContainer::HasAnyExact(const FGameplayTagContainer& TagsIn)
+bool FGACountedTagContainer::HasBit(const TArray<uint64>& BitsIn, int32 IndexIn)
 {
-	return AllTags.HasAnyExact(TagsIn);
+	if (IndexIn == INDEX_NONE)
+		return false;
+	const int32 Word = IndexIn / 64;
+	return BitsIn.IsValidIndex(Word) && (BitsIn[Word] & ((uint64)1 << (IndexIn % 64))) != 0;
 }
-bool FGACountedTagContainer::HasAll(const FGameplayTagContainer& TagsIn)
+bool FGACountedTagContainer::HasAnyBits(const TArray<uint64>& BitsIn, const FGATagMask& MaskIn)
 {
-	return AllTags.HasAll(TagsIn);
+	const int32 NumWords = FMath::Min(BitsIn.Num(), MaskIn.Words.Num());
+	for (int32 Word = 0; Word < NumWords; Word++)
+	{
+		if (BitsIn[Word] & MaskIn.Words[Word])
+		{
+			return true;
+		}
+	}
+	return false;
 }
-bool FGACountedTagContainer::HasAllExact(const FGameplayTagContainer& TagsIn)
+bool FGACountedTagContainer::HasAllBits(const TArray<uint64>& BitsIn, const FGATagMask& MaskIn)
 {
-	return AllTags.HasAllExact(TagsIn);
+	for (int32 Word = 0; Word < MaskIn.Words.Num(); Word++)
+	{
+		const uint64 Bits = BitsIn.IsValidIndex(Word) ? BitsIn[Word] : 0;
+		if ((Bits & MaskIn.Words[Word]) != MaskIn.Words[Word])
+		{
+			return false;
+		}
+	}
+	return true;
 }
 
 bool FGACountedTagContainer::HasTag(const FGameplayTag& TagIn) const
 {
-	return AllTags.HasTag(TagIn);
+	return HasBit(MatchBits, GetTagIndex(TagIn));
 }
 bool FGACountedTagContainer::HasTagExact(const FGameplayTag TagIn) const
 {
-	return AllTags.HasTagExact(TagIn);
+	return HasBit(ExplicitBits, GetTagIndex(TagIn));
 }
 bool FGACountedTagContainer::HasAny(const FGameplayTagContainer& TagsIn) const
 {
-	return AllTags.HasAny(TagsIn);
+	for (const FGameplayTag& Tag : TagsIn)
+	{
+		if (HasBit(MatchBits, GetTagIndex(Tag)))
+			return true;
+	}
+	return false;
 }
 bool FGACountedTagContainer::HasAnyExact(const FGameplayTagContainer& TagsIn) const
 {
-	return AllTags.HasAnyExact(TagsIn);
+	for (const FGameplayTag& Tag : TagsIn)
+	{
+		if (HasBit(ExplicitBits, GetTagIndex(Tag)))
+			return true;
+	}
+	return false;
 }
 bool FGACountedTagContainer::HasAll(const FGameplayTagContainer& TagsIn) const
 {
-	return AllTags.HasAll(TagsIn);
+	for (const FGameplayTag& Tag : TagsIn)
+	{
+		if (!HasBit(MatchBits, GetTagIndex(Tag)))
+			return false;
+	}
+	return true;
 }
 bool FGACountedTagContainer::HasAllExact(const FGameplayTagContainer& TagsIn) const
 {
-	return AllTags.HasAllExact(TagsIn);
+	for (const FGameplayTag& Tag : TagsIn)
+	{
+		if (!HasBit(ExplicitBits, GetTagIndex(Tag)))
+			return false;
+	}
+	return true;
 }
\ No newline at end of file
@@ -259,21 +259,26 @@ class UGAGameEffectSpec;
 struct FGAEffectMod;
 struct FGAAttribute;
 
+/*
+	Handle to effect stored in FGAEffectPool.
+	It's just slot index and generation of that slot, so it's cheap to copy and it does not
+	keep effect alive. When effect is released, generation of slot is bumped and every handle still
+	pointing to it, becomes invalid.
+*/
 USTRUCT(BlueprintType)
 struct GAMEABILITIES_API FGAEffectHandle
 {
 	GENERATED_USTRUCT_BODY()
 protected:
-	//just to be safe we don't run out of numbers..
+	/* Index of slot in FGAEffectPool. */
 	UPROPERTY()
-		uint32 Handle; //Fname Guid ?
-
-	TSharedPtr<FGAEffect> EffectPtr;
+		int32 Index;
+	/* Generation of slot at the time handle has been created. 0 is never valid generation. */
+	UPROPERTY()
+		uint32 Generation;
 public:
-	inline bool IsValid() const
-	{
-		return (Handle != INDEX_NONE) && EffectPtr.IsValid();
-	}
+	/* Checks if effect this handle points to is still alive. */
+	bool IsValid() const;
 
 	FGAEffectContext& GetContextRef();
 	FGAEffectContext& GetContextRef() const;
@@ -281,7 +286,8 @@ public:
 	UGAGameEffectSpec* GetEffectSpec();
 	UGAGameEffectSpec* GetEffectSpec() const;
 
-	uint32 GetHandle() const;
+	inline int32 GetIndex() const { return Index; }
+	inline uint32 GetGeneration() const { return Generation; }
 
 	FGAEffect GetEffect();
 	FGAEffect GetEffect() const;
@@ -289,8 +295,9 @@ public:
 	FGAEffect& GetEffectRef();
 	FGAEffect& GetEffectRef() const;
 
-	TSharedPtr<FGAEffect> GetEffectPtr();
-	TSharedPtr<FGAEffect> GetEffectPtr() const;
+	/* Returns nullptr, if handle is stale. */
+	FGAEffect* GetEffectPtr();
+	FGAEffect* GetEffectPtr() const;
 
 	void SetContext(const FGAEffectContext& ContextIn);
 	void SetContext(const FGAEffectContext& ContextIn) const;
@@ -305,35 +312,35 @@ public:
 	struct FGAEffectMod GetAttributeModifier() const;
 	FGAAttribute GetAttribute() const;
 	EGAAttributeMod GetAttributeMod() const;
-	static FGAEffectHandle GenerateHandle(FGAEffect* EffectIn);
+	/* Creates new effect in FGAEffectPool and returns handle to it. */
+	static FGAEffectHandle GenerateHandle(class UGAGameEffectSpec* SpecIn, const FGAEffectContext& ContextIn);
 	bool HasAllTags(const FGameplayTagContainer& TagsIn) const;
 	bool HasAllTagsExact(const FGameplayTagContainer& TagsIn) const;
 	FGameplayTagContainer& GetOwnedTags() const;
 	bool operator==(const FGAEffectHandle& Other) const
 	{
-		return Handle == Other.Handle;
+		return Index == Other.Index && Generation == Other.Generation;
 	}
 	bool operator!=(const FGAEffectHandle& Other) const
 	{
-		return Handle != Other.Handle;
+		return Index != Other.Index || Generation != Other.Generation;
 	}
 	void Reset();
 	friend uint32 GetTypeHash(const FGAEffectHandle& InHandle)
 	{
-		return InHandle.Handle;
+		return HashCombine(::GetTypeHash(InHandle.Index), InHandle.Generation);
 	}
 
 	FGAEffectHandle()
-		: Handle(INDEX_NONE)
+		: Index(INDEX_NONE),
+		Generation(0)
 	{}
 
-	FGAEffectHandle(uint32 HandleIn, FGAEffect* EffectIn)
-		: Handle(HandleIn),
-		EffectPtr(EffectIn)
+	FGAEffectHandle(int32 IndexIn, uint32 GenerationIn)
+		: Index(IndexIn),
+		Generation(GenerationIn)
 	{
 	}
-public:
-	~FGAEffectHandle();
 };
 DECLARE_MULTICAST_DELEGATE(FGAGenericDelegate);
 
@@ -372,7 +379,7 @@ struct GAMEABILITIES_API EnumToString
 
 /*
 	Special struct, which allows to use FGameplayTagContainer as key, for TSet and TMap.
-	Bear in mind slower inserts/remove, but allow for complex keys.
+	Hash is combined from tag names, and does not depend on order of tags in container.
 */
 struct GAMEABILITIES_API FGAHashedGameplayTagContainer
 {
@@ -380,17 +387,31 @@ public:
 	FGameplayTagContainer Tags;
 
 private:
-	FName Key;
-	void GenerateFNameKey();
+	uint32 Hash;
+	void GenerateHash();
 
 public:
 	FGAHashedGameplayTagContainer()
+		: Hash(0)
 	{};
 	FGAHashedGameplayTagContainer(const FGameplayTagContainer& TagsIn);
 
+	inline bool operator==(const FGAHashedGameplayTagContainer& Other) const
+	{
+		return Hash == Other.Hash && Tags.Num() == Other.Tags.Num()
+			&& Tags.HasAllExact(Other.Tags);
+	}
+	/* Allows looking up map by plain container with FindByHash, without copying it into key. */
+	inline bool operator==(const FGameplayTagContainer& OtherTags) const
+	{
+		return Tags.Num() == OtherTags.Num() && Tags.HasAllExact(OtherTags);
+	}
+	/* Hash, which key made from TagsIn would have. */
+	static uint32 GetTagsHash(const FGameplayTagContainer& TagsIn);
+
 	friend uint32 GetTypeHash(const FGAHashedGameplayTagContainer& InHandle)
 	{
-		return ::GetTypeHash(InHandle.Key);
+		return InHandle.Hash;
 	}
 };
 
@@ -472,12 +493,24 @@ public:
 	{
 		return AttributeName.ToString();
 	}
+	/*
+		Dense index of AttributeName, shared by all attribute set classes.
+		Resolved once and cached, so attribute sets can find attribute
+		by simple array lookup, instead of searching fields by name.
+	*/
+	int32 GetAttributeIndex() const;
+	/* Returns dense index for name, registers new one if name was not seen before. */
+	static int32 RegisterAttributeName(const FName& NameIn);
+	/* Reverse of RegisterAttributeName. Slow, meant for tools. */
+	static FName GetAttributeNameByIndex(int32 IndexIn);
 
 	FGAAttribute()
+		: AttributeIndex(INDEX_NONE)
 	{
 		AttributeName = NAME_None;
 	};
 	FGAAttribute(const FName& AttributeNameIn)
+		: AttributeIndex(INDEX_NONE)
 	{
 		AttributeName = AttributeNameIn;
 	};
@@ -489,6 +522,10 @@ public:
 	//{
 	//	AttributeName = *AttributeNameIn;
 	//};
+private:
+	/* Cached result of GetAttributeIndex() and name for which it has been resolved. */
+	mutable int32 AttributeIndex;
+	mutable FName IndexedName;
 };
 /* Final calculcated mod from effect, which can be modified by Calculation object. */
 struct FGAEffectMod
@@ -698,26 +735,55 @@ public:
 };
 
 
+/*
+	Set of gameplay tags as bits, indexed by FGACountedTagContainer::GetTagIndex().
+	Build it once from tags which are queried often (required, blocking tags etc.),
+	so query against FGACountedTagContainer is just few word compares.
+*/
+struct GAMEABILITIES_API FGATagMask
+{
+	TArray<uint64, TInlineAllocator<2>> Words;
+
+	void SetBit(int32 IndexIn);
+	inline bool IsEmpty() const { return Words.Num() == 0; }
+	void Reset() { Words.Reset(); }
+
+	static FGATagMask Make(const FGameplayTagContainer& TagsIn);
+};
+
+/*
+	Counted set of tags. Every tag is counted separately, and is removed only when
+	it has been removed as many times as it has been added.
+
+	Tags are kept in two bitsets indexed by dense tag index. One with explicitly added tags and one
+	which also contains all parents of added tags, so HasTag(A) is true when A.B has been added,
+	same as with FGameplayTagContainer. Queries are bit tests, or word wide AND loops for FGATagMask.
+*/
 USTRUCT()
 struct GAMEABILITIES_API FGACountedTagContainer
 {
 	GENERATED_USTRUCT_BODY()
 protected:
-	/*
-	Here we will store counted GamaplayTags.
-	If tag is already in map, we just incremement count.
-	*/
-	TMap<FGameplayTag, int32> CountedTags;
+	/* Count of explicitly added tags. */
+	TArray<int32> ExplicitCounts;
+	/* Count of added tags, which are this tag or it's children. */
+	TArray<int32> MatchCounts;
+	TArray<uint64> ExplicitBits;
+	TArray<uint64> MatchBits;
+	/* Bumped every time tag is added to or removed from set (not when just count changes). */
+	uint32 Generation;
 
 	/*
 	Here we store all currently posesd tags.
-	It is equivalent of CountedTags, except this does not track count of tags, but we need it
-	to have something against which we can perform queries.
+	It is equivalent of ExplicitBits, we need it for interfaces which want FGameplayTagContainer.
 	*/
 public:
 	UPROPERTY()
 		FGameplayTagContainer AllTags;
 public:
+	FGACountedTagContainer()
+		: Generation(0)
+	{}
 
 	inline FGameplayTagContainer GetTags() { return AllTags; };
 
@@ -726,13 +792,6 @@ public:
 	void RemoveTag(const FGameplayTag& TagIn);
 	void RemoveTagContainer(const FGameplayTagContainer& TagsIn);
 
-	bool HasTag(const FGameplayTag& TagIn);
-	bool HasTagExact(const FGameplayTag TagIn);
-	bool HasAny(const FGameplayTagContainer& TagsIn);
-	bool HasAnyExact(const FGameplayTagContainer& TagsIn);
-	bool HasAll(const FGameplayTagContainer& TagsIn);
-	bool HasAllExact(const FGameplayTagContainer& TagsIn);
-	
 	bool HasTag(const FGameplayTag& TagIn) const;
 	bool HasTagExact(const FGameplayTag TagIn) const;
 	bool HasAny(const FGameplayTagContainer& TagsIn) const;
@@ -740,6 +799,11 @@ public:
 	bool HasAll(const FGameplayTagContainer& TagsIn) const;
 	bool HasAllExact(const FGameplayTagContainer& TagsIn) const;
 
+	inline bool HasAny(const FGATagMask& MaskIn) const { return HasAnyBits(MatchBits, MaskIn); }
+	inline bool HasAnyExact(const FGATagMask& MaskIn) const { return HasAnyBits(ExplicitBits, MaskIn); }
+	inline bool HasAll(const FGATagMask& MaskIn) const { return HasAllBits(MatchBits, MaskIn); }
+	inline bool HasAllExact(const FGATagMask& MaskIn) const { return HasAllBits(ExplicitBits, MaskIn); }
+
 	inline FGameplayTagContainer& GetAllTags()
 	{
 		return AllTags;
@@ -747,8 +811,24 @@ public:
 
 	inline int32 GetTagCount(const FGameplayTag& TagIn) const
 	{
-		return CountedTags.FindRef(TagIn);
+		const int32 Index = GetTagIndex(TagIn);
+		return ExplicitCounts.IsValidIndex(Index) ? ExplicitCounts[Index] : 0;
 	}
+	inline uint32 GetGeneration() const { return Generation; }
+	/* Cheap check if cached result of queries against this container is still valid. */
+	inline bool HasChangedSince(uint32 GenerationIn) const { return Generation != GenerationIn; }
+
+	/*
+		Dense index of tag, shared by all containers. Registers tag (and it's parents) on first use.
+		Game thread only.
+	*/
+	static int32 GetTagIndex(const FGameplayTag& TagIn);
+protected:
+	void AddTagIndex(int32 IndexIn);
+	void RemoveTagIndex(int32 IndexIn);
+	static bool HasBit(const TArray<uint64>& BitsIn, int32 IndexIn);
+	static bool HasAnyBits(const TArray<uint64>& BitsIn, const FGATagMask& MaskIn);
+	static bool HasAllBits(const TArray<uint64>& BitsIn, const FGATagMask& MaskIn);
 };
 
 
@@ -783,4 +863,39 @@ public:
 		EffectCauser(EffectCauserIn)
 	{};
 	//bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
-};
\ No newline at end of file
+};
+
+/*
+	Compact cue event. Gathered by FGAEffectCueBatcher during server frame,
+	and sent in single batch to every connection, which can see it.
+*/
+USTRUCT()
+struct GAMEABILITIES_API FGAEffectCueEvent
+{
+	GENERATED_USTRUCT_BODY()
+public:
+	/* Component, which applied effect. Cue is played trough it, or trough target if it's not relevant. */
+	UPROPERTY()
+		TWeakObjectPtr<class UGAAbilitiesComponent> SourceComp;
+	UPROPERTY()
+		TSubclassOf<class UGAGameEffectSpec> SpecClass;
+	/* Actor hit by effect. Cue is culled, if target is not relevant for connection. */
+	UPROPERTY()
+		TWeakObjectPtr<AActor> Target;
+	UPROPERTY()
+		TWeakObjectPtr<AActor> Instigator;
+	UPROPERTY()
+		TWeakObjectPtr<AActor> EffectCauser;
+	UPROPERTY()
+		FVector_NetQuantize Location;
+	UPROPERTY()
+		FVector_NetQuantizeNormal Normal;
+	/* EffectTag of spec. Cues are rate limited per tag on server, it's never sent. */
+	UPROPERTY(NotReplicated)
+		FGameplayTag CueTag;
+
+	FGAEffectCueEvent()
+		: Location(ForceInitToZero),
+		Normal(ForceInitToZero)
+	{};
+};
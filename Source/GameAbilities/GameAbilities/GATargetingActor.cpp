@@ -7,8 +7,7 @@
 // Sets default values
 AGATargetingActor::AGATargetingActor()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 
 }
 
@@ -19,10 +18,4 @@ void AGATargetingActor::BeginPlay()
 	
 }
 
-// Called every frame
-void AGATargetingActor::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-}
 
@@ -17,8 +17,6 @@ public:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
 
 	
 	
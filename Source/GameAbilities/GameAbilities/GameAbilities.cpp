@@ -2,6 +2,11 @@
 #pragma once
 #include "GameAbilities.h"
 #include "IGameAbilities.h"
+#include "GAAttributesBase.h"
+#include "GAGameEffect.h"
+#include "GACombatTrace.h"
+#include "GAEffectCueBatcher.h"
+#include "AbilityCues/GACueActorPool.h"
 DEFINE_LOG_CATEGORY(GameAbilities);
 DEFINE_LOG_CATEGORY(GameAttributesGeneral);
 DEFINE_LOG_CATEGORY(GameAttributes);
@@ -20,6 +25,11 @@ IMPLEMENT_MODULE( FGameAbilities, GameAbilities )
 void FGameAbilities::StartupModule()
 {
 	// This code will execute after your module is loaded into memory (but after global variables are initialized, of course.)
+	FGAAttributeTable::Startup();
+	FGAEffectPool::Startup();
+	FGACombatTrace::Startup();
+	FGAEffectCueBatcher::Startup();
+	FGACueActorPool::Startup();
 }
 
 
@@ -27,6 +37,11 @@ void FGameAbilities::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FGACueActorPool::Shutdown();
+	FGAEffectCueBatcher::Shutdown();
+	FGACombatTrace::Shutdown();
+	FGAEffectPool::Shutdown();
+	FGAAttributeTable::Shutdown();
 }
 
 
@@ -2,30 +2,37 @@
 
 #include "GameAbilities.h"
 #include "../GAAbilityBase.h"
+#include "GTAsyncTraceService.h"
 #include "GASAbilityTargetingObject.h"
 
 FHitResult UGASAbilityTargetingObject::GetTarget()
 {
-	FHitResult HitOut;
 	APlayerController* PC = AbilityOwner->PCOwner;
 	APawn* P = AbilityOwner->POwner;
 	FVector TraceStart = PC->PlayerCameraManager->GetCameraLocation(); // P->GetPawnViewLocation();
 	FRotator UnusedRot = P->GetBaseAimRotation();
 	PC->GetActorEyesViewPoint(TraceStart, UnusedRot);
 	FVector TraceEnd = UnusedRot.Vector() * Range + TraceStart;
-	UWorld* World = GetWorld();
-	FCollisionQueryParams ColParams;
-	ColParams.AddIgnoredActor(P);
-	FCollisionResponseParams ColResp;
-	
-	World->LineTraceSingleByChannel(HitOut, TraceStart, TraceEnd, ECollisionChannel::ECC_WorldStatic, ColParams, ColResp);
-	if (HitOut.bBlockingHit)
+
+	FGTTraceRequest Request;
+	Request.Start = TraceStart;
+	Request.End = TraceEnd;
+	Request.Channel = ECollisionChannel::ECC_WorldStatic;
+	Request.IgnoredActor = P;
+	FGTAsyncTraceService::RequestLineTrace(GetWorld(), Request,
+		FGTTraceResultDelegate::CreateUObject(this, &UGASAbilityTargetingObject::OnTargetTraceDone));
+
+	return LastTarget;
+}
+
+void UGASAbilityTargetingObject::OnTargetTraceDone(const FHitResult& HitIn)
+{
+	LastTarget = HitIn;
+	if (HitIn.bBlockingHit)
 	{
-		DrawDebugLine(GetWorld(), TraceStart, HitOut.ImpactPoint, FColor::Red, true, 4);
+		DrawDebugLine(GetWorld(), HitIn.TraceStart, HitIn.ImpactPoint, FColor::Red, true, 4);
 	}
-	DrawDebugLine(GetWorld(), TraceStart, TraceEnd, FColor::Green, true, 4);
-
-	return HitOut;
+	DrawDebugLine(GetWorld(), HitIn.TraceStart, HitIn.TraceEnd, FColor::Green, true, 4);
 }
 
 class UWorld* UGASAbilityTargetingObject::GetWorld() const
@@ -21,7 +21,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ExposeOnSpawn = "true"), Category = "Config")
 		float Range;
 	
+	/*
+		Requests asynchronous trace from camera. Returns target from last finished trace,
+		new one is available next frame.
+	*/
 	virtual FHitResult GetTarget();
 
 	virtual class UWorld* GetWorld() const;
+protected:
+	FHitResult LastTarget;
+	void OnTargetTraceDone(const FHitResult& HitIn);
 };
@@ -2,6 +2,7 @@
 
 #include "../GameAbilities.h"
 #include "AutomationTest.h"
+#include "EngineUtils.h"
 #include "GameplayTagsModule.h"
 #include "../GAGlobalTypes.h"
 #include "../GAAttributeBase.h"
@@ -9,6 +10,11 @@
 #include "../GAAbilitiesComponent.h"
 #include "../GAAttributesBase.h"
 #include "../GAEffectExecution.h"
+#include "../GACombatTrace.h"
+#include "../GAEffectCueBatcher.h"
+#include "../GAEffectCue.h"
+#include "../AbilityCues/GACueActor.h"
+#include "../AbilityCues/GACueActorPool.h"
 #include "../Effects/GABlueprintLibrary.h"
 #include "GAAttributesTest.h"
 #include "GASpellExecutionTest.h"
@@ -64,8 +70,26 @@ static UDataTable* CreateGameplayDataTable()
 	return DataTable;
 };
 
+static UWorld* CreateTestWorld()
+{
+	UWorld *World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext &WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	FURL URL;
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+	return World;
+}
+static void DestroyTestWorld(UWorld* World)
+{
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+}
+
 class GameEffectsTestSuite
 {
+protected:
 	UWorld* World;
 	FAutomationTestBase* Test;
 
@@ -80,49 +104,37 @@ public:
 		: World(WorldIn),
 		Test(TestIn)
 	{
-		SourceActor = World->SpawnActor<AGACharacterAttributeTest>();
+		SourceActor = SpawnAttributeActor();
 		SourceComponent = SourceActor->Attributes;
-		SourceComponent->DefaultAttributes = NewObject<UGAAttributesTest>(SourceActor->Attributes);
-		SourceComponent->GetAttributes<UGAAttributesTest>()->Health.SetBaseValue(100);
-		SourceComponent->GetAttributes<UGAAttributesTest>()->Energy.SetBaseValue(100);
-		SourceComponent->GetAttributes<UGAAttributesTest>()->Stamina.SetBaseValue(100);
-		SourceComponent->GetAttributes<UGAAttributesTest>()->Health.SetClampValue(500);
-		SourceComponent->GetAttributes<UGAAttributesTest>()->Energy.SetClampValue(500);
-		SourceComponent->GetAttributes<UGAAttributesTest>()->Stamina.SetClampValue(500);
-		
-		SourceComponent->GetAttributes<UGAAttributesTest>()->MagicalBonus.SetClampValue(500);
-		SourceComponent->GetAttributes<UGAAttributesTest>()->PhysicalBonus.SetClampValue(500);
-		SourceComponent->GetAttributes<UGAAttributesTest>()->MagicResistance.SetClampValue(500);
-
-		SourceComponent->GetAttributes<UGAAttributesTest>()->Health.InitializeAttribute();
-		SourceComponent->GetAttributes<UGAAttributesTest>()->Energy.InitializeAttribute();
-		SourceComponent->GetAttributes<UGAAttributesTest>()->Stamina.InitializeAttribute();
 
-		SourceComponent->GetAttributes<UGAAttributesTest>()->MagicalBonus.InitializeAttribute();
-		SourceComponent->GetAttributes<UGAAttributesTest>()->PhysicalBonus.InitializeAttribute();
-		SourceComponent->GetAttributes<UGAAttributesTest>()->MagicResistance.InitializeAttribute();
-
-		DestActor = World->SpawnActor<AGACharacterAttributeTest>();
+		DestActor = SpawnAttributeActor();
 		DestComponent = DestActor->Attributes;
-		DestComponent->DefaultAttributes = NewObject<UGAAttributesTest>(SourceActor->Attributes);
-		DestComponent->GetAttributes<UGAAttributesTest>()->Health.SetBaseValue(100);
-		DestComponent->GetAttributes<UGAAttributesTest>()->Energy.SetBaseValue(100);
-		DestComponent->GetAttributes<UGAAttributesTest>()->Stamina.SetBaseValue(100);
-		DestComponent->GetAttributes<UGAAttributesTest>()->Health.SetClampValue(500);
-		DestComponent->GetAttributes<UGAAttributesTest>()->Energy.SetClampValue(500);
-		DestComponent->GetAttributes<UGAAttributesTest>()->Stamina.SetClampValue(500);
-
-		DestComponent->GetAttributes<UGAAttributesTest>()->MagicalBonus.SetClampValue(500);
-		DestComponent->GetAttributes<UGAAttributesTest>()->PhysicalBonus.SetClampValue(500);
-		DestComponent->GetAttributes<UGAAttributesTest>()->MagicResistance.SetClampValue(500);
-
-		DestComponent->GetAttributes<UGAAttributesTest>()->Health.InitializeAttribute();
-		DestComponent->GetAttributes<UGAAttributesTest>()->Energy.InitializeAttribute();
-		DestComponent->GetAttributes<UGAAttributesTest>()->Stamina.InitializeAttribute();
-
-		DestComponent->GetAttributes<UGAAttributesTest>()->MagicalBonus.InitializeAttribute();
-		DestComponent->GetAttributes<UGAAttributesTest>()->PhysicalBonus.InitializeAttribute();
-		DestComponent->GetAttributes<UGAAttributesTest>()->MagicResistance.InitializeAttribute();
+	}
+	AGACharacterAttributeTest* SpawnAttributeActor()
+	{
+		AGACharacterAttributeTest* Actor = World->SpawnActor<AGACharacterAttributeTest>();
+		UGAAbilitiesComponent* Component = Actor->Attributes;
+		Component->DefaultAttributes = NewObject<UGAAttributesTest>(Actor->Attributes);
+		UGAAttributesTest* Attributes = Component->GetAttributes<UGAAttributesTest>();
+		Attributes->Health.SetBaseValue(100);
+		Attributes->Energy.SetBaseValue(100);
+		Attributes->Stamina.SetBaseValue(100);
+		Attributes->Health.SetClampValue(500);
+		Attributes->Energy.SetClampValue(500);
+		Attributes->Stamina.SetClampValue(500);
+
+		Attributes->MagicalBonus.SetClampValue(500);
+		Attributes->PhysicalBonus.SetClampValue(500);
+		Attributes->MagicResistance.SetClampValue(500);
+
+		Attributes->Health.InitializeAttribute();
+		Attributes->Energy.InitializeAttribute();
+		Attributes->Stamina.InitializeAttribute();
+
+		Attributes->MagicalBonus.InitializeAttribute();
+		Attributes->PhysicalBonus.InitializeAttribute();
+		Attributes->MagicResistance.InitializeAttribute();
+		return Actor;
 	}
 
 	~GameEffectsTestSuite()
@@ -267,6 +279,17 @@ public:
 		float value = SourceComponent->GetAttributes<UGAAttributesTest>()->Health.GetFinalValue();
 		TestEqual(TEXT("Attribute Base Value"), value, 100);
 	}
+	void Test_AttributeTableLookup()
+	{
+		UGAAttributesTest* Attributes = DestComponent->GetAttributes<UGAAttributesTest>();
+		FGAAttribute Health(TEXT("Health"));
+		FGAAttribute MagicResistance(TEXT("MagicResistance"));
+		Test->TestTrue(TEXT("Health found by index"), Attributes->GetAttribute(Health) == &Attributes->Health);
+		Test->TestTrue(TEXT("MagicResistance found by index"), Attributes->GetAttribute(MagicResistance) == &Attributes->MagicResistance);
+		//second lookup goes trough cached index.
+		Test->TestTrue(TEXT("Health found by cached index"), Attributes->GetAttribute(Health) == &Attributes->Health);
+		Test->TestTrue(TEXT("Missing attribute"), Attributes->GetAttribute(FGAAttribute(TEXT("NotAnAttribute"))) == nullptr);
+	}
 	void Test_ApplySimpleEffect()
 	{
 		FGAEffectSpec Spec;
@@ -652,6 +675,470 @@ public:
 		bool HaveTag1 = DestComponent->AppliedTags.HasAll(Tags);
 	}
 
+	void Test_IncrementalBonus()
+	{
+		const float PeriodSecs = 1.0f;
+		TArray<FName> OwnedTags1;
+		OwnedTags1.Add(TEXT("Damage.Fire"));
+		FGAEffectSpec Spec = CreateEffectDurationSpec(OwnedTags1, 10, EGAAttributeMod::Add
+			, TEXT("MagicalBonus"), EGAEffectStacking::Add);
+		FGAEffectHandle Handle;
+		Handle = UGABlueprintLibrary::ApplyGameEffectToActor(Spec, Handle, DestActor, SourceActor, SourceActor);
+
+		FGAEffectSpec Spec2 = CreateEffectDurationSpec(OwnedTags1, 4, EGAAttributeMod::Subtract
+			, TEXT("MagicalBonus"), EGAEffectStacking::Add);
+		FGAEffectHandle Handle2;
+		Handle2 = UGABlueprintLibrary::ApplyGameEffectToActor(Spec2, Handle2, DestActor, SourceActor, SourceActor);
+
+		UGAAttributesTest* Attributes = DestComponent->GetAttributes<UGAAttributesTest>();
+		TestEqual(TEXT("MagicalBonus Final Value:"), Attributes->MagicalBonus.GetFinalValue(), 6);
+		Test->TestTrue(TEXT("Bonus sums consistent after add"), Attributes->MagicalBonus.IsBonusConsistent());
+
+		DestComponent->RemoveEffect(Handle2);
+		TestEqual(TEXT("MagicalBonus Final Value after remove:"), Attributes->MagicalBonus.GetFinalValue(), 10);
+		Test->TestTrue(TEXT("Bonus sums consistent after remove"), Attributes->MagicalBonus.IsBonusConsistent());
+
+		// advance time past duration, so remaining effect expire.
+		for (int32 i = 0; i < 11; ++i)
+		{
+			TickWorld(PeriodSecs);
+		}
+		TestEqual(TEXT("MagicalBonus Final Value after expire:"), Attributes->MagicalBonus.GetFinalValue(), 0);
+		Test->TestTrue(TEXT("Bonus sums consistent after expire"), Attributes->MagicalBonus.IsBonusConsistent());
+	}
+
+	void Test_BonusByTagsCache()
+	{
+		TArray<FName> OwnedTags1;
+		OwnedTags1.Add(TEXT("Damage.Fire"));
+		OwnedTags1.Add(TEXT("Damage.Ice"));
+		FGAEffectSpec Spec = CreateEffectDurationSpec(OwnedTags1, 10, EGAAttributeMod::Add
+			, TEXT("MagicalBonus"), EGAEffectStacking::Add);
+		FGAEffectHandle Handle;
+		Handle = UGABlueprintLibrary::ApplyGameEffectToActor(Spec, Handle, DestActor, SourceActor, SourceActor);
+
+		UGAAttributesTest* Attributes = DestComponent->GetAttributes<UGAAttributesTest>();
+		TArray<FName> QueryTags;
+		QueryTags.Add(TEXT("Damage.Fire"));
+		FGameplayTagContainer TagTest = CreateTags(QueryTags);
+		FGAIndividualMods ModsOut;
+		TestEqual(TEXT("Damage.Fire Bonus:"), Attributes->MagicalBonus.GetBonusValueByTags(TagTest, ModsOut), 10);
+		//second query is served from cache.
+		TestEqual(TEXT("Damage.Fire Cached Bonus:"), Attributes->MagicalBonus.GetBonusValueByTags(TagTest, ModsOut), 10);
+
+		TArray<FName> OwnedTags2;
+		OwnedTags2.Add(TEXT("Damage.Fire"));
+		FGAEffectSpec Spec2 = CreateEffectDurationSpec(OwnedTags2, 5, EGAAttributeMod::Add
+			, TEXT("MagicalBonus"), EGAEffectStacking::Add);
+		FGAEffectHandle Handle2;
+		Handle2 = UGABlueprintLibrary::ApplyGameEffectToActor(Spec2, Handle2, DestActor, SourceActor, SourceActor);
+		TestEqual(TEXT("Damage.Fire Bonus after add:"), Attributes->MagicalBonus.GetBonusValueByTags(TagTest, ModsOut), 15);
+
+		DestComponent->RemoveEffect(Handle);
+		TestEqual(TEXT("Damage.Fire Bonus after remove:"), Attributes->MagicalBonus.GetBonusValueByTags(TagTest, ModsOut), 5);
+	}
+
+	void Test_EffectHandleGeneration()
+	{
+		TArray<FName> OwnedTags1;
+		OwnedTags1.Add(TEXT("Damage.Fire"));
+		FGAEffectSpec Spec = CreateEffectDurationSpec(OwnedTags1, 10, EGAAttributeMod::Add
+			, TEXT("MagicalBonus"), EGAEffectStacking::Add);
+		FGAEffectHandle Handle;
+		Handle = UGABlueprintLibrary::ApplyGameEffectToActor(Spec, Handle, DestActor, SourceActor, SourceActor);
+		Test->TestTrue(TEXT("Applied duration effect handle is valid"), Handle.IsValid());
+
+		FGAEffectHandle OldHandle = Handle;
+		DestComponent->RemoveEffect(Handle);
+		Test->TestTrue(TEXT("Removed effect handle is stale"), !OldHandle.IsValid());
+		//removing again, must be noop.
+		DestComponent->RemoveEffect(OldHandle);
+
+		FGAEffectHandle Handle2;
+		Handle2 = UGABlueprintLibrary::ApplyGameEffectToActor(Spec, Handle2, DestActor, SourceActor, SourceActor);
+		Test->TestTrue(TEXT("Released slot is reused"), Handle2.GetIndex() == OldHandle.GetIndex());
+		Test->TestTrue(TEXT("Reused slot have new generation"), Handle2 != OldHandle && !OldHandle.IsValid());
+		Test->TestTrue(TEXT("Pool finds effect by live handle only"), FGAEffectPool::Get().Find(Handle2) != nullptr
+			&& FGAEffectPool::Get().Find(OldHandle) == nullptr && FGAEffectPool::Get().Find(FGAEffectHandle()) == nullptr);
+
+		FGAEffectSpec InstantSpec = CreateEffectSpec(OwnedTags1, 5, EGAAttributeMod::Subtract, TEXT("Health"));
+		FGAEffectHandle InstantHandle;
+		InstantHandle = UGABlueprintLibrary::ApplyGameEffectToActor(InstantSpec, InstantHandle, DestActor, SourceActor, SourceActor);
+		Test->TestTrue(TEXT("Instant effect is released after application"), !InstantHandle.IsValid());
+		DestComponent->RemoveEffect(Handle2);
+	}
+
+	void Test_EffectTimingWheel()
+	{
+		FGAEffectTimingWheel Wheel;
+		FGAEffectHandle Handle;
+		FGAEffectTimerHandle Period = Wheel.Schedule(Handle, EGAEffectTimerType::Period, 0, 1);
+		FGAEffectTimerHandle Duration = Wheel.Schedule(Handle, EGAEffectTimerType::Duration, 3);
+		FGAEffectTimerHandle Long = Wheel.Schedule(Handle, EGAEffectTimerType::Duration, 200);
+
+		int32 Periods = 0;
+		int32 Expired = 0;
+		FGAEffectTimerEvent Event;
+		for (int32 Step = 0; Step <= 300; Step++)
+		{
+			Wheel.AdvanceTo(Step * 0.01);
+			while (Wheel.PopDue(Event))
+			{
+				if (Event.Type == EGAEffectTimerType::Duration)
+				{
+					Expired++;
+					Wheel.Cancel(Period);
+				}
+				else
+				{
+					Periods++;
+				}
+			}
+		}
+		//fires at 0, 1 and 2. At 3 duration goes first and cancels period.
+		Test->TestTrue(TEXT("Period fired before expiration"), Periods == 3 && Expired == 1);
+		Test->TestTrue(TEXT("Fired timers are removed"), !Wheel.IsActive(Duration) && !Wheel.IsActive(Period));
+
+		//extend long timer, it must not fire at old time.
+		Wheel.Reschedule(Long, 500);
+		Wheel.AdvanceTo(250);
+		Test->TestTrue(TEXT("Rescheduled timer does not fire at old time"), !Wheel.PopDue(Event));
+		Test->TestTrue(TEXT("Rescheduled timer remaining time"), FMath::IsNearlyEqual(Wheel.GetRemaining(Long), 253.f, 0.1f));
+		Wheel.AdvanceTo(503.1);
+		Test->TestTrue(TEXT("Rescheduled timer fires"), Wheel.PopDue(Event) && Wheel.IsEmpty());
+		Test->TestTrue(TEXT("Empty wheel does not need advance"), Wheel.GetNextAdvanceTime() < 0);
+
+		//advance only when wheel asks for it, like one shot timer in effect container does.
+		const double StartTime = Wheel.GetTime();
+		Wheel.Schedule(Handle, EGAEffectTimerType::Duration, 0.5f);
+		Wheel.Schedule(Handle, EGAEffectTimerType::Duration, 90);
+		TArray<double> FireTimes;
+		int32 Advances = 0;
+		while (!Wheel.IsEmpty() && Advances < 100)
+		{
+			Wheel.AdvanceTo(Wheel.GetNextAdvanceTime());
+			Advances++;
+			while (Wheel.PopDue(Event))
+			{
+				FireTimes.Add(Wheel.GetTime() - StartTime);
+			}
+		}
+		Test->TestTrue(TEXT("Wheel is advanced few times, not every tick"), Advances < 10);
+		Test->TestTrue(TEXT("Timers fire on time when advanced on demand"), FireTimes.Num() == 2
+			&& FireTimes[0] >= 0.5 && FireTimes[0] <= 0.5 + FGAEffectTimingWheel::Resolution
+			&& FireTimes[1] >= 90 && FireTimes[1] <= 90 + FGAEffectTimingWheel::Resolution);
+	}
+
+	void Test_ApplyEffectToTargets()
+	{
+		TArray<FName> OwnedTags1;
+		OwnedTags1.Add(TEXT("Damage.Fire"));
+		FGAEffectSpec Spec = CreateEffectSpec(OwnedTags1, 10, EGAAttributeMod::Subtract, TEXT("Health"));
+
+		TArray<FHitResult> Hits;
+		FHitResult Hit(ForceInit);
+		Hit.Actor = DestActor;
+		Hits.Add(Hit);
+		Hits.Add(Hit);
+		//hit without target, only plays cue.
+		Hits.Add(FHitResult(ForceInit));
+
+		UGAAttributesTest* Attributes = DestComponent->GetAttributes<UGAAttributesTest>();
+		//same effect applied trough single target path, for reference.
+		float HealthBefore = Attributes->Health.GetCurrentValue();
+		FGAEffectHandle Handle;
+		UGABlueprintLibrary::ApplyGameEffectToActor(Spec, Handle, DestActor, SourceActor, SourceActor);
+		float SingleDamage = HealthBefore - Attributes->Health.GetCurrentValue();
+
+		HealthBefore = Attributes->Health.GetCurrentValue();
+		TArray<FGAEffectHandle> Handles = SourceComponent->ApplyEffectToTargets(Spec, Hits, SourceActor, SourceActor);
+		float BatchDamage = HealthBefore - Attributes->Health.GetCurrentValue();
+		Test->TestTrue(TEXT("Every hit with target applied effect"), SingleDamage > 0 && BatchDamage == SingleDamage * 2);
+		Test->TestTrue(TEXT("Instant effects are not returned"), Handles.Num() == 0);
+	}
+
+	void Test_MagnitudeEvaluator()
+	{
+		FGAMagnitude Magnitude;
+		Magnitude.CalculationType = EGAMagnitudeCalculation::AttributeBased;
+		Magnitude.AttributeBased.Source = EGAAttributeSource::Instigator;
+		Magnitude.AttributeBased.Attribute = FGAAttribute("Health");
+		Magnitude.AttributeBased.Coefficient = 2;
+		Magnitude.AttributeBased.PostMultiply = 5;
+
+		FGAEffectContext Context = UGAAbilitiesComponent::MakeActorContext(DestActor, SourceActor, SourceActor);
+		float Health = SourceComponent->GetAttributes<UGAAttributesTest>()->Health.GetFinalValue();
+
+		FGAMagnitudeEvaluator Evaluator;
+		Evaluator.Compile(Magnitude);
+		Test->TestTrue(TEXT("Attribute based magnitude"), Evaluator.Evaluate(Context, FGAEffectHandle()) == Health * 2 + 5);
+
+		//summed magnitude from instigator and target.
+		FGAAttributeBasedModifier TargetMod = Magnitude.AttributeBased;
+		TargetMod.Source = EGAAttributeSource::Target;
+		Magnitude.CalculationType = EGAMagnitudeCalculation::SummedAttributeBased;
+		Magnitude.SummedAttributeBased.AttributeBased.Add(Magnitude.AttributeBased);
+		Magnitude.SummedAttributeBased.AttributeBased.Add(TargetMod);
+		float TargetHealth = DestComponent->GetAttributes<UGAAttributesTest>()->Health.GetFinalValue();
+		Evaluator.Compile(Magnitude);
+		Test->TestTrue(TEXT("Summed magnitude"), Evaluator.Evaluate(Context, FGAEffectHandle()) == (Health * 2 + 5) + (TargetHealth * 2 + 5));
+		Test->TestTrue(TEXT("Evaluator is the same as magnitude"), Evaluator.Evaluate(Context, FGAEffectHandle()) == Magnitude.GetFloatValue(Context));
+
+		//magnitude keeps compiled evaluator, until it's compiled again.
+		Magnitude.SummedAttributeBased.AttributeBased.RemoveAt(1);
+		Magnitude.Compile();
+		Test->TestTrue(TEXT("Recompiled magnitude"), Magnitude.GetFloatValue(Context) == Health * 2 + 5);
+	}
+
+	void Test_ActiveEffectStore()
+	{
+		TArray<FName> OwnedTags1;
+		OwnedTags1.Add(TEXT("Damage.Fire"));
+		FGAEffectSpec Spec = CreateEffectDurationSpec(OwnedTags1, 10, EGAAttributeMod::Add
+			, TEXT("MagicalBonus"), EGAEffectStacking::Add);
+		const FGAActiveEffectStore& Store = DestComponent->GameEffectContainer.ActiveEffects;
+		const int32 NumBefore = Store.Num();
+
+		TArray<FGAEffectHandle> Handles;
+		for (int32 Idx = 0; Idx < 3; Idx++)
+		{
+			FGAEffectHandle Handle;
+			Handles.Add(UGABlueprintLibrary::ApplyGameEffectToActor(Spec, Handle, DestActor, SourceActor, SourceActor));
+		}
+		const TArray<int32>* Rows = Store.GetRowsByAttribute(FGAAttribute("MagicalBonus"));
+		Test->TestTrue(TEXT("Effects are indexed by attribute"), Store.Num() == NumBefore + 3 && Rows && Rows->Num() == 3);
+
+		//removing middle effect moves last row in it's place.
+		DestComponent->RemoveEffect(Handles[1]);
+		Rows = Store.GetRowsByAttribute(FGAAttribute("MagicalBonus"));
+		Test->TestTrue(TEXT("Removed effect is not in store"), !Store.Contains(Handles[1]) && Rows && Rows->Num() == 2);
+		Test->TestTrue(TEXT("Moved effect can be found"), Store.Contains(Handles[0]) && Store.Contains(Handles[2]));
+		const TArray<int32>* SpecRows = Store.GetRowsBySpec(Spec.Spec->GetFName());
+		Test->TestTrue(TEXT("Spec index points to moved row"), SpecRows && SpecRows->Num() == 2
+			&& Store.GetHandle((*SpecRows)[0]) != Store.GetHandle((*SpecRows)[1]));
+
+		DestComponent->RemoveEffect(Handles[0]);
+		DestComponent->RemoveEffect(Handles[2]);
+		Test->TestTrue(TEXT("Attribute index is empty"), Store.GetRowsByAttribute(FGAAttribute("MagicalBonus")) == nullptr
+			&& Store.Num() == NumBefore);
+	}
+
+	void Test_EffectReplicationInfo()
+	{
+		TArray<FName> OwnedTags1;
+		OwnedTags1.Add(TEXT("Damage.Fire"));
+		FGAEffectSpec Spec = CreateEffectDurationSpec(OwnedTags1, 10, EGAAttributeMod::Add
+			, TEXT("MagicalBonus"), EGAEffectStacking::Duration);
+		const TArray<FGAEffectRepInfo>& Infos = DestComponent->GameEffectContainer.ActiveEffectInfos;
+		const int32 NumBefore = Infos.Num();
+
+		FGAEffectHandle Handle;
+		FGAEffectHandle Applied = UGABlueprintLibrary::ApplyGameEffectToActor(Spec, Handle, DestActor, SourceActor, SourceActor);
+		Test->TestTrue(TEXT("Applied effect is replicated"), Infos.Num() == NumBefore + 1
+			&& Infos.Last().Handle == Applied && Infos.Last().StackCount == 1);
+
+		//extending effect updates existing info, instead of adding new one.
+		UGABlueprintLibrary::ApplyGameEffectToActor(Spec, Handle, DestActor, SourceActor, SourceActor);
+		Test->TestTrue(TEXT("Extended effect is stacked"), Infos.Num() == NumBefore + 1
+			&& Infos.Last().StackCount == 2);
+		Test->TestTrue(TEXT("Extending effect is released"), FGAEffectPool::Get().Num() == 1);
+
+		DestComponent->RemoveEffect(Applied);
+		Test->TestTrue(TEXT("Removed effect is not replicated"), Infos.Num() == NumBefore);
+		Test->TestTrue(TEXT("Pool is empty after effect is removed"), FGAEffectPool::Get().Num() == 0);
+	}
+
+	void Test_EffectCueBatcher()
+	{
+		const FGameplayTag FireTag = RequestTag(TEXT("Damage.Fire"));
+		const int32 MaxPerTag = IConsoleManager::Get().FindConsoleVariable(TEXT("GA.CueBatch.MaxPerTag"))->GetInt();
+		const float CullDistance = IConsoleManager::Get().FindConsoleVariable(TEXT("GA.CueBatch.CullDistance"))->GetFloat();
+		TArray<FGAEffectCueEvent> Cues;
+		//one more than limit, furthest one should be dropped.
+		for (int32 Idx = 0; Idx <= MaxPerTag; Idx++)
+		{
+			FGAEffectCueEvent& Cue = Cues[Cues.AddDefaulted()];
+			Cue.Location = FVector(100.0f * (MaxPerTag - Idx), 0, 0);
+			Cue.CueTag = FireTag;
+		}
+		FGAEffectCueEvent& FarCue = Cues[Cues.AddDefaulted()];
+		FarCue.Location = FVector(CullDistance * 2, 0, 0);
+
+		FGACueViewer Viewer;
+		TArray<FGAEffectCueEvent> Sent;
+		int32 Culled = FGAEffectCueBatcher::FilterForViewer(Cues, Viewer, 0, Sent);
+		Test->TestTrue(TEXT("Far and over limit cues are culled"), Culled == 2 && Sent.Num() == MaxPerTag);
+		Test->TestTrue(TEXT("Closest cues are sent first"), Sent.Num() > 0
+			&& Sent[0].Location.X == 0 && Sent.Last().Location.X < 100.0f * MaxPerTag);
+
+		Sent.Reset();
+		FGAEffectCueBatcher::FilterForViewer(Cues, Viewer, 0.5f, Sent);
+		Test->TestTrue(TEXT("Limit holds for whole second"), Sent.Num() == 0);
+		FGAEffectCueBatcher::FilterForViewer(Cues, Viewer, 1.0f, Sent);
+		Test->TestTrue(TEXT("Limit resets after second"), Sent.Num() == MaxPerTag);
+
+		//there is no one to send cues to in standalone, they are played right away.
+		TArray<FName> OwnedTags1;
+		OwnedTags1.Add(TEXT("Damage.Fire"));
+		FGAEffectSpec Spec = CreateEffectSpec(OwnedTags1, 10, EGAAttributeMod::Subtract, TEXT("Health"));
+		FGAEffectHandle Handle;
+		UGABlueprintLibrary::ApplyGameEffectToActor(Spec, Handle, DestActor, SourceActor, SourceActor);
+		Test->TestTrue(TEXT("Standalone cues are not queued"), FGAEffectCueBatcher::GetNumPending(DestActor->GetWorld()) == 0);
+	}
+
+	void Test_AttributeNetDeltaSerialize()
+	{
+		FGAAttributeBase Source(300);
+		Source.SetClampValue(300);
+		Source.CurrentValue = 123.456f;
+
+		TSharedPtr<INetDeltaBaseState> FullState;
+		FNetBitWriter FullWriter(nullptr, 1024);
+		FNetDeltaSerializeInfo WriteParms;
+		WriteParms.Writer = &FullWriter;
+		WriteParms.NewState = &FullState;
+		Test->TestTrue(TEXT("Initial state is written"), Source.NetDeltaSerialize(WriteParms));
+
+		FGAAttributeBase Dest;
+		FNetBitReader FullReader(nullptr, FullWriter.GetData(), FullWriter.GetNumBits());
+		FNetDeltaSerializeInfo ReadParms;
+		ReadParms.Reader = &FullReader;
+		Dest.NetDeltaSerialize(ReadParms);
+		Test->TestTrue(TEXT("Values are quantized to hundredths"), Dest.BaseValue == 300 && Dest.ClampValue == 300
+			&& FMath::IsNearlyEqual(Dest.CurrentValue, 123.46f, 0.001f));
+
+		//only current value changed.
+		Source.CurrentValue = 100;
+		TSharedPtr<INetDeltaBaseState> DeltaState;
+		FNetBitWriter DeltaWriter(nullptr, 1024);
+		WriteParms.Writer = &DeltaWriter;
+		WriteParms.NewState = &DeltaState;
+		WriteParms.OldState = FullState.Get();
+		Test->TestTrue(TEXT("Changed value is written"), Source.NetDeltaSerialize(WriteParms)
+			&& DeltaWriter.GetNumBits() < FullWriter.GetNumBits());
+
+		FNetBitReader DeltaReader(nullptr, DeltaWriter.GetData(), DeltaWriter.GetNumBits());
+		ReadParms.Reader = &DeltaReader;
+		Dest.NetDeltaSerialize(ReadParms);
+		Test->TestTrue(TEXT("Delta is applied"), Dest.CurrentValue == 100 && Dest.BaseValue == 300);
+
+		//change below quantization step is not sent.
+		Source.CurrentValue = 100.001f;
+		TSharedPtr<INetDeltaBaseState> SameState;
+		FNetBitWriter SameWriter(nullptr, 1024);
+		WriteParms.Writer = &SameWriter;
+		WriteParms.NewState = &SameState;
+		WriteParms.OldState = DeltaState.Get();
+		Test->TestTrue(TEXT("Unchanged attribute is not sent"), !Source.NetDeltaSerialize(WriteParms));
+
+		//too big for hundredths in int32, must not wrap around.
+		Source.CurrentValue = 1.0e9f;
+		TSharedPtr<INetDeltaBaseState> BigState;
+		FNetBitWriter BigWriter(nullptr, 1024);
+		WriteParms.Writer = &BigWriter;
+		WriteParms.NewState = &BigState;
+		Test->TestTrue(TEXT("Big value is written"), Source.NetDeltaSerialize(WriteParms));
+		FNetBitReader BigReader(nullptr, BigWriter.GetData(), BigWriter.GetNumBits());
+		ReadParms.Reader = &BigReader;
+		Dest.NetDeltaSerialize(ReadParms);
+		Test->TestTrue(TEXT("Big value is clamped"), Dest.CurrentValue > 2.0e7f && Dest.CurrentValue <= 2.2e7f);
+	}
+
+	void Test_CueActorPool()
+	{
+		UWorld* World = DestActor->GetWorld();
+		TSubclassOf<AGACueActor> CueClass = AGACueActor::StaticClass();
+		FGACueActorPool::Prewarm(World, CueClass, 2);
+		Test->TestTrue(TEXT("Pool is prewarmed"), FGACueActorPool::GetNumFree(World, CueClass) == 2);
+
+		AGACueActor* Cue = FGACueActorPool::Acquire(World, CueClass, FVector::ZeroVector, DestActor, nullptr);
+		Test->TestTrue(TEXT("Prewarmed actor is handed out"), Cue && FGACueActorPool::GetNumFree(World, CueClass) == 1
+			&& !Cue->bHidden && !Cue->IsActorTickEnabled() && Cue->GetOwner() == DestActor);
+
+		FGACueActorPool::Release(Cue);
+		Test->TestTrue(TEXT("Released actor is back in pool"), FGACueActorPool::GetNumFree(World, CueClass) == 2
+			&& Cue->bHidden && !Cue->IsPendingKill());
+		AGACueActor* Reused = FGACueActorPool::Acquire(World, CueClass, FVector::ZeroVector, DestActor, nullptr);
+		Test->TestTrue(TEXT("Actor is reused, not spawned"), Reused == Cue);
+		FGACueActorPool::Release(Reused);
+
+		//effect cues are taken from the same pool.
+		UGAGameEffectSpec* SpecCDO = GetMutableDefault<UGAGameEffectSpec>();
+		SpecCDO->EffectCue = AGAEffectCue::StaticClass();
+		FGAEffectCueParams CueParams(FHitResult(), SourceActor, SourceActor);
+		CueParams.HitResult.Actor = DestActor;
+		const int32 NumActive = FGACueActorPool::GetNumActive(World);
+		SourceComponent->ActiveCues.PlayCue(UGAGameEffectSpec::StaticClass(), CueParams);
+		AGAEffectCue* EffectCue = nullptr;
+		for (TActorIterator<AGAEffectCue> It(World); It; ++It)
+		{
+			EffectCue = *It;
+		}
+		Test->TestTrue(TEXT("Effect cue is taken from pool"), EffectCue && FGACueActorPool::GetNumActive(World) == NumActive + 1
+			&& EffectCue->GetOwner() == DestActor);
+		FGACueActorPool::Release(EffectCue);
+		Test->TestTrue(TEXT("Effect cue goes back to pool"), FGACueActorPool::GetNumFree(World, AGAEffectCue::StaticClass()) == 1);
+		SpecCDO->EffectCue = nullptr;
+	}
+
+	void Test_CombatTrace()
+	{
+		TArray<FName> OwnedTags1;
+		OwnedTags1.Add(TEXT("Damage.Fire"));
+		FGAEffectSpec Spec = CreateEffectSpec(OwnedTags1, 10, EGAAttributeMod::Subtract, TEXT("Health"));
+		//start from clean file.
+		FGACombatTrace::Close();
+		DestComponent->bCaptureCombatTrace = true;
+		FGAEffectHandle Handle;
+		UGABlueprintLibrary::ApplyGameEffectToActor(Spec, Handle, DestActor, SourceActor, SourceActor);
+		DestComponent->bCaptureCombatTrace = false;
+		//not captured.
+		UGABlueprintLibrary::ApplyGameEffectToActor(Spec, Handle, DestActor, SourceActor, SourceActor);
+
+		FGACombatTrace::Flush();
+		const FString TraceFile = FGACombatTrace::GetCurrentFile();
+		FGACombatTrace::Close();
+		const FString CSVFile = FPaths::ChangeExtension(TraceFile, TEXT("csv"));
+		//apply and modify.
+		Test->TestTrue(TEXT("Captured events are decoded"), FGACombatTrace::DecodeToCSV(TraceFile, CSVFile) == 2);
+		FString CSV;
+		FFileHelper::LoadFileToString(CSV, *CSVFile);
+		Test->TestTrue(TEXT("Decoded names of target and attribute"), CSV.Contains(DestActor->GetName()) && CSV.Contains(TEXT(",Health,")));
+		IFileManager::Get().Delete(*TraceFile);
+		IFileManager::Get().Delete(*CSVFile);
+	}
+
+	void Test_CountedTagContainer()
+	{
+		FGACountedTagContainer Counted;
+		FGameplayTag Fire = RequestTag(TEXT("Damage.Fire"));
+		TArray<FName> ParentTag;
+		ParentTag.Add(TEXT("Damage"));
+		TArray<FName> BothTags;
+		BothTags.Add(TEXT("Damage.Fire"));
+		BothTags.Add(TEXT("Damage.Ice"));
+		const FGATagMask ParentMask = FGATagMask::Make(CreateTags(ParentTag));
+		const FGATagMask BothMask = FGATagMask::Make(CreateTags(BothTags));
+
+		Counted.AddTag(Fire);
+		Counted.AddTag(Fire);
+		const uint32 Generation = Counted.GetGeneration();
+		Test->TestTrue(TEXT("Parent tag matches"), Counted.HasTag(RequestTag(TEXT("Damage"))) && Counted.HasAll(ParentMask));
+		Test->TestTrue(TEXT("Parent tag is not exact"), !Counted.HasTagExact(RequestTag(TEXT("Damage"))) && !Counted.HasAllExact(ParentMask));
+		Test->TestTrue(TEXT("Any, but not all"), Counted.HasAny(BothMask) && !Counted.HasAll(BothMask));
+		Test->TestTrue(TEXT("Same as container"), Counted.HasAll(CreateTags(ParentTag)) == Counted.AllTags.HasAll(CreateTags(ParentTag)));
+
+		Counted.RemoveTag(Fire);
+		Test->TestTrue(TEXT("Tag stays until removed as many times as added"), Counted.HasTagExact(Fire) && Counted.GetTagCount(Fire) == 1);
+		Test->TestTrue(TEXT("Count change is not tag change"), !Counted.HasChangedSince(Generation));
+		Counted.RemoveTag(Fire);
+		Test->TestTrue(TEXT("Parent removed with last child"), !Counted.HasTag(RequestTag(TEXT("Damage"))) && !Counted.HasAny(BothMask));
+		Test->TestTrue(TEXT("Tag change bumps generation"), Counted.HasChangedSince(Generation));
+		//removing tag which is not there must be noop.
+		Counted.RemoveTag(Fire);
+		Test->TestTrue(TEXT("Empty container"), Counted.AllTags.Num() == 0 && Counted.HasAll(FGATagMask()));
+	}
+
 	void Test_CompareTagContainers()
 	{
 		TArray<FName> TagsA;
@@ -786,6 +1273,164 @@ public:
 	}
 };
 
+/*
+	Stress benchmark for effects. Applies effects of every type, stacking and aggregation
+	to many actors, and reports time per apply, remove and world tick as json, so it can be
+	compared between changes.
+	Counts can be overriden from command line: -GABenchActors=1000 -GABenchEffects=10
+*/
+class GameEffectsBenchmarkSuite : public GameEffectsTestSuite
+{
+	TArray<AGACharacterAttributeTest*> Targets;
+	int32 NumEffects;
+	TArray<FString> Results;
+
+	static FString GetEnumValueName(const TCHAR* EnumName, int32 Value)
+	{
+		UEnum* Enum = FindObject<UEnum>(ANY_PACKAGE, EnumName);
+		if (Enum)
+		{
+			return Enum->GetEnumName(Value);
+		}
+		return FString::FromInt(Value);
+	}
+public:
+	GameEffectsBenchmarkSuite(UWorld* WorldIn, FAutomationTestBase* TestIn, int32 NumActorsIn, int32 NumEffectsIn)
+		: GameEffectsTestSuite(WorldIn, TestIn),
+		NumEffects(NumEffectsIn)
+	{
+		Targets.Reserve(NumActorsIn);
+		for (int32 Idx = 0; Idx < NumActorsIn; Idx++)
+		{
+			Targets.Add(SpawnAttributeActor());
+		}
+	}
+	~GameEffectsBenchmarkSuite()
+	{
+		for (AGACharacterAttributeTest* Target : Targets)
+		{
+			World->EditorDestroyActor(Target, false);
+		}
+	}
+
+	FGAEffectSpec CreateBenchmarkSpec(EGAEffectType TypeIn, EGAEffectStacking StackingIn, EGAEffectAggregation AggregationIn)
+	{
+		TArray<FName> OwnedTags;
+		OwnedTags.Add(TEXT("Damage.Fire"));
+		FGAEffectSpec Spec;
+		switch (TypeIn)
+		{
+		case EGAEffectType::Instant:
+			Spec = CreateEffectSpec(OwnedTags, 1, EGAAttributeMod::Subtract, TEXT("Health"));
+			break;
+		case EGAEffectType::Periodic:
+		{
+			Spec = CreateEffectDurationSpec(OwnedTags, 1, EGAAttributeMod::Subtract, TEXT("Health"), StackingIn);
+			Spec.Spec->EffectType = EGAEffectType::Periodic;
+			FGAMagnitude PeriodMag;
+			PeriodMag.CalculationType = EGAMagnitudeCalculation::Direct;
+			PeriodMag.DirectModifier.Value = 0.25f;
+			Spec.Spec->Period = PeriodMag;
+			break;
+		}
+		default:
+			Spec = CreateEffectDurationSpec(OwnedTags, 1, EGAAttributeMod::Add, TEXT("MagicalBonus"), StackingIn);
+			break;
+		}
+		Spec.Spec->EffectAggregation = AggregationIn;
+		return Spec;
+	}
+
+	void RunScenario(EGAEffectType TypeIn, EGAEffectStacking StackingIn, EGAEffectAggregation AggregationIn)
+	{
+		const int32 NumTicks = 60;
+		const float TickDelta = 1.f / 60.f;
+		FGAEffectSpec Spec = CreateBenchmarkSpec(TypeIn, StackingIn, AggregationIn);
+		TArray<FGAEffectHandle> Handles;
+		Handles.Reserve(Targets.Num() * NumEffects);
+
+		//used memory is sampled once per target and per tick, reading stats per effect would skew timings.
+		const uint64 MemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+		uint64 MemoryPeak = MemoryBefore;
+		double StartTime = FPlatformTime::Seconds();
+		for (AGACharacterAttributeTest* Target : Targets)
+		{
+			for (int32 Idx = 0; Idx < NumEffects; Idx++)
+			{
+				FGAEffectHandle Handle = UGABlueprintLibrary::ApplyGameEffectToActor(Spec, FGAEffectHandle(), Target, SourceActor, SourceActor);
+				if (Handle.IsValid())
+				{
+					Handles.Add(Handle);
+				}
+			}
+			MemoryPeak = FMath::Max<uint64>(MemoryPeak, FPlatformMemory::GetStats().UsedPhysical);
+		}
+		const double ApplyTime = FPlatformTime::Seconds() - StartTime;
+		const int32 NumApplies = Targets.Num() * NumEffects;
+		const int32 NumActive = FGAEffectPool::Get().Num();
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Idx = 0; Idx < NumTicks; Idx++)
+		{
+			World->Tick(ELevelTick::LEVELTICK_All, TickDelta);
+			GFrameCounter++;
+			MemoryPeak = FMath::Max<uint64>(MemoryPeak, FPlatformMemory::GetStats().UsedPhysical);
+		}
+		const double TickTime = FPlatformTime::Seconds() - StartTime;
+
+		int32 NumRemoved = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (FGAEffectHandle& Handle : Handles)
+		{
+			//overriden and expired effects are already gone.
+			if (Handle.IsValid())
+			{
+				Handle.GetContextRef().TargetComp->RemoveEffect(Handle);
+				NumRemoved++;
+			}
+		}
+		const double RemoveTime = FPlatformTime::Seconds() - StartTime;
+
+		FString Result = FString::Printf(TEXT("{\"type\":\"%s\",\"stacking\":\"%s\",\"aggregation\":\"%s\",")
+			TEXT("\"applies\":%d,\"apply_ns\":%.1f,\"active_effects\":%d,\"ticks\":%d,\"tick_ns\":%.1f,")
+			TEXT("\"removes\":%d,\"remove_ns\":%.1f,\"pool_capacity\":%d,\"peak_memory_kb\":%llu}"),
+			*GetEnumValueName(TEXT("EGAEffectType"), (int32)TypeIn),
+			*GetEnumValueName(TEXT("EGAEffectStacking"), (int32)StackingIn),
+			*GetEnumValueName(TEXT("EGAEffectAggregation"), (int32)AggregationIn),
+			NumApplies, NumApplies > 0 ? ApplyTime * 1e9 / NumApplies : 0.0,
+			NumActive, NumTicks, TickTime * 1e9 / NumTicks,
+			NumRemoved, NumRemoved > 0 ? RemoveTime * 1e9 / NumRemoved : 0.0,
+			FGAEffectPool::Get().GetCapacity(),
+			(MemoryPeak - MemoryBefore) / 1024);
+		UE_LOG(GameAttributes, Display, TEXT("GAEffectsBenchmark %s"), *Result);
+		Results.Add(Result);
+		Test->TestTrue(TEXT("All effects are released after benchmark"), FGAEffectPool::Get().Num() == 0);
+	}
+
+	void RunAll()
+	{
+		RunScenario(EGAEffectType::Instant, EGAEffectStacking::Add, EGAEffectAggregation::AggregateByTarget);
+		const EGAEffectType Types[] = { EGAEffectType::Duration, EGAEffectType::Periodic };
+		const EGAEffectAggregation Aggregations[] = { EGAEffectAggregation::AggregateByInstigator, EGAEffectAggregation::AggregateByTarget };
+		for (EGAEffectType Type : Types)
+		{
+			for (int32 Stacking = 0; Stacking < (int32)EGAEffectStacking::Invalid; Stacking++)
+			{
+				for (EGAEffectAggregation Aggregation : Aggregations)
+				{
+					RunScenario(Type, (EGAEffectStacking)Stacking, Aggregation);
+				}
+			}
+		}
+	}
+
+	FString GetJson() const
+	{
+		return FString::Printf(TEXT("{\"actors\":%d,\"effects_per_actor\":%d,\"results\":[\n%s\n]}\n"),
+			Targets.Num(), NumEffects, *FString::Join(Results, TEXT(",\n")));
+	}
+};
+
 #define ADD_TEST(Name) \
 	TestFunctions.Add(&GameEffectsTestSuite::Name); \
 	TestFunctionNames.Add(TEXT(#Name))
@@ -807,10 +1452,24 @@ public:
 		ADD_TEST(Test_PeriodicEffect);
 		ADD_TEST(Test_CompareTags);
 		ADD_TEST(Test_SetBaseValue);
+		ADD_TEST(Test_AttributeTableLookup);
 		ADD_TEST(Test_ApplySimpleEffect);
 		ADD_TEST(Test_GetBonusByTag);
 		ADD_TEST(Test_CheckIfStronger);
 		ADD_TEST(Test_OverrideStacking);
+		ADD_TEST(Test_IncrementalBonus);
+		ADD_TEST(Test_BonusByTagsCache);
+		ADD_TEST(Test_EffectHandleGeneration);
+		ADD_TEST(Test_EffectTimingWheel);
+		ADD_TEST(Test_ApplyEffectToTargets);
+		ADD_TEST(Test_MagnitudeEvaluator);
+		ADD_TEST(Test_ActiveEffectStore);
+		ADD_TEST(Test_EffectReplicationInfo);
+		ADD_TEST(Test_EffectCueBatcher);
+		ADD_TEST(Test_AttributeNetDeltaSerialize);
+		ADD_TEST(Test_CueActorPool);
+		ADD_TEST(Test_CombatTrace);
+		ADD_TEST(Test_CountedTagContainer);
 		ADD_TEST(Test_CompareTagContainers);
 		ADD_TEST(Test_CalculateSpellDamage);
 		ADD_TEST(Test_OverrideSimiliarTags);
@@ -820,7 +1479,7 @@ public:
 		//EAutomationTestFlags::Type::EditorContext | 
 		return (EAutomationTestFlags::Type::EngineFilter);
 	}//EAutomationTestFlags::EditorContext | EAutomationTestFlags::SmokeFilter; }
-	virtual bool IsStressTest() const { return false; }
+	virtual bool IsStressTest() const override { return false; }
 	virtual uint32 GetRequiredDeviceNum() const override { return 1; }
 
 	virtual FString GetBeautifiedTestName() const override { return TEXT("GameAttributes.Attributes"); }
@@ -860,13 +1519,7 @@ public:
 		//UGameplayTagsManager::Get().LoadGameplayTagTables();
 		UGameplayTagsManager::Get().ConstructGameplayTagTree();
 
-		UWorld *World = UWorld::CreateWorld(EWorldType::Game, false);
-		FWorldContext &WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
-		WorldContext.SetCurrentWorld(World);
-
-		FURL URL;
-		World->InitializeActorsForPlay(URL);
-		World->BeginPlay();
+		UWorld* World = CreateTestWorld();
 
 		// run the matching test
 		uint64 InitialFrameCounter = GFrameCounter;
@@ -876,8 +1529,7 @@ public:
 		}
 		GFrameCounter = InitialFrameCounter;
 
-		GEngine->DestroyWorldContext(World);
-		World->DestroyWorld(false);
+		DestroyTestWorld(World);
 		return true;
 	}
 };
@@ -887,4 +1539,56 @@ namespace
 	FGAAttributesTests FGAAttributesTestsAutomationTestInstance(TEXT("FGAAttributesTests"));
 }
 
+class FGAEffectsBenchmark : public FAutomationTestBase
+{
+public:
+	FGAEffectsBenchmark(const FString& InName)
+		: FAutomationTestBase(InName, false)
+	{}
+	virtual uint32 GetTestFlags() const override
+	{
+		return EAutomationTestFlags::Type::PerfFilter;
+	}
+	virtual bool IsStressTest() const override { return true; }
+	virtual uint32 GetRequiredDeviceNum() const override { return 1; }
+
+	virtual FString GetBeautifiedTestName() const override { return TEXT("GameAttributes.Benchmark"); }
+	virtual void GetTests(TArray<FString>& OutBeautifiedNames, TArray <FString>& OutTestCommands) const override
+	{
+		OutBeautifiedNames.Add(TEXT("EffectsStress"));
+		OutTestCommands.Add(FString());
+	}
+	bool RunTest(const FString& Parameters)
+	{
+		int32 NumActors = 100;
+		int32 NumEffects = 10;
+		FParse::Value(FCommandLine::Get(), TEXT("GABenchActors="), NumActors);
+		FParse::Value(FCommandLine::Get(), TEXT("GABenchEffects="), NumEffects);
+
+		UGameplayTagsManager::Get().DestroyGameplayTagTree();
+		UGameplayTagsManager::Get().ConstructGameplayTagTree();
+		UWorld* World = CreateTestWorld();
+
+		uint64 InitialFrameCounter = GFrameCounter;
+		FString Json;
+		{
+			GameEffectsBenchmarkSuite Benchmark(World, this, NumActors, NumEffects);
+			Benchmark.RunAll();
+			Json = Benchmark.GetJson();
+		}
+		GFrameCounter = InitialFrameCounter;
+		DestroyTestWorld(World);
+
+		const FString OutputFile = FPaths::Combine(*FPaths::AutomationDir(), TEXT("GAEffectsBenchmark.json"));
+		FFileHelper::SaveStringToFile(Json, *OutputFile);
+		UE_LOG(GameAttributes, Display, TEXT("GAEffectsBenchmark results written to %s"), *OutputFile);
+		return true;
+	}
+};
+
+namespace
+{
+	FGAEffectsBenchmark FGAEffectsBenchmarkAutomationTestInstance(TEXT("FGAEffectsBenchmark"));
+}
+
 #endif
\ No newline at end of file
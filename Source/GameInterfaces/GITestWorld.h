@@ -0,0 +1,52 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+#if WITH_EDITOR
+#include "AutomationTest.h"
+
+/* Flags of simple automation tests in game modules. */
+#define GI_TEST_FLAGS (EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+/*
+	Game world for single automation test. Created and begins play in constructor, destroyed
+	when it goes out of scope. Frames ticked trough it are not counted in GFrameCounter.
+*/
+class FGITestWorld
+{
+	UWorld* World;
+	uint64 InitialFrameCounter;
+
+public:
+	FGITestWorld()
+		: World(UWorld::CreateWorld(EWorldType::Game, false)),
+		InitialFrameCounter(GFrameCounter)
+	{
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		FURL URL;
+		World->InitializeActorsForPlay(URL);
+		World->BeginPlay();
+	}
+	~FGITestWorld()
+	{
+		GFrameCounter = InitialFrameCounter;
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	inline UWorld* Get() const { return World; }
+
+	/* Ticks world in fixed steps, until TimeIn passed. */
+	void Tick(float TimeIn, float StepIn = 0.01f)
+	{
+		while (TimeIn > 0.f)
+		{
+			World->Tick(ELevelTick::LEVELTICK_All, FMath::Min(TimeIn, StepIn));
+			TimeIn -= StepIn;
+			GFrameCounter++;
+		}
+	}
+};
+
+#endif
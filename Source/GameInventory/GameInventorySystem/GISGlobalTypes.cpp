@@ -95,4 +95,15 @@ void FGISSlotSwapInfo::TargetAddItem(const FGISSlotSwapInfo& SwapInfo) const
 void FGISSlotSwapInfo::TargetRemoveItem(const FGISSlotSwapInfo& SwapInfo) const
 {
 	TargetSlotComponent->GetInventoryWidget()->RemoveItem(SwapInfo);
-}
\ No newline at end of file
+}
+
+void FGISSlotEntry::PostReplicatedAdd(const struct FGISSlotEntryArray& InArraySerializer)
+{
+	if (InArraySerializer.InventoryComp.IsValid())
+		InArraySerializer.InventoryComp->OnSlotEntryReplicated(*this);
+}
+void FGISSlotEntry::PostReplicatedChange(const struct FGISSlotEntryArray& InArraySerializer)
+{
+	if (InArraySerializer.InventoryComp.IsValid())
+		InArraySerializer.InventoryComp->OnSlotEntryReplicated(*this);
+}
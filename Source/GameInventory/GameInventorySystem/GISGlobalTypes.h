@@ -116,6 +116,11 @@ public:
 	bool IsValid();
 };
 
+/*
+	Single item in loot window. SlotData is item owned by pickup actor, and is shared by everyone
+	looting it, it is copied only when it is actually taken.
+	Only index, id and item reference are replicated. Component and pickup are filled in on client.
+*/
 USTRUCT()
 struct GAMEINVENTORYSYSTEM_API FGISLootSlotInfo
 {
@@ -123,25 +128,32 @@ struct GAMEINVENTORYSYSTEM_API FGISLootSlotInfo
 public:
 	UPROPERTY(BlueprintReadOnly)
 		int32 SlotIndex;
+	/* Id of item in pickup actor. Stays the same, when other items are taken. */
 	UPROPERTY(BlueprintReadOnly)
-	class UGISItemData* SlotData;
+		int32 LootId;
 	UPROPERTY(BlueprintReadOnly)
+	class UGISItemData* SlotData;
+	UPROPERTY(BlueprintReadOnly, NotReplicated)
 		TWeakObjectPtr<class UGISInventoryBaseComponent> SlotComponent;
-	UPROPERTY(BlueprintReadOnly)
+	UPROPERTY(BlueprintReadOnly, NotReplicated)
 	class AGISPickupActor* OwningPickupActor;
 
 	void Reset()
 	{
 		SlotIndex = -1;
+		LootId = INDEX_NONE;
 		SlotData = nullptr;
 		SlotComponent.Reset();
 		OwningPickupActor = nullptr;
 	}
 	FGISLootSlotInfo()
-		: SlotData(nullptr) {};
+		: LootId(INDEX_NONE),
+		SlotData(nullptr) {};
 	FGISLootSlotInfo(int32 SlotIndexIn, TWeakObjectPtr<class UGISInventoryBaseComponent> SlotComponentIn,
 	class AGISPickupActor* OwningPickupActorIn)
 		: SlotIndex(SlotIndexIn),
+		LootId(INDEX_NONE),
+		SlotData(nullptr),
 		SlotComponent(SlotComponentIn),
 		OwningPickupActor(OwningPickupActorIn)
 	{};
@@ -265,7 +277,11 @@ public:
 		int32 SlotIndex;
 	UPROPERTY(BlueprintReadOnly)
 		int32 SlotTabIndex;
-	UPROPERTY(BlueprintReadWrite)
+	/*
+		Not replicated as part of Tabs. Items in slots are replicated trough
+		UGISInventoryBaseComponent::SlotEntries, so only changed slots are sent.
+	*/
+	UPROPERTY(BlueprintReadWrite, NotReplicated)
 	class UGISItemData* ItemData;
 
 	UPROPERTY(BlueprintReadWrite)
@@ -351,6 +367,12 @@ public:
 	 */
 	UPROPERTY(BlueprintReadOnly)
 		TArray<FGISSlotInfo> TabSlots;
+
+	/**
+	 *	Bit is set for every empty slot. Kept only on server, so empty slot can be found
+	 *	without looking at every slot in tab.
+	 */
+	TBitArray<> FreeSlots;
 };
 
 USTRUCT(BlueprintType)
@@ -378,7 +400,17 @@ public:
 	}
 	inline void SetItemData(int32 TabIndex, int32 SlotIndex, class UGISItemData* DataIn)
 	{
-		InventoryTabs[TabIndex].TabSlots[SlotIndex].ItemData = DataIn;
+		FGISTabInfo& Tab = InventoryTabs[TabIndex];
+		Tab.TabSlots[SlotIndex].ItemData = DataIn;
+		if (Tab.FreeSlots.IsValidIndex(SlotIndex))
+			Tab.FreeSlots[SlotIndex] = DataIn == nullptr;
+	}
+	/**
+	 *	@return Index of first empty slot in tab, or INDEX_NONE if tab is full.
+	 */
+	inline int32 FindFreeSlot(int32 TabIndex)
+	{
+		return InventoryTabs[TabIndex].FreeSlots.Find(true);
 	}
 	inline int32 GetSlotNum(int32 TabIndex)
 	{
@@ -402,6 +434,62 @@ public:
 	}
 };
 
+/*
+	Item in single slot. There is one entry for every slot in inventory, and entry is marked
+	dirty only when item in slot is changed, so only changed slots are replicated.
+*/
+USTRUCT()
+struct GAMEINVENTORYSYSTEM_API FGISSlotEntry : public FFastArraySerializerItem
+{
+	GENERATED_USTRUCT_BODY()
+public:
+	UPROPERTY()
+		int32 TabIndex;
+	UPROPERTY()
+		int32 SlotIndex;
+	UPROPERTY()
+		class UGISItemData* ItemData;
+
+	FGISSlotEntry()
+		: TabIndex(INDEX_NONE),
+		SlotIndex(INDEX_NONE),
+		ItemData(nullptr)
+	{};
+	FGISSlotEntry(int32 TabIndexIn, int32 SlotIndexIn)
+		: TabIndex(TabIndexIn),
+		SlotIndex(SlotIndexIn),
+		ItemData(nullptr)
+	{};
+
+	void PostReplicatedAdd(const struct FGISSlotEntryArray& InArraySerializer);
+	void PostReplicatedChange(const struct FGISSlotEntryArray& InArraySerializer);
+};
+
+USTRUCT()
+struct GAMEINVENTORYSYSTEM_API FGISSlotEntryArray : public FFastArraySerializer
+{
+	GENERATED_USTRUCT_BODY()
+public:
+	UPROPERTY()
+		TArray<FGISSlotEntry> Entries;
+
+	TWeakObjectPtr<class UGISInventoryBaseComponent> InventoryComp;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo & DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FGISSlotEntry, FGISSlotEntryArray>(Entries, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits< FGISSlotEntryArray > : public TStructOpsTypeTraitsBase
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
 USTRUCT()
 struct FGISSlotsInTab
 {
@@ -7,6 +7,7 @@
 #include "GISItemData.h"
 #include "IGISPickupItem.h"
 #include "GISPickupActor.h"
+#include "GISPickupRegistry.h"
 
 #include "Widgets/GISContainerBaseWidget.h"
 #include "Widgets/GISLootContainerBaseWidget.h"
@@ -34,12 +35,14 @@ UGISInventoryBaseComponent::UGISInventoryBaseComponent(const FObjectInitializer&
 	LastTargetTab = INDEX_NONE;
 	LastOtherOriginTab = INDEX_NONE;
 	LastOtherOriginInventory = nullptr;
+	ItemsRepKey = 0;
 }
 
 
 void UGISInventoryBaseComponent::InitializeComponent()
 {
 	Super::InitializeComponent();
+	SlotEntries.InventoryComp = this;
 	ENetRole CurrentRole = GetOwnerRole();
 	ENetMode CurrentNetMode = GetNetMode();
 
@@ -85,19 +88,19 @@ void UGISInventoryBaseComponent::InitializeWidgets(APlayerController* PCIn)
 void UGISInventoryBaseComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-	if (CurrentPickupActor)
-	{
-		float distance = FVector::Dist(CurrentPickupActor->GetActorLocation(), PCOwner->GetPawn()->GetActorLocation());
-		if (distance > MaxLootingDistance)
-		{
-			CurrentPickupActor = nullptr;
-			ClientSwitchLootingWidget();
-			SetComponentTickEnabled(false);
-		}
-	}
+}
+void UGISInventoryBaseComponent::OnPickupOutOfRange()
+{
+	CurrentPickupActor = nullptr;
+	ClientSwitchLootingWidget();
 }
 void UGISInventoryBaseComponent::OnRep_InventoryCreated()
 {
+	//slot entries might have arrived before tabs.
+	for (const FGISSlotEntry& Entry : SlotEntries.Entries)
+	{
+		OnSlotEntryReplicated(Entry);
+	}
 	OnInventoryLoaded.Broadcast();
 }
 
@@ -153,28 +156,124 @@ void UGISInventoryBaseComponent::AddItemToInventory(class UGISItemData* ItemIn)
 	}
 	else
 	{
-		//add item to first empty slot in first matching tab.
-		for (FGISTabInfo& TabInfo : Tabs.InventoryTabs)
+		FGISSlotIndexInfo SlotIndex = AddItemToFreeSlot(ItemIn);
+		if (SlotIndex.SlotIndex == INDEX_NONE)
+			return;
+
+		SlotUpdateInfo.TabIndex = SlotIndex.TabIndex;
+		SlotUpdateInfo.SlotIndex = SlotIndex.SlotIndex;
+		SlotUpdateInfo.SlotData = ItemIn;
+		SlotUpdateInfo.SlotComponent = this;
+		if (GetNetMode() == ENetMode::NM_Standalone)
+			OnItemAdded.Broadcast(SlotUpdateInfo);
+	}
+}
+
+int32 UGISInventoryBaseComponent::AddItemsToInventory(const TArray<class UGISItemData*>& ItemsIn)
+{
+	if (GetOwnerRole() < ROLE_Authority)
+		return 0;
+
+	int32 AddedCount = 0;
+	FGISSlotIndexInfo LastSlotIndex;
+	for (UGISItemData* Item : ItemsIn)
+	{
+		FGISSlotIndexInfo SlotIndex = AddItemToFreeSlot(Item);
+		if (SlotIndex.SlotIndex != INDEX_NONE)
 		{
-			for (FGISSlotInfo& Slot : TabInfo.TabSlots)
-			{
-				if (Slot.ItemData == nullptr)
-				{
-					Slot.ItemData = ItemIn;
-					ItemIn->CurrentInventory = this;
-					TabInfo.ItemCount++;
-					//Slot.ItemData->OnItemRemovedFromSlot();
-					SlotUpdateInfo.TabIndex = TabInfo.TabIndex;
-					SlotUpdateInfo.SlotIndex = Slot.SlotIndex;
-					SlotUpdateInfo.SlotData = Slot.ItemData;
-					SlotUpdateInfo.SlotComponent = this;
-					if (GetNetMode() == ENetMode::NM_Standalone)
-						OnItemAdded.Broadcast(SlotUpdateInfo);
-					return;
-				}
-			}
+			LastSlotIndex = SlotIndex;
+			AddedCount++;
 		}
 	}
+	if (AddedCount == 0)
+		return 0;
+
+	/*
+		Only last slot is sent. Widget will see that item count in tab
+		does not match and will reconstruct whole tab.
+	*/
+	SlotUpdateInfo.TabIndex = LastSlotIndex.TabIndex;
+	SlotUpdateInfo.SlotIndex = LastSlotIndex.SlotIndex;
+	SlotUpdateInfo.SlotData = GetItemDataInSlot(LastSlotIndex.TabIndex, LastSlotIndex.SlotIndex);
+	SlotUpdateInfo.SlotComponent = this;
+	Tabs.EnsureReplication();
+	if (GetNetMode() == ENetMode::NM_Standalone)
+		OnItemAdded.Broadcast(SlotUpdateInfo);
+	return AddedCount;
+}
+
+FGISSlotIndexInfo UGISInventoryBaseComponent::AddItemToFreeSlot(class UGISItemData* ItemIn)
+{
+	if (!ItemIn)
+		return FGISSlotIndexInfo();
+
+	UClass* ItemClass = ItemIn->GetClass();
+	const UGISItemData* ItemCDO = ItemClass->GetDefaultObject<UGISItemData>();
+	if (ItemIn->OwnedTags == ItemCDO->OwnedTags)
+	{
+		for (int32 TabIndex : GetTabsAcceptingItemClass(ItemClass))
+		{
+			int32 SlotIndex = AddItemToFreeSlotInTab(ItemIn, TabIndex);
+			if (SlotIndex != INDEX_NONE)
+				return FGISSlotIndexInfo(TabIndex, SlotIndex);
+		}
+	}
+	else if (IsItemClassAccepted(ItemClass))
+	{
+		//tags changed on this instance, so cached tabs can't be used.
+		for (const FGISTabInfo& TabInfo : Tabs.InventoryTabs)
+		{
+			if (TabInfo.Tags.Num() > 0 && !ItemIn->OwnedTags.HasAny(TabInfo.Tags))
+				continue;
+			int32 SlotIndex = AddItemToFreeSlotInTab(ItemIn, TabInfo.TabIndex);
+			if (SlotIndex != INDEX_NONE)
+				return FGISSlotIndexInfo(TabInfo.TabIndex, SlotIndex);
+		}
+	}
+	return FGISSlotIndexInfo();
+}
+
+int32 UGISInventoryBaseComponent::AddItemToFreeSlotInTab(class UGISItemData* ItemIn, int32 TabIndex)
+{
+	int32 SlotIndex = Tabs.FindFreeSlot(TabIndex);
+	if (SlotIndex == INDEX_NONE)
+		return INDEX_NONE;
+
+	ItemIn->CurrentInventory = this;
+	SetSlotItem(TabIndex, SlotIndex, ItemIn);
+	IncrementItemCount(TabIndex);
+	return SlotIndex;
+}
+
+bool UGISInventoryBaseComponent::IsItemClassAccepted(UClass* ItemClassIn) const
+{
+	if (AccepectedItems.Num() == 0)
+		return true;
+	for (const TSubclassOf<UGISItemData>& Accepted : AccepectedItems)
+	{
+		if (Accepted && ItemClassIn->IsChildOf(Accepted))
+			return true;
+	}
+	return false;
+}
+
+const TArray<int32>& UGISInventoryBaseComponent::GetTabsAcceptingItemClass(UClass* ItemClassIn)
+{
+	if (const TArray<int32>* Cached = AcceptingTabs.Find(ItemClassIn))
+		return *Cached;
+
+	TArray<int32>& Accepting = AcceptingTabs.Add(ItemClassIn);
+	if (!IsItemClassAccepted(ItemClassIn))
+		return Accepting;
+
+	//tabs without tags accept any item.
+	const FGameplayTagContainer& ItemTags = ItemClassIn->GetDefaultObject<UGISItemData>()->OwnedTags;
+	for (const FGISTabInfo& TabInfo : Tabs.InventoryTabs)
+	{
+		if (TabInfo.Tags.Num() == 0 || ItemTags.HasAny(TabInfo.Tags))
+			Accepting.Add(TabInfo.TabIndex);
+	}
+	return Accepting;
 }
 
 void UGISInventoryBaseComponent::ServerAddItemToInventory_Implementation(class UGISItemData* ItemIn)
@@ -380,6 +479,7 @@ void UGISInventoryBaseComponent::OnItemAddedToSlot(class UGISItemData* AddedItem
 	{
 		AddedItemIn->OnItemRemovedFromSlot();
 		AddedItemIn->OnItemAddedToSlot();
+		AddedItemIn->MarkItemDirty();
 	}
 }
 
@@ -401,6 +501,11 @@ void UGISInventoryBaseComponent::RemoveItem(const FGISSlotInfo& TargetSlotType)
 
 void UGISInventoryBaseComponent::OnRep_LootedItems()
 {
+	for (FGISLootSlotInfo& Loot : LootFromPickup.Loot)
+	{
+		Loot.SlotComponent = this;
+		Loot.OwningPickupActor = CurrentPickupActor;
+	}
 	OnLootingStart.Broadcast();
 }
 void UGISInventoryBaseComponent::OnRep_PickupActor()
@@ -418,28 +523,33 @@ void UGISInventoryBaseComponent::ClientSwitchLootingWidget_Implementation()
 }
 void UGISInventoryBaseComponent::PreLootAction(TArray<class AGISPickupActor*> PickupsIn)
 { 
-	TArray<FGISPickupActorDistanceHelper> HelperStruct;
+	if (!PCOwner || !PCOwner->GetPawn())
+		return;
 	FVector PawmLocation = PCOwner->GetPawn()->GetActorLocation();
-	for (AGISPickupActor* Pickup : PickupsIn)
+	AGISPickupActor* Nearest = nullptr;
+	if (PickupsIn.Num() == 0)
+	{
+		Nearest = FGISPickupRegistry::FindNearestWithLoot(GetWorld(), PawmLocation, MaxLootingDistance);
+	}
+	else
 	{
-		if (Pickup)
+		//only closest one is needed, no need to sort.
+		float NearestDistSq = MaxLootingDistance * MaxLootingDistance;
+		for (AGISPickupActor* Pickup : PickupsIn)
 		{
-			if (Pickup->ItemToLoot.Num() > 0)
+			if (Pickup && Pickup->ItemToLoot.Num() > 0)
 			{
-				float Distance = FVector::Dist(PawmLocation, Pickup->GetActorLocation());
-				FGISPickupActorDistanceHelper helper(Distance, Pickup);
-				HelperStruct.Add(helper);
+				float DistSq = FVector::DistSquared(PawmLocation, Pickup->GetActorLocation());
+				if (DistSq <= NearestDistSq)
+				{
+					NearestDistSq = DistSq;
+					Nearest = Pickup;
+				}
 			}
 		}
 	}
-	HelperStruct.Sort();
-
-	if (HelperStruct.IsValidIndex(0))
-	{
-		//don't need to check everything. If closest actor is to far, rest is as well.
-		if (HelperStruct[0].Distance > MaxLootingDistance)
-			StartLooting(HelperStruct[0].PickupActor.Get());
-	}
+	if (Nearest)
+		StartLooting(Nearest);
 }
 void UGISInventoryBaseComponent::StartLooting(class AGISPickupActor* PickUp)
 {
@@ -448,81 +558,85 @@ void UGISInventoryBaseComponent::StartLooting(class AGISPickupActor* PickUp)
 	//2. Discard all actors wihtout loot (if they are in array).
 	//3. Iterate over all actors and find closest to character.
 	//4. Start interacting with closer one, and discard rest.
-	SetComponentTickEnabled(true);
 	ClientSwitchLootingWidget();
-	int32 ItemNum = PickUp->ItemToLoot.Num();
 	CurrentPickupActor = PickUp;
-	LootFromPickup.Loot.Empty();
-	for (int32 ItemIndex = 0; ItemIndex < ItemNum; ItemIndex++)
+	if (PCOwner && PCOwner->GetPawn())
 	{
-		FGISLootSlotInfo lootInfo;
-		UGISItemData* dataDuplicate = NewObject<UGISItemData>(this, CurrentPickupActor->ItemToLoot[ItemIndex]->GetClass(), NAME_None, RF_NoFlags, CurrentPickupActor->ItemToLoot[ItemIndex]);
-		lootInfo.OwningPickupActor = PickUp;
-		lootInfo.SlotComponent = this;
-		lootInfo.SlotIndex = ItemIndex;
-		lootInfo.SlotData = dataDuplicate;
-		LootFromPickup.Loot.Add(lootInfo);
-		LootFromPickup.ForceRep++;
+		FGISPickupRegistry::WatchRange(PCOwner->GetPawn(), PickUp, MaxLootingDistance,
+			FGISOnPickupOutOfRange::CreateUObject(this, &UGISInventoryBaseComponent::OnPickupOutOfRange));
 	}
+	BuildLootManifest();
+}
+
+void UGISInventoryBaseComponent::BuildLootManifest()
+{
+	//items are not copied here. Loot window references items owned by pickup.
+	LootFromPickup.Loot.Reset();
+	if (CurrentPickupActor)
+	{
+		int32 ItemNum = CurrentPickupActor->ItemToLoot.Num();
+		for (int32 ItemIndex = 0; ItemIndex < ItemNum; ItemIndex++)
+		{
+			FGISLootSlotInfo lootInfo(ItemIndex, this, CurrentPickupActor);
+			lootInfo.LootId = CurrentPickupActor->GetLootId(ItemIndex);
+			lootInfo.SlotData = CurrentPickupActor->ItemToLoot[ItemIndex];
+			LootFromPickup.Loot.Add(lootInfo);
+		}
+	}
+	LootFromPickup.ForceRep++;
 }
 
 void UGISInventoryBaseComponent::LootOneItem(int32 ItemIndex)
 {
+	if (!LootFromPickup.Loot.IsValidIndex(ItemIndex))
+		return;
+	int32 LootId = LootFromPickup.Loot[ItemIndex].LootId;
 	if (GetOwnerRole() < ROLE_Authority)
 	{
-		//if (LootFromPickup.Loot.IsValidIndex(ItemIndex) && CurrentPickupActor->ItemToLoot.IsValidIndex(ItemIndex))
-		//	CurrentPickupActor->ItemToLoot.RemoveAt(ItemIndex);
-		
-		SeverLootOneItem(ItemIndex);
+		SeverLootOneItem(LootId);
 	}
 	else
 	{
-		if (CurrentPickupActor)
-		{
-			//if it is not valid index both arrays, then something is wrong.
-			if (LootFromPickup.Loot.IsValidIndex(ItemIndex) && CurrentPickupActor->ItemToLoot.IsValidIndex(ItemIndex))
-			{
-				
-				AddItemToInventory(LootFromPickup.Loot[ItemIndex].SlotData);
-				//ok we removed one item. We need to rconstruct widgets, indexes etc, to make sure arry
-				//have proper indexes in first place.
-				//LootFromPickup.Loot.RemoveAtSwap(ItemIndex, 1, false);
-				LootFromPickup.Loot.RemoveAt(ItemIndex);
-				CurrentPickupActor->ItemToLoot.RemoveAt(ItemIndex);
-				int32 ItemNum = CurrentPickupActor->ItemToLoot.Num();
-				LootFromPickup.Loot.Empty();
-				for (int32 ItemIdx = 0; ItemIdx < ItemNum; ItemIdx++)
-				{
-					FGISLootSlotInfo lootInfo;
-					UGISItemData* dataDuplicate = NewObject<UGISItemData>(this, CurrentPickupActor->ItemToLoot[ItemIndex]->GetClass(), NAME_None, RF_NoFlags, CurrentPickupActor->ItemToLoot[ItemIdx]);
-					lootInfo.OwningPickupActor = CurrentPickupActor;
-					lootInfo.SlotComponent = this;
-					lootInfo.SlotIndex = ItemIdx;
-					lootInfo.SlotData = dataDuplicate;
-					LootFromPickup.Loot.Add(lootInfo);
-				}
-				//if there is nothing to loot, and looting widget is visible, this will hide it.
-				if (LootFromPickup.Loot.Num() == 0)
-				{
-					SetComponentTickEnabled(false);
-					ClientSwitchLootingWidget();
-				}
-				LootFromPickup.ForceRep++;
-				CurrentPickupActor->OnLooted();
-			}
-			//reconstruct widget.
-			if (GetNetMode() == ENetMode::NM_Standalone)
-			{
-				OnRep_LootedItems();
-			}
-		}
+		LootItemById(LootId);
 	}
 }
-void UGISInventoryBaseComponent::SeverLootOneItem_Implementation(int32 ItemIndex)
+
+void UGISInventoryBaseComponent::LootItemById(int32 LootIdIn)
 {
-	LootOneItem(ItemIndex);
+	if (!CurrentPickupActor)
+		return;
+
+	UGISItemData* SharedItem = CurrentPickupActor->TakeLootItem(LootIdIn);
+	if (SharedItem)
+	{
+		//item is copied only now, when it's actually taken.
+		UGISItemData* dataDuplicate = NewObject<UGISItemData>(this, SharedItem->GetClass(), NAME_None, RF_NoFlags, SharedItem);
+		AddItemToInventory(dataDuplicate);
+	}
+	//item might have been already taken by someone else, so manifest is rebuilt anyway.
+	BuildLootManifest();
+	//if there is nothing to loot, and looting widget is visible, this will hide it.
+	if (LootFromPickup.Loot.Num() == 0)
+	{
+		if (PCOwner)
+			FGISPickupRegistry::StopWatchingRange(PCOwner->GetPawn());
+		ClientSwitchLootingWidget();
+	}
+	if (SharedItem)
+	{
+		CurrentPickupActor->OnLooted();
+	}
+	//reconstruct widget.
+	if (GetNetMode() == ENetMode::NM_Standalone)
+	{
+		OnRep_LootedItems();
+	}
 }
-bool UGISInventoryBaseComponent::SeverLootOneItem_Validate(int32 ItemIndex)
+void UGISInventoryBaseComponent::SeverLootOneItem_Implementation(int32 LootIdIn)
+{
+	LootItemById(LootIdIn);
+}
+bool UGISInventoryBaseComponent::SeverLootOneItem_Validate(int32 LootIdIn)
 {
 	return true;
 }
@@ -592,6 +706,7 @@ void UGISInventoryBaseComponent::GetLifetimeReplicatedProps(TArray< class FLifet
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	DOREPLIFETIME_CONDITION(UGISInventoryBaseComponent, Tabs, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UGISInventoryBaseComponent, SlotEntries, COND_OwnerOnly);
 	DOREPLIFETIME_CONDITION(UGISInventoryBaseComponent, SlotUpdateInfo, COND_OwnerOnly);
 	DOREPLIFETIME_CONDITION(UGISInventoryBaseComponent, SlotSwapInfo, COND_OwnerOnly);
 	DOREPLIFETIME_CONDITION(UGISInventoryBaseComponent, CurrentPickupActor, COND_OwnerOnly);
@@ -605,42 +720,59 @@ bool UGISInventoryBaseComponent::ReplicateSubobjects(class UActorChannel *Channe
 	bool WroteSomething = Super::ReplicateSubobjects(Channel, Bunch, RepFlags);
 
 	/*
-		Should optimize it to replicate only items in array which changed.
-		Don't know how though. Yet.
+		Item is sent only if it changed (or channel didn't acked it yet). Key of whole
+		inventory is checked first, so unchanged inventory is not iterated at all.
 	*/
-
-	for (const FGISTabInfo& TabInfo : Tabs.InventoryTabs)
+	if (Channel->KeyNeedsToReplicate(GetUniqueID(), ItemsRepKey))
 	{
-		for (const FGISSlotInfo& SlotItem : TabInfo.TabSlots)
+		for (const FGISSlotEntry& Entry : SlotEntries.Entries)
 		{
-			if (SlotItem.ItemData)
-			{
-				WroteSomething |= Channel->ReplicateSubobject(const_cast<UGISItemData*>(SlotItem.ItemData), *Bunch, *RepFlags);
-			}
+			WroteSomething |= ReplicateItem(Channel, Bunch, RepFlags, Entry.ItemData);
 		}
 	}
 
-	if (SlotUpdateInfo.SlotData)
-	{
-		WroteSomething |= Channel->ReplicateSubobject(const_cast<UGISItemData*>(SlotUpdateInfo.SlotData), *Bunch, *RepFlags);
-	}
-	if (SlotSwapInfo.LastSlotData)
-	{
-		WroteSomething |= Channel->ReplicateSubobject(const_cast<UGISItemData*>(SlotSwapInfo.LastSlotData), *Bunch, *RepFlags);
-	}
-	if (SlotSwapInfo.TargetSlotData)
+	WroteSomething |= ReplicateItem(Channel, Bunch, RepFlags, SlotUpdateInfo.SlotData);
+	WroteSomething |= ReplicateItem(Channel, Bunch, RepFlags, SlotSwapInfo.LastSlotData);
+	WroteSomething |= ReplicateItem(Channel, Bunch, RepFlags, SlotSwapInfo.TargetSlotData);
+	//loot items are replicated by pickup actor, which owns them.
+	return WroteSomething;
+}
+bool UGISInventoryBaseComponent::ReplicateItem(class UActorChannel *Channel, class FOutBunch *Bunch, FReplicationFlags *RepFlags,
+	class UGISItemData* ItemIn)
+{
+	if (!ItemIn || !Channel->KeyNeedsToReplicate(ItemIn->GetUniqueID(), ItemIn->GetRepKey()))
+		return false;
+	return Channel->ReplicateSubobject(ItemIn, *Bunch, *RepFlags);
+}
+
+void UGISInventoryBaseComponent::OnSlotEntryReplicated(const FGISSlotEntry& EntryIn)
+{
+	//tabs might not be replicated yet. OnRep_InventoryCreated will apply it then.
+	if (Tabs.IsValid(EntryIn.TabIndex, EntryIn.SlotIndex))
 	{
-		WroteSomething |= Channel->ReplicateSubobject(const_cast<UGISItemData*>(SlotSwapInfo.TargetSlotData), *Bunch, *RepFlags);
+		Tabs.InventoryTabs[EntryIn.TabIndex].TabSlots[EntryIn.SlotIndex].ItemData = EntryIn.ItemData;
 	}
-	for (const FGISLootSlotInfo& data : LootFromPickup.Loot)
+}
+
+void UGISInventoryBaseComponent::SetSlotItem(int32 TabIndex, int32 SlotIndex, class UGISItemData* DataIn)
+{
+	UGISItemData* OldData = Tabs.GetItemData(TabIndex, SlotIndex);
+	Tabs.SetItemData(TabIndex, SlotIndex, DataIn);
+	if (!TabEntryOffsets.IsValidIndex(TabIndex))
+		return;
+	//item is marked dirty, even if it is the same, since it might have been moved from other slot.
+	if (DataIn)
 	{
-		if (data.SlotData)
-		{
-			WroteSomething |= Channel->ReplicateSubobject(const_cast<UGISItemData*>(data.SlotData), *Bunch, *RepFlags);
-		}
+		DataIn->MarkItemDirty();
+		MarkItemsDirty();
 	}
-	return WroteSomething;
+	if (OldData == DataIn)
+		return;
+	FGISSlotEntry& Entry = SlotEntries.Entries[TabEntryOffsets[TabIndex] + SlotIndex];
+	Entry.ItemData = DataIn;
+	SlotEntries.MarkItemDirty(Entry);
 }
+
 void UGISInventoryBaseComponent::GetSubobjectsWithStableNamesForNetworking(TArray<UObject*>& Objs)
 {
 	for (const FGISTabInfo& TabInfo : Tabs.InventoryTabs)
@@ -677,9 +809,18 @@ void UGISInventoryBaseComponent::InitializeInventoryTabs()
 			SlotInfo.ItemData = nullptr;
 			TabInfo.TabSlots.Add(SlotInfo);
 		}
+		TabInfo.FreeSlots.Init(true, tabConf.NumberOfSlots);
 		Tabs.InventoryTabs.Add(TabInfo);
+
+		TabEntryOffsets.Add(SlotEntries.Entries.Num());
+		for (int32 Index = 0; Index < tabConf.NumberOfSlots; Index++)
+		{
+			int32 EntryIndex = SlotEntries.Entries.Add(FGISSlotEntry(counter, Index));
+			SlotEntries.MarkItemDirty(SlotEntries.Entries[EntryIndex]);
+		}
 		counter++;
 	}
+	AcceptingTabs.Empty();
 }
 void  UGISInventoryBaseComponent::InputSlotPressed(int32 TabIndex, int32 SlotIndex)
 {
@@ -687,6 +828,7 @@ void  UGISInventoryBaseComponent::InputSlotPressed(int32 TabIndex, int32 SlotInd
 	if (Tabs.GetItemData(TabIndex, SlotIndex))
 	{
 		Tabs.GetItemData(TabIndex, SlotIndex)->InputPressed();
+		Tabs.GetItemData(TabIndex, SlotIndex)->MarkItemDirty();
 	}
 }
 void UGISInventoryBaseComponent::InputSlotReleased(int32 TabIndex, int32 SlotIndex)
@@ -694,6 +836,7 @@ void UGISInventoryBaseComponent::InputSlotReleased(int32 TabIndex, int32 SlotInd
 	if (Tabs.GetItemData(TabIndex, SlotIndex))
 	{
 		Tabs.GetItemData(TabIndex, SlotIndex)->InputReleased();
+		Tabs.GetItemData(TabIndex, SlotIndex)->MarkItemDirty();
 	}
 }
 void UGISInventoryBaseComponent::SwapTabItems(int32 OriginalTab, int32 TargetTab)
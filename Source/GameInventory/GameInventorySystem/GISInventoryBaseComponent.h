@@ -46,28 +46,6 @@ DECLARE_DELEGATE_OneParam(FGISOnTabChanged, int32);
 	Or.. I can just check for valid index in array.
 */
 
-struct FGISPickupActorDistanceHelper
-{
-	float Distance;
-	TWeakObjectPtr<class AGISPickupActor> PickupActor;
-
-	FGISPickupActorDistanceHelper()
-	{}
-
-	FGISPickupActorDistanceHelper(float DistanceIn, TWeakObjectPtr<class AGISPickupActor>  PickupActorIn)
-		: Distance(DistanceIn),
-		PickupActor(PickupActorIn)
-	{};
-	inline bool operator==(const FGISPickupActorDistanceHelper& Other) const
-	{
-		return Other.Distance == Distance;
-	}
-	inline bool operator<(const FGISPickupActorDistanceHelper& Other) const 
-	{
-		return Other.Distance > Distance;
-	}
-};
-
 UCLASS(hidecategories = (Object, LOD, Lighting, Transform, Sockets, TextureStreaming), editinlinenew, meta = (BlueprintSpawnableComponent))
 class GAMEINVENTORYSYSTEM_API UGISInventoryBaseComponent : public UActorComponent
 {
@@ -154,6 +132,13 @@ protected:
 
 	UFUNCTION()
 		void OnRep_InventoryCreated();
+
+	/*
+		Items in slots, one entry per slot. Replicated separately from Tabs, so change of
+		single slot sends only that slot, not whole inventory.
+	*/
+	UPROPERTY(Replicated)
+		FGISSlotEntryArray SlotEntries;
 	/*
 		Inventory Configuration.
 	*/
@@ -232,6 +217,8 @@ protected:
 
 	UFUNCTION()
 		void OnRep_PickupActor();
+	/* Called by FGISPickupRegistry, when owner went to far from CurrentPickupActor. */
+	void OnPickupOutOfRange();
 
 
 
@@ -290,6 +277,8 @@ public:
 	virtual bool ServerPickItem_Validate(AActor* PickupItemIn);
 	/* 
 		Adds item to inventory. In Multiplayer, never call it on client.
+		Item is put only into tabs, whose Tags it has (tabs without Tags accept any item),
+		and only if its class is in AccepectedItems (empty accepts any item).
 	*/
 	UFUNCTION(BlueprintCallable, Category="Game Inventory System")
 		virtual void AddItemToInventory(class UGISItemData* ItemIn);
@@ -299,6 +288,15 @@ public:
 	virtual void ServerAddItemToInventory_Implementation(class UGISItemData* ItemIn);
 	virtual bool ServerAddItemToInventory_Validate(class UGISItemData* ItemIn);
 
+	/*
+		Adds multiple items at once, for example everything from chest or loot explosion.
+		Items which do not fit are skipped. Server only.
+
+		@return Number of items added.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Game Inventory System")
+		virtual int32 AddItemsToInventory(const TArray<class UGISItemData*>& ItemsIn);
+
 	UFUNCTION(BlueprintCallable, Category = "Game Inventory System")
 		virtual void AddItemOnSlot(const FGISSlotInfo& TargetSlotType, const FGISSlotInfo& LastSlotType);
 
@@ -324,18 +322,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Game Inventory System")
 		virtual void RemoveItem(const FGISSlotInfo& TargetSlotType);
 
-	//temp
+	/*
+		Starts looting closest pickup with items, within MaxLootingDistance.
+		If PickupsIn is empty, pickups around owner are found trough FGISPickupRegistry.
+	*/
 	UFUNCTION(BlueprintCallable, Category = "Game Inventory System")
 		void PreLootAction(TArray<class AGISPickupActor*> PickupsIn);
 
 	void StartLooting(class AGISPickupActor* PickUp);
 
+	/*
+		Takes item at index in loot window. Item is sent to server by it's loot id, so it is
+		still the right item, when someone else took item before it.
+	*/
 	UFUNCTION(BlueprintCallable, Category = "Game Inventory System")
 		void LootOneItem(int32 ItemIndex);
 	UFUNCTION(Server, Reliable, WithValidation)
-		void SeverLootOneItem(int32 ItemIndex);
-	virtual void SeverLootOneItem_Implementation(int32 ItemIndex);
-	virtual bool SeverLootOneItem_Validate(int32 ItemIndex);
+		void SeverLootOneItem(int32 LootIdIn);
+	virtual void SeverLootOneItem_Implementation(int32 LootIdIn);
+	virtual bool SeverLootOneItem_Validate(int32 LootIdIn);
 
 	UFUNCTION(BlueprintCallable, Category = "Game Inventory System")
 		void DropItemFromInventory(const FGISSlotInfo& DropItemInfoIn);
@@ -517,13 +522,54 @@ public:
 	virtual bool ReplicateSubobjects(class UActorChannel *Channel, class FOutBunch *Bunch, FReplicationFlags *RepFlags) override;
 	virtual void GetSubobjectsWithStableNamesForNetworking(TArray<UObject*>& Objs) override;
 
+	/* Client side. Puts replicated item into it's slot. */
+	void OnSlotEntryReplicated(const FGISSlotEntry& EntryIn);
+
+	/*
+		Items are replicated only when they are changed. Called by UGISItemData::MarkItemDirty.
+	*/
+	inline void MarkItemsDirty() { ItemsRepKey++; }
+
 	/*
 		Invenory UObject replication support
 
 	*/
+protected:
+	/*
+		Puts item into first empty slot of first tab which accept it. Does not notify clients.
+
+		@return Index of slot, or invalid index if there is no space for item.
+	*/
+	FGISSlotIndexInfo AddItemToFreeSlot(class UGISItemData* ItemIn);
+	/*
+		Checks class against AccepectedItems. Items added trough AddItemToInventory
+		were never filtered, so empty AccepectedItems accept everything here.
+	*/
+	bool IsItemClassAccepted(UClass* ItemClassIn) const;
+	/*
+		Tabs, which accept items of class (by tags of class default object), in tab order.
+	*/
+	const TArray<int32>& GetTabsAcceptingItemClass(UClass* ItemClassIn);
+	/* Replicates item, if it changed since channel has seen it. */
+	bool ReplicateItem(class UActorChannel *Channel, class FOutBunch *Bunch, FReplicationFlags *RepFlags,
+		class UGISItemData* ItemIn);
 private:
 	void InitializeWidgets();
 	void InitializeInventoryTabs();
+	int32 AddItemToFreeSlotInTab(class UGISItemData* ItemIn, int32 TabIndex);
+	/* Fills LootFromPickup with references to items in CurrentPickupActor. */
+	void BuildLootManifest();
+	void LootItemById(int32 LootIdIn);
+	/* Sets item in slot, and marks slot entry and item dirty on server. */
+	void SetSlotItem(int32 TabIndex, int32 SlotIndex, class UGISItemData* DataIn);
+
+	/* Cache for GetTabsAcceptingItemClass. Tab tags do not change after tabs are initialized. */
+	TMap<UClass*, TArray<int32>> AcceptingTabs;
+
+	/* Index of first entry in SlotEntries, for each tab. Server only. */
+	TArray<int32> TabEntryOffsets;
+	/* Bumped when any item in this inventory changed, so unchanged inventory is not even iterated. */
+	int32 ItemsRepKey;
 
 	int32 LastTargetTab; //last tab from which we copied items, to this tab.
 	int32 LastOtherOriginTab; //last tab from OTHER component, from which we copied items, to this component tab.
@@ -538,7 +584,7 @@ public:
 	
 	inline void CopyItemsFromTab(int32 TargetTab, int32 TargetIndex, int32 OriginTab, int32 OriginIndex) 
 	{
-		Tabs.SetItemData(TargetTab, TargetIndex, Tabs.GetItemData(OriginTab, OriginIndex));
+		SetSlotItem(TargetTab, TargetIndex, Tabs.GetItemData(OriginTab, OriginIndex));
 	}
 	inline class UGISItemData* GetItemDataInSlot(int32 TabIndex, int32 SlotIndex)
 	{ 
@@ -546,7 +592,7 @@ public:
 	}
 	inline void SetItemDataInSlot(int32 TabIndex, int32 SlotIndex, class UGISItemData* DataIn)
 	{ 
-		Tabs.SetItemData(TabIndex,SlotIndex, DataIn); 
+		SetSlotItem(TabIndex, SlotIndex, DataIn);
 	}
 	inline bool IsInventoryValid(int32 TabIndex, int32 SlotIndex)
 	{
@@ -4,12 +4,15 @@
 
 #include "Net/UnrealNetwork.h"
 
+#include "GISInventoryBaseComponent.h"
+
 #include "GISItemData.h"
 
 UGISItemData::UGISItemData(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	bNetAddressable = false;
+	RepKey = 0;
 	bCanStack = false;
 	bCanBedropped = false;
 	StackCounter = 0;
@@ -31,6 +34,13 @@ void UGISItemData::SetNetAddressable()
 	bNetAddressable = true;
 }
 
+void UGISItemData::MarkItemDirty()
+{
+	RepKey++;
+	if (CurrentInventory)
+		CurrentInventory->MarkItemsDirty();
+}
+
 UWorld* UGISItemData::GetWorld() const
 {
 	if (CurrentWorld)
@@ -88,6 +88,15 @@ public:
 		return true;
 	}
 	void SetNetAddressable();
+
+	/*
+		Inventory replicate item only when it changed since it was last sent.
+		Call it on server after changing any replicated property of item.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Game Inventory System")
+		void MarkItemDirty();
+
+	inline int32 GetRepKey() const { return RepKey; }
 	/*
 		Cosmetic stuff.
 	*/
@@ -197,6 +206,8 @@ public:
 protected:
 	bool bNetAddressable;
 
+	int32 RepKey;
+
 };
 
 template< class T >
@@ -10,6 +10,7 @@
 #include "Net/UnrealNetwork.h"
 #include "Engine/ActorChannel.h"
 #include "IGISInventory.h"
+#include "GISPickupRegistry.h"
 #include "GISPickupActor.h"
 
 AGISPickupActor::AGISPickupActor(const FObjectInitializer& ObjectInitializer)
@@ -17,11 +18,19 @@ AGISPickupActor::AGISPickupActor(const FObjectInitializer& ObjectInitializer)
 {
 	bReplicates = true;
 	bIsCurrentlyBeingLooted = false;
+	NextLootId = 0;
 }
 
 void AGISPickupActor::BeginPlay()
 {
+	Super::BeginPlay();
+	FGISPickupRegistry::RegisterPickup(this);
+}
 
+void AGISPickupActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FGISPickupRegistry::UnregisterPickup(this);
+	Super::EndPlay(EndPlayReason);
 }
 
 void AGISPickupActor::Interact(AActor* InteractingActor)
@@ -67,6 +76,33 @@ void AGISPickupActor::OnLooted()
 	}
 }
 
+int32 AGISPickupActor::GetLootId(int32 ItemIndex)
+{
+	UpdateLootIds();
+	return LootIds[ItemIndex];
+}
+
+class UGISItemData* AGISPickupActor::TakeLootItem(int32 LootIdIn)
+{
+	UpdateLootIds();
+	int32 ItemIndex = LootIds.Find(LootIdIn);
+	if (ItemIndex == INDEX_NONE)
+		return nullptr;
+
+	UGISItemData* Item = ItemToLoot[ItemIndex];
+	ItemToLoot.RemoveAt(ItemIndex);
+	LootIds.RemoveAt(ItemIndex);
+	return Item;
+}
+
+void AGISPickupActor::UpdateLootIds()
+{
+	while (LootIds.Num() < ItemToLoot.Num())
+	{
+		LootIds.Add(NextLootId++);
+	}
+}
+
 void AGISPickupActor::DestroyPickupActor()
 {
 
@@ -39,6 +39,7 @@ public:
 public:
 	AGISPickupActor(const FObjectInitializer& ObjectInitializer);
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 	/** IIGIInteractable - BEGIN */
 	//UFUNCTION(BlueprintCallable, Category = "Game Interfaces | Interact")
@@ -53,6 +54,19 @@ public:
 	virtual bool ServerStartLooting_Validate(AActor* WhoPicks);
 	
 	virtual void OnLooted();
+
+	/*
+		Stable id of item at index in ItemToLoot. Items are shared by all looters trough their
+		loot windows, and are referenced by id, since indexes change when items are taken.
+		Server only.
+	*/
+	int32 GetLootId(int32 ItemIndex);
+	/*
+		Removes item from ItemToLoot. Items must be removed trough it, to keep ids in sync.
+
+		@return Removed item, or nullptr if it has been already taken.
+	*/
+	class UGISItemData* TakeLootItem(int32 LootIdIn);
 	/*
 		Should be called when item count in array reaches zero, or life time of actor experies.
 		It will actually call DestroyActor(), but it can be used for cleanup/spawning cosmetic effects
@@ -69,6 +83,13 @@ public:
 
 	/** Called on the actor when a new subobject is dynamically created via replication */
 	virtual void OnSubobjectDestroyFromReplication(UObject *NewSubobject) override;
+protected:
+	/* Ids of items in ItemToLoot, by index. Assigned on demand, since items can be added directly. */
+	TArray<int32> LootIds;
+	int32 NextLootId;
+
+	void UpdateLootIds();
+public:
 	/*
 		Intention to work is as fallows:
 		1. User interact with this actor.
@@ -0,0 +1,224 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "GameInventorySystem.h"
+
+#include "GISPickupActor.h"
+#include "GISPickupRegistry.h"
+
+static TAutoConsoleVariable<float> CVarPickupCellSize(
+	TEXT("GIS.Pickup.CellSize"),
+	1000.0f,
+	TEXT("Size of grid cell used to find pickups around location. Applied to worlds created after change."));
+
+static TAutoConsoleVariable<float> CVarPickupRangeCheckInterval(
+	TEXT("GIS.Pickup.RangeCheckInterval"),
+	0.1f,
+	TEXT("How often looters are checked for being out of range of pickup they loot (seconds)."));
+
+namespace GISPickupRegistry
+{
+	struct FRangeWatch
+	{
+		TWeakObjectPtr<AActor> Looter;
+		TWeakObjectPtr<AGISPickupActor> Pickup;
+		float MaxDistanceSq;
+		FGISOnPickupOutOfRange OutOfRange;
+	};
+	struct FWorldPickups
+	{
+		float CellSize;
+		TMap<FIntPoint, TArray<AGISPickupActor*, TInlineAllocator<4>>> Grid;
+		/* Cell, in which pickup has been registered. */
+		TMap<AGISPickupActor*, FIntPoint> PickupCells;
+		TArray<FRangeWatch> Watches;
+		float NextRangeCheckTime;
+
+		FWorldPickups()
+			: CellSize(FMath::Max(CVarPickupCellSize.GetValueOnGameThread(), 1.f)),
+			NextRangeCheckTime(0)
+		{}
+
+		inline FIntPoint GetCell(const FVector& LocationIn) const
+		{
+			return FIntPoint(FMath::FloorToInt(LocationIn.X / CellSize), FMath::FloorToInt(LocationIn.Y / CellSize));
+		}
+	};
+	static TMap<UWorld*, FWorldPickups> Worlds;
+	static FDelegateHandle PostActorTickHandle;
+	static FDelegateHandle WorldCleanupHandle;
+
+	/* Calls FuncIn for every pickup in cells overlapping radius. Distance is not checked. */
+	template<typename Func>
+	static void ForEachInCells(const FWorldPickups& PickupsIn, const FVector& LocationIn, float RadiusIn, Func FuncIn)
+	{
+		const FIntPoint Min = PickupsIn.GetCell(LocationIn - FVector(RadiusIn));
+		const FIntPoint Max = PickupsIn.GetCell(LocationIn + FVector(RadiusIn));
+		for (int32 X = Min.X; X <= Max.X; X++)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+			{
+				if (const TArray<AGISPickupActor*, TInlineAllocator<4>>* Cell = PickupsIn.Grid.Find(FIntPoint(X, Y)))
+				{
+					for (AGISPickupActor* Pickup : *Cell)
+					{
+						FuncIn(Pickup);
+					}
+				}
+			}
+		}
+	}
+	static void CheckRanges(FWorldPickups& PickupsIn)
+	{
+		//callbacks might start new watches, so they are called after iteration.
+		TArray<FGISOnPickupOutOfRange> OutOfRange;
+		for (int32 Idx = PickupsIn.Watches.Num() - 1; Idx >= 0; Idx--)
+		{
+			const FRangeWatch& Watch = PickupsIn.Watches[Idx];
+			AActor* Looter = Watch.Looter.Get();
+			AGISPickupActor* Pickup = Watch.Pickup.Get();
+			if (Looter && Pickup && !Pickup->IsPendingKill()
+				&& FVector::DistSquared(Looter->GetActorLocation(), Pickup->GetActorLocation()) <= Watch.MaxDistanceSq)
+			{
+				continue;
+			}
+			OutOfRange.Add(Watch.OutOfRange);
+			PickupsIn.Watches.RemoveAtSwap(Idx, 1, false);
+		}
+		for (FGISOnPickupOutOfRange& Callback : OutOfRange)
+		{
+			Callback.ExecuteIfBound();
+		}
+	}
+	static void OnPostActorTick(UWorld* WorldIn, ELevelTick TickTypeIn, float DeltaTimeIn)
+	{
+		FWorldPickups* Pickups = Worlds.Find(WorldIn);
+		if (!Pickups || Pickups->Watches.Num() == 0 || WorldIn->GetTimeSeconds() < Pickups->NextRangeCheckTime)
+			return;
+		Pickups->NextRangeCheckTime = WorldIn->GetTimeSeconds() + CVarPickupRangeCheckInterval.GetValueOnGameThread();
+		CheckRanges(*Pickups);
+	}
+	static void OnWorldCleanup(UWorld* WorldIn, bool bSessionEnded, bool bCleanupResources)
+	{
+		Worlds.Remove(WorldIn);
+	}
+}
+
+void FGISPickupRegistry::Startup()
+{
+	GISPickupRegistry::PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(
+		&GISPickupRegistry::OnPostActorTick);
+	GISPickupRegistry::WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(
+		&GISPickupRegistry::OnWorldCleanup);
+}
+void FGISPickupRegistry::Shutdown()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(GISPickupRegistry::PostActorTickHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(GISPickupRegistry::WorldCleanupHandle);
+	GISPickupRegistry::Worlds.Empty();
+}
+
+void FGISPickupRegistry::RegisterPickup(class AGISPickupActor* PickupIn)
+{
+	if (!PickupIn || !PickupIn->GetWorld() || !PickupIn->GetWorld()->IsGameWorld())
+		return;
+	GISPickupRegistry::FWorldPickups& Pickups = GISPickupRegistry::Worlds.FindOrAdd(PickupIn->GetWorld());
+	if (Pickups.PickupCells.Contains(PickupIn))
+		return;
+	const FIntPoint Cell = Pickups.GetCell(PickupIn->GetActorLocation());
+	Pickups.PickupCells.Add(PickupIn, Cell);
+	Pickups.Grid.FindOrAdd(Cell).Add(PickupIn);
+}
+
+void FGISPickupRegistry::UnregisterPickup(class AGISPickupActor* PickupIn)
+{
+	if (!PickupIn)
+		return;
+	GISPickupRegistry::FWorldPickups* Pickups = GISPickupRegistry::Worlds.Find(PickupIn->GetWorld());
+	if (!Pickups)
+		return;
+	FIntPoint Cell;
+	if (!Pickups->PickupCells.RemoveAndCopyValue(PickupIn, Cell))
+		return;
+	TArray<AGISPickupActor*, TInlineAllocator<4>>& CellPickups = Pickups->Grid.FindChecked(Cell);
+	CellPickups.RemoveSwap(PickupIn);
+	if (CellPickups.Num() == 0)
+	{
+		Pickups->Grid.Remove(Cell);
+	}
+}
+
+void FGISPickupRegistry::UpdatePickup(class AGISPickupActor* PickupIn)
+{
+	UnregisterPickup(PickupIn);
+	RegisterPickup(PickupIn);
+}
+
+class AGISPickupActor* FGISPickupRegistry::FindNearestWithLoot(UWorld* WorldIn, const FVector& LocationIn, float RadiusIn)
+{
+	const GISPickupRegistry::FWorldPickups* Pickups = GISPickupRegistry::Worlds.Find(WorldIn);
+	if (!Pickups)
+		return nullptr;
+	AGISPickupActor* Nearest = nullptr;
+	float NearestDistSq = RadiusIn * RadiusIn;
+	GISPickupRegistry::ForEachInCells(*Pickups, LocationIn, RadiusIn, [&](AGISPickupActor* PickupIn)
+	{
+		if (PickupIn->ItemToLoot.Num() == 0 || PickupIn->IsPendingKill())
+			return;
+		const float DistSq = FVector::DistSquared(LocationIn, PickupIn->GetActorLocation());
+		if (DistSq <= NearestDistSq)
+		{
+			NearestDistSq = DistSq;
+			Nearest = PickupIn;
+		}
+	});
+	return Nearest;
+}
+
+void FGISPickupRegistry::FindInRadius(UWorld* WorldIn, const FVector& LocationIn, float RadiusIn,
+	TArray<class AGISPickupActor*>& PickupsOut)
+{
+	const GISPickupRegistry::FWorldPickups* Pickups = GISPickupRegistry::Worlds.Find(WorldIn);
+	if (!Pickups)
+		return;
+	const float RadiusSq = RadiusIn * RadiusIn;
+	GISPickupRegistry::ForEachInCells(*Pickups, LocationIn, RadiusIn, [&](AGISPickupActor* PickupIn)
+	{
+		if (!PickupIn->IsPendingKill() && FVector::DistSquared(LocationIn, PickupIn->GetActorLocation()) <= RadiusSq)
+		{
+			PickupsOut.Add(PickupIn);
+		}
+	});
+}
+
+void FGISPickupRegistry::WatchRange(AActor* LooterIn, class AGISPickupActor* PickupIn, float MaxDistanceIn,
+	FGISOnPickupOutOfRange OutOfRangeIn)
+{
+	if (!LooterIn || !PickupIn || !LooterIn->GetWorld())
+		return;
+	StopWatchingRange(LooterIn);
+	GISPickupRegistry::FRangeWatch Watch;
+	Watch.Looter = LooterIn;
+	Watch.Pickup = PickupIn;
+	Watch.MaxDistanceSq = MaxDistanceIn * MaxDistanceIn;
+	Watch.OutOfRange = OutOfRangeIn;
+	GISPickupRegistry::Worlds.FindOrAdd(LooterIn->GetWorld()).Watches.Add(Watch);
+}
+
+void FGISPickupRegistry::StopWatchingRange(AActor* LooterIn)
+{
+	if (!LooterIn)
+		return;
+	GISPickupRegistry::FWorldPickups* Pickups = GISPickupRegistry::Worlds.Find(LooterIn->GetWorld());
+	if (!Pickups)
+		return;
+	Pickups->Watches.RemoveAllSwap([LooterIn](const GISPickupRegistry::FRangeWatch& WatchIn)
+	{
+		return WatchIn.Looter.Get() == LooterIn;
+	});
+}
+
+int32 FGISPickupRegistry::GetNumPickups(UWorld* WorldIn)
+{
+	const GISPickupRegistry::FWorldPickups* Pickups = GISPickupRegistry::Worlds.Find(WorldIn);
+	return Pickups ? Pickups->PickupCells.Num() : 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+DECLARE_DELEGATE(FGISOnPickupOutOfRange);
+
+/*
+	Per world registry of pickup actors, in uniform grid (GIS.Pickup.CellSize), so finding pickups
+	around player cost depends on pickups nearby, not on all pickups in world.
+	Pickups register themselves on BeginPlay, and are expected not to move. If they do, call
+	UpdatePickup.
+
+	Range watches replace per frame distance checks while looting. Every GIS.Pickup.RangeCheckInterval
+	all watches in world are checked, and OutOfRange is called once, when looter is too far from
+	pickup (or either of them is gone). Watch is removed after that.
+*/
+class GAMEINVENTORYSYSTEM_API FGISPickupRegistry
+{
+public:
+	/* Called by module. */
+	static void Startup();
+	static void Shutdown();
+
+	static void RegisterPickup(class AGISPickupActor* PickupIn);
+	static void UnregisterPickup(class AGISPickupActor* PickupIn);
+	static void UpdatePickup(class AGISPickupActor* PickupIn);
+
+	/* @return Closest pickup with any items to loot within radius, or nullptr. */
+	static class AGISPickupActor* FindNearestWithLoot(UWorld* WorldIn, const FVector& LocationIn, float RadiusIn);
+	static void FindInRadius(UWorld* WorldIn, const FVector& LocationIn, float RadiusIn,
+		TArray<class AGISPickupActor*>& PickupsOut);
+
+	/* Only one watch per looter. Starting new one replaces old. */
+	static void WatchRange(AActor* LooterIn, class AGISPickupActor* PickupIn, float MaxDistanceIn,
+		FGISOnPickupOutOfRange OutOfRangeIn);
+	static void StopWatchingRange(AActor* LooterIn);
+
+	static int32 GetNumPickups(UWorld* WorldIn);
+};
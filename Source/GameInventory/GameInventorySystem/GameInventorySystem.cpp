@@ -2,6 +2,7 @@
 #pragma once
 #include "GameInventorySystem.h"
 #include "IGameInventorySystem.h"
+#include "GISPickupRegistry.h"
 
 
 class FGameInventorySystem : public IGameInventorySystem
@@ -18,6 +19,7 @@ IMPLEMENT_GAME_MODULE( FGameInventorySystem, GameInventorySystem )
 void FGameInventorySystem::StartupModule()
 {
 	// This code will execute after your module is loaded into memory (but after global variables are initialized, of course.)
+	FGISPickupRegistry::Startup();
 }
 
 
@@ -25,6 +27,7 @@ void FGameInventorySystem::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FGISPickupRegistry::Shutdown();
 }
 
 
@@ -0,0 +1,71 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "../GameInventorySystem.h"
+#include "GITestWorld.h"
+#include "../GISItemData.h"
+#include "../GISInventoryBaseComponent.h"
+#if WITH_EDITOR
+
+/* Inventory with untagged tabs, so every tab accepts every item. */
+static UGISInventoryBaseComponent* CreateInventory(AActor* OwnerIn, int32 NumTabsIn, int32 NumSlotsIn)
+{
+	UGISInventoryBaseComponent* Inventory = NewObject<UGISInventoryBaseComponent>(OwnerIn);
+	for (int32 Idx = 0; Idx < NumTabsIn; Idx++)
+	{
+		FGISInventoryTabConfig TabConfig;
+		TabConfig.bIsTabActive = true;
+		TabConfig.NumberOfSlots = NumSlotsIn;
+		Inventory->InventoryConfiguration.InventoryConfig.TabConfigs.Add(TabConfig);
+	}
+	//registering initializes tabs, since owner is already initialized.
+	Inventory->RegisterComponent();
+	return Inventory;
+}
+
+static UGISItemData* AddItem(UGISInventoryBaseComponent* InventoryIn)
+{
+	UGISItemData* Item = NewObject<UGISItemData>(InventoryIn);
+	InventoryIn->AddItemToInventory(Item);
+	return Item;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGISFindFreeSlotAfterRemoveTest, "GameInventory.Inventory.FindFreeSlotAfterRemove", GI_TEST_FLAGS)
+bool FGISFindFreeSlotAfterRemoveTest::RunTest(const FString& Parameters)
+{
+	FGITestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	const int32 NumSlots = 3;
+	AActor* Owner = World->SpawnActor<AActor>();
+	UGISInventoryBaseComponent* Inventory = CreateInventory(Owner, 2, NumSlots);
+	FGISInventoryTab& Tabs = Inventory->Tabs;
+
+	TArray<UGISItemData*> Items;
+	for (int32 Idx = 0; Idx < NumSlots; Idx++)
+	{
+		Items.Add(AddItem(Inventory));
+	}
+	TestTrue(TEXT("Items fill first tab in slot order"), Tabs.GetItemData(0, 0) == Items[0]
+		&& Tabs.GetItemData(0, 1) == Items[1] && Tabs.GetItemData(0, 2) == Items[2]);
+	TestTrue(TEXT("Full tab has no free slot"), Tabs.FindFreeSlot(0) == INDEX_NONE);
+
+	//class is already cached, next accepting tab is used.
+	UGISItemData* Overflow = AddItem(Inventory);
+	TestTrue(TEXT("Item goes to next accepting tab when first is full"), Tabs.GetItemData(1, 0) == Overflow);
+	TestTrue(TEXT("Free slot in second tab moves past added item"), Tabs.FindFreeSlot(1) == 1);
+
+	Inventory->RemoveItem(Tabs.InventoryTabs[0].TabSlots[1]);
+	TestTrue(TEXT("Removed item slot is empty"), Tabs.GetItemData(0, 1) == nullptr);
+	TestTrue(TEXT("Removed item slot is free"), Tabs.FindFreeSlot(0) == 1);
+	TestTrue(TEXT("Item count is updated"), Tabs.InventoryTabs[0].ItemCount == NumSlots - 1);
+
+	UGISItemData* Refill = AddItem(Inventory);
+	TestTrue(TEXT("Next item goes to freed slot of first tab"), Tabs.GetItemData(0, 1) == Refill);
+	TestTrue(TEXT("Refilled tab has no free slot"), Tabs.FindFreeSlot(0) == INDEX_NONE);
+	TestTrue(TEXT("Second tab is not touched"), Tabs.FindFreeSlot(1) == 1);
+
+	World->DestroyActor(Owner);
+	return true;
+}
+
+#endif
@@ -83,18 +83,9 @@ bool UGSActiveActionsComponent::ReplicateSubobjects(class UActorChannel *Channel
 {
 	bool WroteSomething = Super::ReplicateSubobjects(Channel, Bunch, RepFlags);
 
-	if (CurrentLeftHandWeapon)
-	{
-		WroteSomething |= Channel->ReplicateSubobject(const_cast<UGSItemWeaponInfo*>(CurrentLeftHandWeapon), *Bunch, *RepFlags);
-	}
-	if (CurrentRightHandWeapon)
-	{
-		WroteSomething |= Channel->ReplicateSubobject(const_cast<UGSItemWeaponInfo*>(CurrentRightHandWeapon), *Bunch, *RepFlags);
-	}
-	if (CurrentAbility)
-	{
-		WroteSomething |= Channel->ReplicateSubobject(const_cast<UGSAbilityInfo*>(CurrentAbility), *Bunch, *RepFlags);
-	}
+	WroteSomething |= ReplicateItem(Channel, Bunch, RepFlags, CurrentLeftHandWeapon);
+	WroteSomething |= ReplicateItem(Channel, Bunch, RepFlags, CurrentRightHandWeapon);
+	WroteSomething |= ReplicateItem(Channel, Bunch, RepFlags, CurrentAbility);
 	return WroteSomething;
 }
 void UGSActiveActionsComponent::OnRep_CurrentLeftHandWeapon()
@@ -159,7 +150,7 @@ void UGSActiveActionsComponent::SwapWeapon(int32& LastCopiedIndex, class UGSItem
 				//we need to delay setting up current weapon pointer, or rather activating weapon, until equiping is finished.
 				CurrentWeapon = Cast<UGSItemWeaponInfo>(OtherInventory->GetItemDataInSlot(OtherTabIndex, LastCopiedIndex));
 
-				Tabs.InventoryTabs[TargetTabIndex].TabSlots[TargetSlotIndex].ItemData = OtherInventory->GetItemDataInSlot(OtherTabIndex, LastCopiedIndex);
+				SetItemDataInSlot(TargetTabIndex, TargetSlotIndex, OtherInventory->GetItemDataInSlot(OtherTabIndex, LastCopiedIndex));
 				if (Tabs.InventoryTabs[TargetTabIndex].TabSlots[TargetSlotIndex].ItemData)
 				{
 					Tabs.InventoryTabs[TargetTabIndex].TabSlots[TargetSlotIndex].ItemData->CurrentInventory = this;
@@ -242,7 +233,7 @@ class UGSItemWeaponInfo*& LastOppositeWeapon, int32 OppositeTabIndexIn, int32 Cu
 		//and we then we null current right weapon so it no longer going to be accessible
 		//as it should not be equiped to hand.
 		LastOppositeWeapon = CurrentOppositeWeapon;
-		Tabs.InventoryTabs[OppositeTabIndexIn].TabSlots[0].ItemData = nullptr;
+		SetItemDataInSlot(OppositeTabIndexIn, 0, nullptr);
 		CurrentOppositeWeapon = nullptr;
 	}
 	/*
@@ -260,7 +251,7 @@ class UGSItemWeaponInfo*& LastOppositeWeapon, int32 OppositeTabIndexIn, int32 Cu
 		if (CurrentOppositeWeapon->GetWeaponWield() == EGSWeaponWield::TwoHands)
 		{
 			LastOppositeWeapon = CurrentOppositeWeapon;
-			Tabs.InventoryTabs[OppositeTabIndexIn].TabSlots[0].ItemData = nullptr;
+			SetItemDataInSlot(OppositeTabIndexIn, 0, nullptr);
 			CurrentOppositeWeapon = nullptr;
 		}
 	}
@@ -297,6 +288,7 @@ void UGSActiveActionsComponent::SetWeaponFrom(class UGISInventoryBaseComponent*
 					CurrentLeftHandWeapon->CurrentHand = EGSWeaponHand::BothHands;
 				else
 					CurrentLeftHandWeapon->CurrentHand = EGSWeaponHand::Left;
+				CurrentLeftHandWeapon->MarkItemDirty();
 
 				//TODO:: Refactor.
 				UGSItemWeaponRangedInfo* leftWeap = Cast<UGSItemWeaponRangedInfo>(CurrentLeftHandWeapon);
@@ -315,6 +307,7 @@ void UGSActiveActionsComponent::SetWeaponFrom(class UGISInventoryBaseComponent*
 					CurrentRightHandWeapon->CurrentHand = EGSWeaponHand::BothHands;
 				else
 					CurrentRightHandWeapon->CurrentHand = EGSWeaponHand::Right;
+				CurrentRightHandWeapon->MarkItemDirty();
 
 				FinishSwappingWeapons(CurrentRightHandWeapon, CurrentLeftHandWeapon, LastLeftHandWeapon, 1, 2);
 			}
@@ -878,7 +871,7 @@ void UGSActiveActionsComponent::OnWeaponEquipingEnded(UAnimMontage* Montage, boo
 {
 	if (bInterrupted)
 		return;
-	Tabs.InventoryTabs[1].TabSlots[0].ItemData = CurrentLeftHandWeapon;
+	SetItemDataInSlot(1, 0, CurrentLeftHandWeapon);
 }
 
 void UGSActiveActionsComponent::InputReloadWeapon(int32 TabIndex, int32 SlotIndex)
@@ -1011,7 +1004,7 @@ void UGSActiveActionsComponent::SetAbility(class UGISInventoryBaseComponent* Oth
 			return;
 		//update tab
 		CurrentAbility = Cast<UGSAbilityInfo>(OtherIn->GetItemDataInSlot(OtherTabIndex, OtherSlotIndex));
-		Tabs.InventoryTabs[0].TabSlots[0].ItemData = CurrentAbility;
+		SetItemDataInSlot(0, 0, CurrentAbility);
 
 		//if (CurrentAbility)
 		//	CurrentAbility->GetOnSetWeaponsForAbility().Broadcast(CurrentLeftHandWeapon, CurrentRightHandWeapon);
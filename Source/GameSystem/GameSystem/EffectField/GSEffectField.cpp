@@ -5,9 +5,10 @@
 #include "IGAAbilities.h"
 #include "IGSEffectField.h"
 
-#include "GAAbilitiesComponent.h"
+#include "Effects/GABlueprintLibrary.h"
 
 #include "GSEffectField.h"
+#include "GSEffectFieldManager.h"
 
 AGSEffectField::AGSEffectField(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
@@ -15,33 +16,12 @@ AGSEffectField::AGSEffectField(const FObjectInitializer& ObjectInitializer)
 	bReplicates = true;
 	OverlapingActorCount = 0;
 
-	//since there is possibility that there are quite a few of these actors at once in world
-	//I probabaly should tick them by default..
+	MaximumTargets = 0;
+	ApplyPeriod = 1;
+	NextApplyTime = 0;
 
-	Attributes = ObjectInitializer.CreateDefaultSubobject<UGAAbilitiesComponent>(this, TEXT("Attributes"));
-
-	PrimaryActorTick.bCanEverTick = true;
-	PrimaryActorTick.bStartWithTickEnabled = false;
-	PrimaryActorTick.bRunOnAnyThread = true;
-	PrimaryActorTick.bAllowTickOnDedicatedServer = true;
-	PrimaryActorTick.TickGroup = TG_DuringPhysics;
-}
-
-void AGSEffectField::Tick(float DeltaSeconds)
-{
-	Super::Tick(DeltaSeconds);
-
-	//CurrentLifetime += DeltaSeconds;
-	////if lifetime is less than zero, it means that this actor should
-	////live until manually removed from world.
-	//if ((LifeTime > 0) && (CurrentLifetime > LifeTime))
-	//{
-	//	DestroyField();
-	//}
-	//for (auto It = OverlapingActors.CreateIterator(); It; ++It)
-	//{
-	//	OnActorHit(OverlapingActors[It.GetIndex()]);
-	//}
+	//actors inside field are found by FGSEffectFieldManager, field itself doesn't need to tick.
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 void AGSEffectField::PreInitializeComponents()
@@ -84,6 +64,12 @@ void AGSEffectField::PreInitializeComponents()
 	//RootComponent->SetRelativeLocation(ActorLocation);
 }
 
+void AGSEffectField::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FGSEffectFieldManager::UnregisterField(this);
+	Super::EndPlay(EndPlayReason);
+}
+
 void AGSEffectField::BeginDestroy()
 {
 	FieldInt = nullptr;
@@ -97,25 +83,24 @@ void AGSEffectField::InitializeEffectField()
 	if (!primComp)
 		return;
 	primComp->OnComponentHit.AddDynamic(this, &AGSEffectField::OnFieldHit);
-	primComp->OnComponentBeginOverlap.AddDynamic(this, &AGSEffectField::OnFieldBeginOverlap);
-	primComp->OnComponentEndOverlap.AddDynamic(this, &AGSEffectField::OnFieldEndOverlap);
+	//overlaps are found by FGSEffectFieldManager.
+	primComp->bGenerateOverlapEvents = false;
+	FGSEffectFieldManager::RegisterField(this);
+
+	if (LifeTime > 0 && !bIsInfinite)
+	{
+		SetLifeSpan(LifeTime);
+	}
 
 	if (!EffectFieldInstigator)
 		return;
 
 	FieldInt = Cast<IIGSEffectField>(EffectFieldInstigator);
-
-	if (LifeTime > 0)
-	{
-		SetActorTickEnabled(true); //effect life is above 0 so we probabaly want to tick it anyway.
-
-		//permament fields probabaly don't need to tick, if they do, enable it explictly.
-	}
 }
 
 void AGSEffectField::DestroyField()
 {
-
+	Destroy();
 }
 
 void AGSEffectField::BP_DestroyField()
@@ -128,36 +113,62 @@ void AGSEffectField::OnFieldHit(UPrimitiveComponent* HitComponent, AActor* Other
 	float test = 1;
 }
 
-void AGSEffectField::OnFieldBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AGSEffectField::UpdateOverlapingActors(const TArray<AActor*>& ActorsIn, float TimeIn)
 {
-	/*
-		Check if other actor is field.
-	*/
-	if (AGSEffectField* otherField = Cast<AGSEffectField>(OtherActor))
+	if (MaximumTargets > 0 && ActorsIn.Num() > MaximumTargets)
 	{
-		OnOtherFieldOverlap(otherField);
-		return; //if it fire event, and return. Nothing to do here.
+		//first come, first serve. Actors already affected keep their place.
+		TArray<AActor*> Kept;
+		for (AActor* Actor : ActorsIn)
+		{
+			if (OverlapingActors.Contains(Actor))
+				Kept.Add(Actor);
+		}
+		for (int32 Idx = 0; Idx < ActorsIn.Num() && Kept.Num() < MaximumTargets; Idx++)
+		{
+			Kept.AddUnique(ActorsIn[Idx]);
+		}
+		Kept.SetNum(FMath::Min(Kept.Num(), MaximumTargets));
+		OverlapingActors = Kept;
 	}
-	/*
-		If actor doesn't have tags, then we probabaly can't affect it ?
-
-		Maybe better check it against attributes ? Like if it have attribute component
-		then we probabaly can do something about it.
-	*/
-	IIGAAbilities* attrInt = Cast<IIGAAbilities>(OtherActor);
-	if (attrInt)
+	else
 	{
-		OverlapingActorCount += OverlapingActors.AddUnique(OtherActor); //pretty much always should be 1
-		//OverlapingActors.Add(OtherActor);
+		OverlapingActors = ActorsIn;
+	}
+	OverlapingActorCount = OverlapingActors.Num();
+
+	if (TimeIn < NextApplyTime)
+		return;
+	NextApplyTime = TimeIn + ApplyPeriod;
+	for (AActor* Actor : OverlapingActors)
+	{
+		ApplyFieldToActor(Actor);
 	}
-	float test = 1;
 }
 
+void AGSEffectField::UpdateOverlapingFields(const TArray<AGSEffectField*>& FieldsIn)
+{
+	OverlapingFields.RemoveAll([&](const TWeakObjectPtr<AGSEffectField>& Field)
+	{
+		return !Field.IsValid() || !FieldsIn.Contains(Field.Get());
+	});
+	for (AGSEffectField* Field : FieldsIn)
+	{
+		if (!OverlapingFields.Contains(Field))
+		{
+			OverlapingFields.Add(Field);
+			OnOtherFieldOverlap(Field);
+		}
+	}
+}
 
-void AGSEffectField::OnFieldEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+void AGSEffectField::ApplyFieldToActor(AActor* ActorIn)
 {
-	OverlapingActorCount -= OverlapingActors.Remove(OtherActor);//pretty much always should be 1
-	float test = 1;
+	if (FieldEffect)
+	{
+		UGABlueprintLibrary::ApplyGameEffectToActorFromClass(FieldEffect, FGAEffectHandle(), ActorIn, Instigator, this);
+	}
+	OnActorHit(ActorIn);
 }
 
 void AGSEffectField::OnOtherFieldOverlap(AGSEffectField* OtherField)
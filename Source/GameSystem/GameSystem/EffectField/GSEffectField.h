@@ -22,13 +22,10 @@ class GAMESYSTEM_API AGSEffectField : public AActor, public IGameplayTagAssetInt
 {
 	GENERATED_UCLASS_BODY()
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Attributes")
-	class UGAAbilitiesComponent* Attributes;
-
-	virtual void Tick(float DeltaSeconds) override;
-
 	virtual void PreInitializeComponents() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void BeginDestroy() override;
 
 	/*
@@ -55,6 +52,15 @@ class GAMESYSTEM_API AGSEffectField : public AActor, public IGameplayTagAssetInt
 	UPROPERTY(BlueprintReadWrite, meta = (ExposeOnSpawn), Category = "Info")
 		int32 MaximumTargets;
 
+	/**
+	 *	Effect applied to every actor inside field, every ApplyPeriod.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ExposeOnSpawn), Category = "Effect")
+		TSubclassOf<class UGAGameEffectSpec> FieldEffect;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ExposeOnSpawn), Category = "Effect")
+		float ApplyPeriod;
+
 	/**
 	 *	Size of field if:
 	 *	1. Box - normal rules applu.
@@ -106,11 +112,20 @@ public:
 	UFUNCTION()
 		void OnFieldHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
-	UFUNCTION()
-		void OnFieldBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	/*
+		Called by FGSEffectFieldManager with actors, which are currently inside field.
+	*/
+	void UpdateOverlapingActors(const TArray<AActor*>& ActorsIn, float TimeIn);
 
-	UFUNCTION()
-		void OnFieldEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+	/*
+		Called by FGSEffectFieldManager with fields, which are currently overlapping this one.
+	*/
+	void UpdateOverlapingFields(const TArray<AGSEffectField*>& FieldsIn);
+
+	/*
+		Applies FieldEffect to actor. Called for every actor in OverlapingActors, every ApplyPeriod.
+	*/
+	virtual void ApplyFieldToActor(AActor* ActorIn);
 
 	/*
 		Called for every actor in OverlapingActors
@@ -140,6 +155,8 @@ public:
 private:
 	class IIGSEffectField* FieldInt;
 	int32 OverlapingActorCount;
+	float NextApplyTime;
+	TArray<TWeakObjectPtr<AGSEffectField>> OverlapingFields;
 
 	int32 CurrentLifetime;
 };
@@ -0,0 +1,333 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "GameSystem.h"
+
+#include "GameplayTagAssetInterface.h"
+#include "IGAAbilities.h"
+
+#include "GSEffectField.h"
+#include "GSEffectFieldManager.h"
+
+static TAutoConsoleVariable<float> CVarEffectFieldUpdateInterval(
+	TEXT("GS.EffectField.UpdateInterval"),
+	0.1f,
+	TEXT("How often actors inside effect fields are updated (seconds)."));
+
+static TAutoConsoleVariable<float> CVarEffectFieldCellSize(
+	TEXT("GS.EffectField.CellSize"),
+	1000.0f,
+	TEXT("Size of grid cell used to find effect fields around actors."));
+
+namespace GSEffectFieldManager
+{
+	enum class EShapeType : uint8
+	{
+		Box,
+		Sphere,
+		Capsule
+	};
+	/* Shape of field root component, in world space. */
+	struct FFieldShape
+	{
+		EShapeType Type;
+		FVector Center;
+		FQuat InvRotation;
+		/* Box extent, or radius in X and half height in Z. */
+		FVector Extent;
+		FBox Bounds;
+
+		/*
+			Checks if upright capsule (pawn collision) touches shape. Box is tested against
+			box around capsule, sphere and capsule are exact.
+		*/
+		bool Overlaps(const FVector& LocationIn, float RadiusIn, float HalfHeightIn) const
+		{
+			const FVector Local = InvRotation.RotateVector(LocationIn - Center);
+			const FVector Up = InvRotation.RotateVector(FVector::UpVector);
+			const float PawnAxisHalf = FMath::Max(HalfHeightIn - RadiusIn, 0.f);
+			switch (Type)
+			{
+			case EShapeType::Box:
+			{
+				const FVector PawnExtent = Up.GetAbs() * PawnAxisHalf + FVector(RadiusIn);
+				return FMath::Abs(Local.X) <= Extent.X + PawnExtent.X && FMath::Abs(Local.Y) <= Extent.Y + PawnExtent.Y
+					&& FMath::Abs(Local.Z) <= Extent.Z + PawnExtent.Z;
+			}
+			case EShapeType::Sphere:
+			{
+				const float MaxDist = Extent.X + RadiusIn;
+				const float DistSq = FMath::PointDistToSegmentSquared(FVector::ZeroVector,
+					Local - Up * PawnAxisHalf, Local + Up * PawnAxisHalf);
+				return DistSq <= MaxDist * MaxDist;
+			}
+			case EShapeType::Capsule:
+			{
+				const float AxisHalf = FMath::Max(Extent.Z - Extent.X, 0.f);
+				const float MaxDist = Extent.X + RadiusIn;
+				FVector OnPawn, OnField;
+				FMath::SegmentDistToSegmentSafe(Local - Up * PawnAxisHalf, Local + Up * PawnAxisHalf,
+					FVector(0, 0, -AxisHalf), FVector(0, 0, AxisHalf), OnPawn, OnField);
+				return FVector::DistSquared(OnPawn, OnField) <= MaxDist * MaxDist;
+			}
+			}
+			return false;
+		}
+	};
+	struct FWorldFields
+	{
+		TArray<TWeakObjectPtr<AGSEffectField>> Fields;
+		float NextUpdateTime;
+		/* Fields put into grid by last update. Grid and Shapes are indexed the same way. */
+		TArray<TWeakObjectPtr<AGSEffectField>> GridFields;
+		TArray<FFieldShape> Shapes;
+		TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>> Grid;
+		float CellSize;
+
+		FWorldFields()
+			: NextUpdateTime(0),
+			CellSize(1)
+		{}
+	};
+	static TMap<UWorld*, FWorldFields> Worlds;
+	static FDelegateHandle PostActorTickHandle;
+	static FDelegateHandle WorldCleanupHandle;
+
+	static bool MakeShape(AGSEffectField* FieldIn, FFieldShape& ShapeOut)
+	{
+		USceneComponent* Root = FieldIn->GetRootComponent();
+		if (!Root)
+			return false;
+		ShapeOut.Center = Root->GetComponentLocation();
+		ShapeOut.InvRotation = Root->GetComponentQuat().Inverse();
+		ShapeOut.Bounds = Root->Bounds.GetBox();
+		if (UBoxComponent* Box = Cast<UBoxComponent>(Root))
+		{
+			ShapeOut.Type = EShapeType::Box;
+			ShapeOut.Extent = Box->GetScaledBoxExtent();
+		}
+		else if (USphereComponent* Sphere = Cast<USphereComponent>(Root))
+		{
+			ShapeOut.Type = EShapeType::Sphere;
+			ShapeOut.Extent = FVector(Sphere->GetScaledSphereRadius(), 0, 0);
+		}
+		else if (UCapsuleComponent* Capsule = Cast<UCapsuleComponent>(Root))
+		{
+			ShapeOut.Type = EShapeType::Capsule;
+			ShapeOut.Extent = FVector(Capsule->GetScaledCapsuleRadius(), 0, Capsule->GetScaledCapsuleHalfHeight());
+		}
+		else
+		{
+			//anything else is approximated by it's bounds.
+			ShapeOut.Type = EShapeType::Box;
+			ShapeOut.Center = ShapeOut.Bounds.GetCenter();
+			ShapeOut.InvRotation = FQuat::Identity;
+			ShapeOut.Extent = ShapeOut.Bounds.GetExtent();
+		}
+		return true;
+	}
+	static inline FIntPoint GetCell(const FVector& LocationIn, float CellSizeIn)
+	{
+		return FIntPoint(FMath::FloorToInt(LocationIn.X / CellSizeIn), FMath::FloorToInt(LocationIn.Y / CellSizeIn));
+	}
+	/* Indices of fields in grid, which upright capsule overlaps. */
+	static void FindOverlapping(const FWorldFields& FieldsIn, const FVector& LocationIn, float RadiusIn,
+		float HalfHeightIn, TArray<int32, TInlineAllocator<8>>& FieldsOut)
+	{
+		FieldsOut.Reset();
+		//capsule can reach into neighbour cells.
+		const FIntPoint Min = GetCell(LocationIn - FVector(RadiusIn), FieldsIn.CellSize);
+		const FIntPoint Max = GetCell(LocationIn + FVector(RadiusIn), FieldsIn.CellSize);
+		for (int32 X = Min.X; X <= Max.X; X++)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+			{
+				const TArray<int32, TInlineAllocator<4>>* Cell = FieldsIn.Grid.Find(FIntPoint(X, Y));
+				if (!Cell)
+					continue;
+				for (int32 FieldIdx : *Cell)
+				{
+					if (!FieldsOut.Contains(FieldIdx) && FieldsIn.Shapes[FieldIdx].Overlaps(LocationIn, RadiusIn, HalfHeightIn))
+					{
+						FieldsOut.Add(FieldIdx);
+					}
+				}
+			}
+		}
+	}
+	static bool CanAffect(AGSEffectField* FieldIn, AActor* ActorIn)
+	{
+		if (FieldIn->RequiredTags.Num() == 0)
+			return true;
+		IGameplayTagAssetInterface* TagInt = Cast<IGameplayTagAssetInterface>(ActorIn);
+		if (!TagInt)
+			return false;
+		FGameplayTagContainer OwnedTags;
+		TagInt->GetOwnedGameplayTags(OwnedTags);
+		return OwnedTags.HasAll(FieldIn->RequiredTags);
+	}
+	static void OnPostActorTick(UWorld* WorldIn, ELevelTick TickTypeIn, float DeltaTimeIn)
+	{
+		FWorldFields* Fields = Worlds.Find(WorldIn);
+		if (!Fields || WorldIn->GetTimeSeconds() < Fields->NextUpdateTime)
+			return;
+		Fields->NextUpdateTime = WorldIn->GetTimeSeconds() + CVarEffectFieldUpdateInterval.GetValueOnGameThread();
+		FGSEffectFieldManager::UpdateFields(WorldIn);
+	}
+	static void OnWorldCleanup(UWorld* WorldIn, bool bSessionEnded, bool bCleanupResources)
+	{
+		Worlds.Remove(WorldIn);
+	}
+}
+
+void FGSEffectFieldManager::Startup()
+{
+	GSEffectFieldManager::PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(
+		&GSEffectFieldManager::OnPostActorTick);
+	GSEffectFieldManager::WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(
+		&GSEffectFieldManager::OnWorldCleanup);
+}
+void FGSEffectFieldManager::Shutdown()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(GSEffectFieldManager::PostActorTickHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(GSEffectFieldManager::WorldCleanupHandle);
+	GSEffectFieldManager::Worlds.Empty();
+}
+
+void FGSEffectFieldManager::RegisterField(class AGSEffectField* FieldIn)
+{
+	if (!FieldIn || !FieldIn->GetWorld() || FieldIn->GetWorld()->GetNetMode() == NM_Client)
+		return;
+	GSEffectFieldManager::Worlds.FindOrAdd(FieldIn->GetWorld()).Fields.AddUnique(FieldIn);
+}
+
+void FGSEffectFieldManager::UnregisterField(class AGSEffectField* FieldIn)
+{
+	if (!FieldIn)
+		return;
+	GSEffectFieldManager::FWorldFields* Fields = GSEffectFieldManager::Worlds.Find(FieldIn->GetWorld());
+	if (Fields)
+	{
+		Fields->Fields.RemoveSwap(FieldIn);
+	}
+}
+
+void FGSEffectFieldManager::UpdateFields(UWorld* WorldIn)
+{
+	GSEffectFieldManager::FWorldFields* WorldFields = GSEffectFieldManager::Worlds.Find(WorldIn);
+	if (!WorldFields)
+		return;
+
+	//gather fields and their shapes, and put them into grid.
+	const float CellSize = FMath::Max(CVarEffectFieldCellSize.GetValueOnGameThread(), 1.f);
+	TArray<TWeakObjectPtr<AGSEffectField>>& Fields = WorldFields->GridFields;
+	TArray<GSEffectFieldManager::FFieldShape>& Shapes = WorldFields->Shapes;
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>>& Grid = WorldFields->Grid;
+	WorldFields->CellSize = CellSize;
+	Fields.Reset(WorldFields->Fields.Num());
+	Shapes.Reset(WorldFields->Fields.Num());
+	Grid.Reset();
+	for (int32 Idx = WorldFields->Fields.Num() - 1; Idx >= 0; Idx--)
+	{
+		AGSEffectField* Field = WorldFields->Fields[Idx].Get();
+		if (!Field || Field->IsPendingKill())
+		{
+			WorldFields->Fields.RemoveAtSwap(Idx, 1, false);
+			continue;
+		}
+		GSEffectFieldManager::FFieldShape Shape;
+		if (!GSEffectFieldManager::MakeShape(Field, Shape))
+			continue;
+		const int32 FieldIdx = Fields.Add(Field);
+		Shapes.Add(Shape);
+		const FIntPoint Min = GSEffectFieldManager::GetCell(Shape.Bounds.Min, CellSize);
+		const FIntPoint Max = GSEffectFieldManager::GetCell(Shape.Bounds.Max, CellSize);
+		for (int32 X = Min.X; X <= Max.X; X++)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+			{
+				Grid.FindOrAdd(FIntPoint(X, Y)).Add(FieldIdx);
+			}
+		}
+	}
+	if (Fields.Num() == 0)
+		return;
+
+	//find actors inside fields.
+	TArray<TArray<AActor*>> Inside;
+	Inside.AddDefaulted(Fields.Num());
+	TArray<int32, TInlineAllocator<8>> Overlapping;
+	for (FConstPawnIterator It = WorldIn->GetPawnIterator(); It; ++It)
+	{
+		APawn* Pawn = It->Get();
+		if (!Pawn || Pawn->IsPendingKill() || !Cast<IIGAAbilities>(Pawn))
+			continue;
+		float Radius = 0;
+		float HalfHeight = 0;
+		Pawn->GetSimpleCollisionCylinder(Radius, HalfHeight);
+		GSEffectFieldManager::FindOverlapping(*WorldFields, Pawn->GetActorLocation(), Radius, HalfHeight, Overlapping);
+		for (int32 FieldIdx : Overlapping)
+		{
+			AGSEffectField* Field = Fields[FieldIdx].Get();
+			if (Field && GSEffectFieldManager::CanAffect(Field, Pawn))
+			{
+				Inside[FieldIdx].Add(Pawn);
+			}
+		}
+	}
+
+	const float Time = WorldIn->GetTimeSeconds();
+	TArray<AGSEffectField*> OtherFields;
+	for (int32 FieldIdx = 0; FieldIdx < Fields.Num(); FieldIdx++)
+	{
+		//effects applied to actors, might have destroyed field.
+		AGSEffectField* Field = Fields[FieldIdx].Get();
+		if (!Field)
+			continue;
+		Field->UpdateOverlapingActors(Inside[FieldIdx], Time);
+
+		//fields overlap, when their bounds do.
+		OtherFields.Reset();
+		const FBox& Bounds = Shapes[FieldIdx].Bounds;
+		const FIntPoint Min = GSEffectFieldManager::GetCell(Bounds.Min, CellSize);
+		const FIntPoint Max = GSEffectFieldManager::GetCell(Bounds.Max, CellSize);
+		for (int32 X = Min.X; X <= Max.X; X++)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+			{
+				for (int32 OtherIdx : Grid.FindChecked(FIntPoint(X, Y)))
+				{
+					AGSEffectField* Other = Fields[OtherIdx].Get();
+					if (Other && OtherIdx != FieldIdx && Bounds.Intersect(Shapes[OtherIdx].Bounds))
+					{
+						OtherFields.AddUnique(Other);
+					}
+				}
+			}
+		}
+		Field->UpdateOverlapingFields(OtherFields);
+	}
+}
+
+void FGSEffectFieldManager::FindFieldsAt(UWorld* WorldIn, const FVector& LocationIn, float RadiusIn, float HalfHeightIn,
+	TArray<class AGSEffectField*>& FieldsOut)
+{
+	const GSEffectFieldManager::FWorldFields* WorldFields = GSEffectFieldManager::Worlds.Find(WorldIn);
+	if (!WorldFields)
+		return;
+	TArray<int32, TInlineAllocator<8>> Overlapping;
+	GSEffectFieldManager::FindOverlapping(*WorldFields, LocationIn, RadiusIn, HalfHeightIn, Overlapping);
+	for (int32 FieldIdx : Overlapping)
+	{
+		AGSEffectField* Field = WorldFields->GridFields[FieldIdx].Get();
+		if (Field && !Field->IsPendingKill())
+		{
+			FieldsOut.Add(Field);
+		}
+	}
+}
+
+int32 FGSEffectFieldManager::GetNumFields(UWorld* WorldIn)
+{
+	const GSEffectFieldManager::FWorldFields* Fields = GSEffectFieldManager::Worlds.Find(WorldIn);
+	return Fields ? Fields->Fields.Num() : 0;
+}
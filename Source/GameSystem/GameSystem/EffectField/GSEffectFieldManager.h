@@ -0,0 +1,30 @@
+#pragma once
+
+/*
+	Finds actors inside effect fields, instead of per field overlap events.
+	Every GS.EffectField.UpdateInterval all fields in world are put into uniform grid
+	(GS.EffectField.CellSize), and collision capsule of every pawn implementing IIGAAbilities is
+	tested only against fields from cells it touches. Fields get their OverlapingActors updated, and apply their effect
+	trough AGSEffectField::ApplyFieldToActor.
+
+	Fields affect actors only on server.
+*/
+class GAMESYSTEM_API FGSEffectFieldManager
+{
+public:
+	/* Called by module. */
+	static void Startup();
+	static void Shutdown();
+
+	static void RegisterField(class AGSEffectField* FieldIn);
+	static void UnregisterField(class AGSEffectField* FieldIn);
+
+	/* Runs single pass over all fields in world. Called automatically every update interval. */
+	static void UpdateFields(UWorld* WorldIn);
+
+	/* Fields, which upright capsule at location overlaps. Uses grid from last update. */
+	static void FindFieldsAt(UWorld* WorldIn, const FVector& LocationIn, float RadiusIn, float HalfHeightIn,
+		TArray<class AGSEffectField*>& FieldsOut);
+
+	static int32 GetNumFields(UWorld* WorldIn);
+};
@@ -2,6 +2,8 @@
 #pragma once
 #include "GameSystem.h"
 #include "IGameSystem.h"
+#include "EffectField/GSEffectFieldManager.h"
+#include "Weapons/GSWeaponActorPool.h"
 
 
 
@@ -19,6 +21,8 @@ IMPLEMENT_MODULE( FGameSystem, GameSystem )
 void FGameSystem::StartupModule()
 {
 	// This code will execute after your module is loaded into memory (but after global variables are initialized, of course.)
+	FGSEffectFieldManager::Startup();
+	FGSWeaponActorPool::Startup();
 }
 
 
@@ -26,6 +30,8 @@ void FGameSystem::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FGSEffectFieldManager::Shutdown();
+	FGSWeaponActorPool::Shutdown();
 }
 
 
@@ -6,6 +6,7 @@
 #include "GSEquipmentComponent.h"
 #include "../Weapons/GSWeaponEquipmentComponent.h"
 #include "../Weapons/GSWeaponRanged.h"
+#include "../Weapons/GSWeaponActorPool.h"
 #include "../Components/GSActiveActionsComponent.h"
 #include "Net/UnrealNetwork.h"
 
@@ -72,10 +73,13 @@ bool UGSItemWeaponInfo::OnItemAddedToSlot()
 	{
 		if (UGSWeaponEquipmentComponent* eqComp = Cast<UGSWeaponEquipmentComponent>(CurrentInventory))
 		{
-			ActiveWeapon = GetWorld()->SpawnActor<AGSWeaponRanged>(Weapon);
-			ActiveWeapon->SetOwner(OwningPawn);
-			ActiveWeapon->Instigator = OwningPawn;
-			ActiveWeapon->WeaponPC = OwiningPlayerController;
+			//weapon moved between equipment slots keeps it's actor.
+			if (!ActiveWeapon)
+			{
+				ActiveWeapon = FGSWeaponActorPool::Acquire(GetWorld(), Weapon, OwningPawn, OwiningPlayerController);
+				if (!ActiveWeapon)
+					return false;
+			}
 			ActiveWeapon->InitializeWeapon();
 			eqComp->AttachActorTo(ActiveWeapon, LastAttachedSocket, ActiveWeapon->SocketList);
 		}
@@ -110,7 +114,8 @@ bool UGSItemWeaponInfo::OnItemRemovedFromSlot()
 				}
 			}
 			LastAttachedSocket = NAME_Name;
-			ActiveWeapon->Destroy();
+			FGSWeaponActorPool::Release(ActiveWeapon);
+			ActiveWeapon = nullptr;
 		}
 		return true;
 	}
@@ -6,6 +6,7 @@
 #include "GSEquipmentComponent.h"
 #include "../Weapons/GSWeaponEquipmentComponent.h"
 #include "../Weapons/GSWeaponRanged.h"
+#include "../Weapons/GSWeaponActorPool.h"
 #include "../Components/GSActiveActionsComponent.h"
 #include "Net/UnrealNetwork.h"
 
@@ -203,17 +204,19 @@ bool UGSItemWeaponRangedInfo::OnItemAddedToSlot()
 	{
 		if (UGSWeaponEquipmentComponent* eqComp = Cast<UGSWeaponEquipmentComponent>(CurrentInventory))
 		{
-			RangedWeapon = GetWorld()->SpawnActor<AGSWeaponRanged>(RangedWeaponClass);
-			RangedWeapon->SetOwner(OwningPawn);
-			RangedWeapon->Instigator = OwningPawn;
-			RangedWeapon->WeaponPC = OwiningPlayerController;
-
-			//we will use wepon defaults if it zero.
-			if (RemainingAmmoMagazine != 0)
-				RangedWeapon->SetRemainingMagazineAmmo(RemainingAmmoMagazine);
-			if (RemainingAmmoTotal != 0)
-				RangedWeapon->SetRemaningAmmofloat(RemainingAmmoTotal);
+			//weapon moved between equipment slots keeps it's actor, and ammo.
+			if (!RangedWeapon)
+			{
+				RangedWeapon = FGSWeaponActorPool::Acquire(GetWorld(), RangedWeaponClass, OwningPawn, OwiningPlayerController);
+				if (!RangedWeapon)
+					return false;
 
+				//we will use wepon defaults if it zero.
+				if (RemainingAmmoMagazine != 0)
+					RangedWeapon->SetRemainingMagazineAmmo(RemainingAmmoMagazine);
+				if (RemainingAmmoTotal != 0)
+					RangedWeapon->SetRemaningAmmofloat(RemainingAmmoTotal);
+			}
 			RangedWeapon->InitializeWeapon();
 			eqComp->AttachActorTo(RangedWeapon, LastAttachedSocket, RangedWeapon->SocketList);
 		}
@@ -250,7 +253,8 @@ bool UGSItemWeaponRangedInfo::OnItemRemovedFromSlot()
 			LastAttachedSocket = NAME_Name;
 			RemainingAmmoMagazine = RangedWeapon->GetRemainingMagazineAmmo();
 			RemainingAmmoTotal = RangedWeapon->GetRemaningAmmo();
-			RangedWeapon->Destroy();
+			FGSWeaponActorPool::Release(RangedWeapon);
+			RangedWeapon = nullptr;
 		}
 		return true;
 	}
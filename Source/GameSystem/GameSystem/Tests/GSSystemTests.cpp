@@ -0,0 +1,56 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "../GameSystem.h"
+#include "GITestWorld.h"
+#include "../EffectField/GSEffectField.h"
+#include "../EffectField/GSEffectFieldManager.h"
+#if WITH_EDITOR
+
+template<typename ShapeType>
+static AGSEffectField* SpawnField(UWorld* WorldIn, const FVector& LocationIn)
+{
+	AGSEffectField* Field = WorldIn->SpawnActor<AGSEffectField>();
+	ShapeType* Shape = NewObject<ShapeType>(Field);
+	Field->SetRootComponent(Shape);
+	Shape->RegisterComponent();
+	Field->SetActorLocation(LocationIn);
+	FGSEffectFieldManager::RegisterField(Field);
+	return Field;
+}
+
+static bool IsInField(AGSEffectField* FieldIn, const FVector& LocationIn, float RadiusIn, float HalfHeightIn)
+{
+	TArray<AGSEffectField*> Fields;
+	FGSEffectFieldManager::FindFieldsAt(FieldIn->GetWorld(), LocationIn, RadiusIn, HalfHeightIn, Fields);
+	return Fields.Contains(FieldIn);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGSEffectFieldGridQueryTest, "GameSystem.System.EffectFieldGridQuery", GI_TEST_FLAGS)
+bool FGSEffectFieldGridQueryTest::RunTest(const FString& Parameters)
+{
+	FGITestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	const float CellSize = IConsoleManager::Get().FindConsoleVariable(TEXT("GS.EffectField.CellSize"))->GetFloat();
+	AGSEffectField* BoxField = SpawnField<UBoxComponent>(World, FVector::ZeroVector);
+	Cast<UBoxComponent>(BoxField->GetRootComponent())->SetBoxExtent(FVector(100));
+	AGSEffectField* EdgeField = SpawnField<UBoxComponent>(World, FVector(CellSize + 50, 0, 0));
+	Cast<UBoxComponent>(EdgeField->GetRootComponent())->SetBoxExtent(FVector(40));
+	AGSEffectField* SphereField = SpawnField<USphereComponent>(World, FVector(0, CellSize * 2, 0));
+	Cast<USphereComponent>(SphereField->GetRootComponent())->SetSphereRadius(100);
+	FGSEffectFieldManager::UpdateFields(World);
+
+	TestTrue(TEXT("Centre inside box"), IsInField(BoxField, FVector(50, 0, 0), 0, 0));
+	TestTrue(TEXT("Capsule touching box, with centre outside"), IsInField(BoxField, FVector(150, 0, 0), 60, 90));
+	TestFalse(TEXT("Capsule away from box"), IsInField(BoxField, FVector(300, 0, 0), 60, 90));
+	TestTrue(TEXT("Capsule reaching field in neighbour cell"), IsInField(EdgeField, FVector(CellSize - 10, 0, 0), 30, 90));
+	TestTrue(TEXT("Capsule standing on sphere"), IsInField(SphereField, FVector(0, CellSize * 2, 180), 40, 100));
+	TestFalse(TEXT("Capsule above sphere"), IsInField(SphereField, FVector(0, CellSize * 2, 300), 40, 100));
+
+	BoxField->Destroy();
+	EdgeField->Destroy();
+	SphereField->Destroy();
+	return true;
+}
+
+#endif
@@ -0,0 +1,114 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "GameSystem.h"
+#include "GSWeaponRanged.h"
+#include "GSWeaponActorPool.h"
+
+namespace GSWeaponActorPool
+{
+	struct FWorldPool
+	{
+		TMap<UClass*, TArray<TWeakObjectPtr<AGSWeaponRanged>>> FreeWeapons;
+		TArray<TWeakObjectPtr<AGSWeaponRanged>> ActiveWeapons;
+	};
+	static TMap<UWorld*, FWorldPool> Pools;
+	static FDelegateHandle WorldCleanupHandle;
+
+	static bool CanHaveWeapons(UWorld* WorldIn)
+	{
+		return WorldIn && WorldIn->IsGameWorld() && WorldIn->GetNetMode() != NM_Client;
+	}
+	static void OnWorldCleanup(UWorld* WorldIn, bool bSessionEnded, bool bCleanupResources)
+	{
+		Pools.Remove(WorldIn);
+	}
+}
+
+void FGSWeaponActorPool::Startup()
+{
+	GSWeaponActorPool::WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(
+		&GSWeaponActorPool::OnWorldCleanup);
+}
+void FGSWeaponActorPool::Shutdown()
+{
+	FWorldDelegates::OnWorldCleanup.Remove(GSWeaponActorPool::WorldCleanupHandle);
+	GSWeaponActorPool::Pools.Empty();
+}
+
+AGSWeaponRanged* FGSWeaponActorPool::Acquire(UWorld* WorldIn, TSubclassOf<class AGSWeaponRanged> ClassIn,
+	APawn* OwnerIn, APlayerController* PCIn)
+{
+	if (!ClassIn || !GSWeaponActorPool::CanHaveWeapons(WorldIn))
+	{
+		return nullptr;
+	}
+	GSWeaponActorPool::FWorldPool& Pool = GSWeaponActorPool::Pools.FindOrAdd(WorldIn);
+	//weapons destroyed while handed out (ie. with level), are forgotten here.
+	Pool.ActiveWeapons.RemoveAllSwap([](const TWeakObjectPtr<AGSWeaponRanged>& WeaponIn)
+	{
+		return !WeaponIn.IsValid() || WeaponIn->IsPendingKill();
+	});
+	AGSWeaponRanged* Weapon = nullptr;
+	TArray<TWeakObjectPtr<AGSWeaponRanged>>& FreeWeapons = Pool.FreeWeapons.FindOrAdd(ClassIn);
+	while (!Weapon && FreeWeapons.Num() > 0)
+	{
+		//weapons might have been destroyed with level.
+		Weapon = FreeWeapons.Pop(false).Get();
+		if (Weapon && Weapon->IsPendingKill())
+		{
+			Weapon = nullptr;
+		}
+	}
+	if (Weapon)
+	{
+		Weapon->SetOwner(OwnerIn);
+		Weapon->Instigator = OwnerIn;
+		Weapon->WeaponPC = PCIn;
+		Weapon->OnAcquiredFromPool();
+	}
+	else
+	{
+		Weapon = WorldIn->SpawnActor<AGSWeaponRanged>(ClassIn);
+		if (!Weapon)
+		{
+			return nullptr;
+		}
+		Weapon->SetOwner(OwnerIn);
+		Weapon->Instigator = OwnerIn;
+		Weapon->WeaponPC = PCIn;
+	}
+	Pool.ActiveWeapons.Add(Weapon);
+	return Weapon;
+}
+
+void FGSWeaponActorPool::Release(class AGSWeaponRanged* WeaponIn)
+{
+	if (!WeaponIn)
+	{
+		return;
+	}
+	GSWeaponActorPool::FWorldPool* Pool = GSWeaponActorPool::Pools.Find(WeaponIn->GetWorld());
+	if (!Pool || Pool->ActiveWeapons.RemoveSwap(WeaponIn) == 0)
+	{
+		//not handed out by pool, or already released.
+		return;
+	}
+	WeaponIn->OnReleasedToPool();
+	WeaponIn->SetOwner(nullptr);
+	WeaponIn->Instigator = nullptr;
+	WeaponIn->WeaponPC = nullptr;
+	Pool->FreeWeapons.FindOrAdd(WeaponIn->GetClass()).Add(WeaponIn);
+}
+
+int32 FGSWeaponActorPool::GetNumFree(UWorld* WorldIn, TSubclassOf<class AGSWeaponRanged> ClassIn)
+{
+	GSWeaponActorPool::FWorldPool* Pool = GSWeaponActorPool::Pools.Find(WorldIn);
+	const TArray<TWeakObjectPtr<AGSWeaponRanged>>* FreeWeapons = Pool ? Pool->FreeWeapons.Find(ClassIn) : nullptr;
+	return FreeWeapons ? FreeWeapons->Num() : 0;
+}
+
+int32 FGSWeaponActorPool::GetNumActive(UWorld* WorldIn)
+{
+	GSWeaponActorPool::FWorldPool* Pool = GSWeaponActorPool::Pools.Find(WorldIn);
+	return Pool ? Pool->ActiveWeapons.Num() : 0;
+}
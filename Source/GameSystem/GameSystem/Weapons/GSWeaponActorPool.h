@@ -0,0 +1,28 @@
+#pragma once
+
+/*
+	Per world pool of AGSWeaponRanged, by weapon class.
+	Weapons unequipped from weapon equipment are not destroyed, but detached, hidden and put to
+	net dormancy, so clients keep their actor channel instead of closing and opening it again
+	on every weapon swap. Reacquired weapons are reset (ammo, spread, state) before they are
+	handed out. Weapons are taken back only trough Release(), by item which holds them, so
+	pool never takes weapon from under it's item.
+
+	Weapons are replicated, so pool exists only on server (and standalone).
+*/
+class GAMESYSTEM_API FGSWeaponActorPool
+{
+public:
+	/* Called by module. */
+	static void Startup();
+	static void Shutdown();
+
+	/* Returns free weapon of class, or spawns new one if there is none. */
+	static class AGSWeaponRanged* Acquire(UWorld* WorldIn, TSubclassOf<class AGSWeaponRanged> ClassIn,
+		APawn* OwnerIn, APlayerController* PCIn);
+	/* Does nothing for weapons, which are not currently handed out by pool. */
+	static void Release(class AGSWeaponRanged* WeaponIn);
+
+	static int32 GetNumFree(UWorld* WorldIn, TSubclassOf<class AGSWeaponRanged> ClassIn);
+	static int32 GetNumActive(UWorld* WorldIn);
+};
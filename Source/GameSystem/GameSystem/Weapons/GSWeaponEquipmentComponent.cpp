@@ -147,14 +147,8 @@ bool UGSWeaponEquipmentComponent::ReplicateSubobjects(class UActorChannel *Chann
 {
 	bool WroteSomething = Super::ReplicateSubobjects(Channel, Bunch, RepFlags);
 
-	if (MainHandWeapon)
-	{
-		WroteSomething |= Channel->ReplicateSubobject(const_cast<UGSItemWeaponInfo*>(MainHandWeapon), *Bunch, *RepFlags);
-	}
-	if (OffHandWeapon)
-	{
-		WroteSomething |= Channel->ReplicateSubobject(const_cast<UGSItemWeaponInfo*>(OffHandWeapon), *Bunch, *RepFlags);
-	}
+	WroteSomething |= ReplicateItem(Channel, Bunch, RepFlags, MainHandWeapon);
+	WroteSomething |= ReplicateItem(Channel, Bunch, RepFlags, OffHandWeapon);
 
 	return WroteSomething;
 }
@@ -663,6 +657,11 @@ void UGSWeaponEquipmentComponent::SimulateSwapWeaponSet()
 			{
 				WeaponEquipState = EGSWeaponEquipState::Invalid;
 			}
+			//CurrentHand is replicated.
+			if (MainHandWeapon)
+				MainHandWeapon->MarkItemDirty();
+			if (OffHandWeapon)
+				OffHandWeapon->MarkItemDirty();
 			if (LeftWeaponWidget)
 				LeftWeaponWidget->CurrentWeapon = MainHandWeapon;
 
@@ -8,3 +8,21 @@ AGSWeaponRanged::AGSWeaponRanged(const FObjectInitializer& ObjectInitializer)
 {
 	WeaponType = EGSWeaponType::MainHand;
 }
+
+void AGSWeaponRanged::OnAcquiredFromPool()
+{
+	SetNetDormancy(DORM_Awake);
+	ResetWeapon();
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(PrimaryActorTick.bStartWithTickEnabled);
+}
+void AGSWeaponRanged::OnReleasedToPool()
+{
+	//stop firing, reloading etc, before anything else.
+	ResetWeapon();
+	DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	SetActorHiddenInGame(true);
+	SetActorTickEnabled(false);
+	//holstered weapons don't change, so there is nothing to replicate until reacquired.
+	SetNetDormancy(DORM_DormantAll);
+}
@@ -68,6 +68,10 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Socket Attachments")
 		TArray<FGSWeaponSocketInfo> SocketList;
 
+	/* Called by FGSWeaponActorPool. */
+	void OnAcquiredFromPool();
+	void OnReleasedToPool();
+
 	/*
 		move equiping logic here in form of interface
 		1. Weapon know of it's type.
@@ -0,0 +1,222 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "GameTrace.h"
+#include "DrawDebugHelpers.h"
+#include "GTAsyncTraceService.h"
+
+bool FGTTraceRequest::IsSameTrace(const FGTTraceRequest& Other) const
+{
+	return Start == Other.Start && End == Other.End
+		&& ObjectParams.GetQueryBitfield() == Other.ObjectParams.GetQueryBitfield()
+		&& Channel == Other.Channel && IgnoredActor == Other.IgnoredActor
+		&& bReturnPhysicalMaterial == Other.bReturnPhysicalMaterial;
+}
+
+namespace GTAsyncTraceService
+{
+	struct FPendingTrace
+	{
+		FGTTraceRequest Request;
+		TArray<FGTTraceResultDelegate, TInlineAllocator<2>> Callbacks;
+	};
+	struct FWorldTraces
+	{
+		TArray<FPendingTrace> Queued;
+		/* Submitted traces, by id passed to engine as user data. */
+		TMap<uint32, FPendingTrace> InFlight;
+		uint32 NextId;
+
+		FWorldTraces()
+			: NextId(0)
+		{}
+	};
+	/* Requests can come from actors ticking on worker threads. */
+	static FCriticalSection Lock;
+	static TMap<UWorld*, FWorldTraces> Worlds;
+	static FTraceDelegate TraceDoneDelegate;
+	static FDelegateHandle PostActorTickHandle;
+	static FDelegateHandle WorldCleanupHandle;
+
+	struct FBatch
+	{
+		TArray<FHitResult> Results;
+		int32 NumRemaining;
+		FGTTraceBatchResultDelegate OnBatchDone;
+	};
+	static void OnBatchTraceDone(const FHitResult& HitIn, TSharedRef<FBatch, ESPMode::ThreadSafe> BatchIn, int32 IndexIn)
+	{
+		//results are delivered on game thread only.
+		BatchIn->Results[IndexIn] = HitIn;
+		if (--BatchIn->NumRemaining == 0)
+		{
+			BatchIn->OnBatchDone.ExecuteIfBound(BatchIn->Results);
+		}
+	}
+
+	static void OnTraceDone(const FTraceHandle& HandleIn, FTraceDatum& DatumIn)
+	{
+		UWorld* World = DatumIn.PhysWorld.Get();
+		FPendingTrace Trace;
+		{
+			FScopeLock ScopeLock(&Lock);
+			FWorldTraces* Traces = Worlds.Find(World);
+			if (!Traces || !Traces->InFlight.RemoveAndCopyValue(DatumIn.UserData, Trace))
+			{
+				return;
+			}
+		}
+		FHitResult Hit(ForceInit);
+		for (const FHitResult& OutHit : DatumIn.OutHits)
+		{
+			if (OutHit.bBlockingHit)
+			{
+				Hit = OutHit;
+				break;
+			}
+		}
+		Hit.TraceStart = Trace.Request.Start;
+		Hit.TraceEnd = Trace.Request.End;
+		if (Trace.Request.bDrawDebug && World)
+		{
+			if (Hit.bBlockingHit)
+			{
+				::DrawDebugLine(World, Hit.TraceStart, Hit.ImpactPoint, FColor::Red, false, 2);
+				::DrawDebugLine(World, Hit.ImpactPoint, Hit.TraceEnd, FColor::Green, false, 2);
+				::DrawDebugPoint(World, Hit.ImpactPoint, 7, FColor::Red, false, 2);
+			}
+			else
+			{
+				::DrawDebugLine(World, Hit.TraceStart, Hit.TraceEnd, FColor::Green, false, 2);
+			}
+		}
+		for (const FGTTraceResultDelegate& Callback : Trace.Callbacks)
+		{
+			Callback.ExecuteIfBound(Hit);
+		}
+	}
+	static void OnPostActorTick(UWorld* WorldIn, ELevelTick TickTypeIn, float DeltaTimeIn)
+	{
+		FGTAsyncTraceService::Flush(WorldIn);
+	}
+	static void OnWorldCleanup(UWorld* WorldIn, bool bSessionEnded, bool bCleanupResources)
+	{
+		FScopeLock ScopeLock(&Lock);
+		Worlds.Remove(WorldIn);
+	}
+}
+
+void FGTAsyncTraceService::Startup()
+{
+	GTAsyncTraceService::TraceDoneDelegate = FTraceDelegate::CreateStatic(&GTAsyncTraceService::OnTraceDone);
+	GTAsyncTraceService::PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(
+		&GTAsyncTraceService::OnPostActorTick);
+	GTAsyncTraceService::WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(
+		&GTAsyncTraceService::OnWorldCleanup);
+}
+void FGTAsyncTraceService::Shutdown()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(GTAsyncTraceService::PostActorTickHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(GTAsyncTraceService::WorldCleanupHandle);
+	FScopeLock ScopeLock(&GTAsyncTraceService::Lock);
+	GTAsyncTraceService::Worlds.Empty();
+}
+
+void FGTAsyncTraceService::RequestLineTrace(UWorld* WorldIn, const FGTTraceRequest& RequestIn,
+	const FGTTraceResultDelegate& OnTraceDoneIn)
+{
+	if (!WorldIn)
+	{
+		return;
+	}
+	FScopeLock ScopeLock(&GTAsyncTraceService::Lock);
+	TArray<GTAsyncTraceService::FPendingTrace>& Queued = GTAsyncTraceService::Worlds.FindOrAdd(WorldIn).Queued;
+	if (RequestIn.bCoalesce)
+	{
+		//only handful of traces per frame, so there is no need for anything smarter.
+		for (GTAsyncTraceService::FPendingTrace& Trace : Queued)
+		{
+			if (Trace.Request.bCoalesce && Trace.Request.IsSameTrace(RequestIn))
+			{
+				Trace.Callbacks.Add(OnTraceDoneIn);
+				return;
+			}
+		}
+	}
+	GTAsyncTraceService::FPendingTrace& Trace = Queued[Queued.AddDefaulted()];
+	Trace.Request = RequestIn;
+	Trace.Callbacks.Add(OnTraceDoneIn);
+}
+
+void FGTAsyncTraceService::RequestLineTraceBatch(UWorld* WorldIn, const TArray<FGTTraceRequest>& RequestsIn,
+	const FGTTraceBatchResultDelegate& OnBatchDoneIn)
+{
+	if (!WorldIn || RequestsIn.Num() == 0)
+	{
+		return;
+	}
+	TSharedRef<GTAsyncTraceService::FBatch, ESPMode::ThreadSafe> Batch = MakeShareable(new GTAsyncTraceService::FBatch());
+	Batch->Results.SetNum(RequestsIn.Num());
+	Batch->NumRemaining = RequestsIn.Num();
+	Batch->OnBatchDone = OnBatchDoneIn;
+	for (int32 Idx = 0; Idx < RequestsIn.Num(); Idx++)
+	{
+		RequestLineTrace(WorldIn, RequestsIn[Idx],
+			FGTTraceResultDelegate::CreateStatic(&GTAsyncTraceService::OnBatchTraceDone, Batch, Idx));
+	}
+}
+
+void FGTAsyncTraceService::Flush(UWorld* WorldIn)
+{
+	TArray<GTAsyncTraceService::FPendingTrace> Queued;
+	TArray<uint32> Ids;
+	{
+		FScopeLock ScopeLock(&GTAsyncTraceService::Lock);
+		GTAsyncTraceService::FWorldTraces* Traces = GTAsyncTraceService::Worlds.Find(WorldIn);
+		if (!Traces || Traces->Queued.Num() == 0)
+		{
+			return;
+		}
+		Exchange(Queued, Traces->Queued);
+		Ids.Reserve(Queued.Num());
+		for (GTAsyncTraceService::FPendingTrace& Trace : Queued)
+		{
+			const uint32 Id = Traces->NextId++;
+			Ids.Add(Id);
+			Traces->InFlight.Add(Id, Trace);
+		}
+	}
+	for (int32 Idx = 0; Idx < Queued.Num(); Idx++)
+	{
+		const FGTTraceRequest& Request = Queued[Idx].Request;
+		static const FName DefaultTag(TEXT("GTAsyncTrace"));
+		FCollisionQueryParams Params(Request.TraceTag.IsNone() ? DefaultTag : Request.TraceTag, false,
+			Request.IgnoredActor.Get());
+		Params.bTraceAsyncScene = false;
+		Params.bReturnPhysicalMaterial = Request.bReturnPhysicalMaterial;
+		if (Request.ObjectParams.IsValid())
+		{
+			WorldIn->AsyncLineTraceByObjectType(EAsyncTraceType::Single, Request.Start, Request.End,
+				Request.ObjectParams, Params, &GTAsyncTraceService::TraceDoneDelegate, Ids[Idx]);
+		}
+		else
+		{
+			WorldIn->AsyncLineTraceByChannel(EAsyncTraceType::Single, Request.Start, Request.End,
+				Request.Channel, Params, FCollisionResponseParams::DefaultResponseParam,
+				&GTAsyncTraceService::TraceDoneDelegate, Ids[Idx]);
+		}
+	}
+}
+
+int32 FGTAsyncTraceService::GetNumQueued(UWorld* WorldIn)
+{
+	FScopeLock ScopeLock(&GTAsyncTraceService::Lock);
+	const GTAsyncTraceService::FWorldTraces* Traces = GTAsyncTraceService::Worlds.Find(WorldIn);
+	return Traces ? Traces->Queued.Num() : 0;
+}
+
+int32 FGTAsyncTraceService::GetNumInFlight(UWorld* WorldIn)
+{
+	FScopeLock ScopeLock(&GTAsyncTraceService::Lock);
+	const GTAsyncTraceService::FWorldTraces* Traces = GTAsyncTraceService::Worlds.Find(WorldIn);
+	return Traces ? Traces->InFlight.Num() : 0;
+}
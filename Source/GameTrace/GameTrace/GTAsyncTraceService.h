@@ -0,0 +1,59 @@
+#pragma once
+
+DECLARE_DELEGATE_OneParam(FGTTraceResultDelegate, const FHitResult&);
+/* Results in the same order as requests. */
+DECLARE_DELEGATE_OneParam(FGTTraceBatchResultDelegate, const TArray<FHitResult>&);
+
+struct GAMETRACE_API FGTTraceRequest
+{
+	FVector Start;
+	FVector End;
+	/* If empty, trace is done against Channel. */
+	FCollisionObjectQueryParams ObjectParams;
+	TEnumAsByte<ECollisionChannel> Channel;
+	TWeakObjectPtr<AActor> IgnoredActor;
+	FName TraceTag;
+	bool bReturnPhysicalMaterial;
+	/* Identical requests made in the same frame share single trace. */
+	bool bCoalesce;
+	bool bDrawDebug;
+
+	FGTTraceRequest()
+		: Start(ForceInitToZero),
+		End(ForceInitToZero),
+		Channel(ECC_Visibility),
+		bReturnPhysicalMaterial(false),
+		bCoalesce(false),
+		bDrawDebug(false)
+	{}
+	bool IsSameTrace(const FGTTraceRequest& Other) const;
+};
+
+/*
+	Collects line traces requested during frame and submits them after actors ticked, trough
+	engine async traces, so they run in parallel with the rest of frame.
+	Results are delivered on game thread next frame. Miss is delivered as hit result without
+	blocking hit, with TraceStart and TraceEnd set.
+
+	Requests can be made from any thread.
+*/
+class GAMETRACE_API FGTAsyncTraceService
+{
+public:
+	/* Called by module. */
+	static void Startup();
+	static void Shutdown();
+
+	static void RequestLineTrace(UWorld* WorldIn, const FGTTraceRequest& RequestIn,
+		const FGTTraceResultDelegate& OnTraceDoneIn);
+	/* Submits all requests in the same frame, delegate is called once all of them are done. */
+	static void RequestLineTraceBatch(UWorld* WorldIn, const TArray<FGTTraceRequest>& RequestsIn,
+		const FGTTraceBatchResultDelegate& OnBatchDoneIn);
+	/* Submits queued traces. Called automatically after actors ticked. */
+	static void Flush(UWorld* WorldIn);
+
+	/* Number of distinct traces waiting for submission. */
+	static int32 GetNumQueued(UWorld* WorldIn);
+	/* Number of submitted traces, which results have not been delivered yet. */
+	static int32 GetNumInFlight(UWorld* WorldIn);
+};
@@ -2,6 +2,7 @@
 #pragma once
 #include "GameTrace.h"
 #include "IGameTrace.h"
+#include "GTAsyncTraceService.h"
 
 
 class FGameTrace : public IGameTrace
@@ -18,6 +19,7 @@ IMPLEMENT_MODULE( FGameTrace, GameTrace )
 void FGameTrace::StartupModule()
 {	
 	// This code will execute after your module is loaded into memory (but after global variables are initialized, of course.)
+	FGTAsyncTraceService::Startup();
 }
 
 
@@ -25,6 +27,7 @@ void FGameTrace::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FGTAsyncTraceService::Shutdown();
 }
 
 
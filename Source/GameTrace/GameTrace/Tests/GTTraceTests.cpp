@@ -0,0 +1,56 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "../GameTrace.h"
+#include "GITestWorld.h"
+#include "../GTAsyncTraceService.h"
+#if WITH_EDITOR
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGTAsyncTraceServiceTest, "GameTrace.Trace.AsyncTraceService", GI_TEST_FLAGS)
+bool FGTAsyncTraceServiceTest::RunTest(const FString& Parameters)
+{
+	FGITestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	FGTTraceRequest Request;
+	Request.Start = FVector(0, 0, 1000);
+	Request.End = FVector(0, 0, 2000);
+	Request.bCoalesce = true;
+	int32 NumResults = 0;
+	FVector ResultEnd = FVector::ZeroVector;
+	FGTTraceResultDelegate OnTraceDone = FGTTraceResultDelegate::CreateLambda([&](const FHitResult& HitIn)
+	{
+		NumResults++;
+		ResultEnd = HitIn.TraceEnd;
+	});
+	FGTAsyncTraceService::RequestLineTrace(World, Request, OnTraceDone);
+	FGTAsyncTraceService::RequestLineTrace(World, Request, OnTraceDone);
+	TestTrue(TEXT("Identical traces are coalesced"), FGTAsyncTraceService::GetNumQueued(World) == 1);
+	Request.End = FVector(0, 0, 3000);
+	FGTAsyncTraceService::RequestLineTrace(World, Request, OnTraceDone);
+	TestTrue(TEXT("Different trace is queued separately"), FGTAsyncTraceService::GetNumQueued(World) == 2);
+
+	TestWorld.Tick(0.03f);
+	TestTrue(TEXT("Every request received result"), NumResults == 3
+		&& FGTAsyncTraceService::GetNumQueued(World) == 0 && FGTAsyncTraceService::GetNumInFlight(World) == 0);
+	TestTrue(TEXT("Miss has trace end set"), ResultEnd == FVector(0, 0, 3000));
+
+	TArray<FGTTraceRequest> Batch;
+	for (int32 Idx = 0; Idx < 4; Idx++)
+	{
+		FGTTraceRequest& Pellet = Batch[Batch.AddDefaulted()];
+		Pellet.Start = FVector(0, 0, 1000);
+		Pellet.End = FVector(Idx * 100, 0, 2000);
+	}
+	TArray<FHitResult> BatchHits;
+	FGTAsyncTraceService::RequestLineTraceBatch(World, Batch, FGTTraceBatchResultDelegate::CreateLambda(
+		[&](const TArray<FHitResult>& HitsIn)
+	{
+		BatchHits = HitsIn;
+	}));
+	TestWorld.Tick(0.03f);
+	TestTrue(TEXT("Batch results are in request order"), BatchHits.Num() == 4
+		&& BatchHits[3].TraceEnd == FVector(300, 0, 2000));
+	return true;
+}
+
+#endif
@@ -0,0 +1,339 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "GameWeapons.h"
+#include "GWLagCompensation.h"
+
+static TAutoConsoleVariable<float> CVarLagCompMaxRewindTime(
+	TEXT("GW.LagComp.MaxRewindTime"),
+	0.5f,
+	TEXT("Hits are never validated against poses older than this (seconds)."));
+
+static TAutoConsoleVariable<float> CVarLagCompHitTolerance(
+	TEXT("GW.LagComp.HitTolerance"),
+	25.0f,
+	TEXT("How far from rewound pawn claimed shot can pass, and still be accepted."));
+
+static TAutoConsoleVariable<float> CVarLagCompMaxOriginError(
+	TEXT("GW.LagComp.MaxOriginError"),
+	300.0f,
+	TEXT("Max distance between claimed shot origin and shooter location."));
+
+FGWShotClaim::FGWShotClaim(const FHitResult& HitIn)
+	: Origin(HitIn.TraceStart),
+	End(HitIn.TraceEnd),
+	ImpactPoint(HitIn.ImpactPoint),
+	HitActor(HitIn.GetActor()),
+	ShotIndex(0)
+{}
+
+FHitResult FGWShotClaim::ToHitResult() const
+{
+	const FVector Dir = (End - Origin).GetSafeNormal();
+	FHitResult Hit(HitActor, nullptr, ImpactPoint, -Dir);
+	Hit.ImpactNormal = -Dir;
+	Hit.TraceStart = Origin;
+	Hit.TraceEnd = End;
+	Hit.Distance = FVector::Dist(Origin, ImpactPoint);
+	Hit.bBlockingHit = true;
+	return Hit;
+}
+
+float FGWPoseSample::GetDistanceToSegment(const FVector& StartIn, const FVector& EndIn, FVector& ClosestOut) const
+{
+	const FVector AxisOffset(0, 0, FMath::Max(HalfHeight - Radius, 0.f));
+	FVector OnAxis;
+	FMath::SegmentDistToSegmentSafe(StartIn, EndIn, Location - AxisOffset, Location + AxisOffset, ClosestOut, OnAxis);
+	return FVector::Dist(ClosestOut, OnAxis) - Radius;
+}
+
+FGWPoseSample FGWPoseSample::Lerp(const FGWPoseSample& A, const FGWPoseSample& B, float Alpha)
+{
+	//zero radius means pawn was not there in that frame.
+	if (A.Radius <= 0)
+		return B;
+	if (B.Radius <= 0)
+		return A;
+	return FGWPoseSample(FMath::Lerp(A.Location, B.Location, Alpha),
+		FMath::Lerp(A.Radius, B.Radius, Alpha), FMath::Lerp(A.HalfHeight, B.HalfHeight, Alpha));
+}
+
+namespace GWLagCompensation
+{
+	struct FFrame
+	{
+		float Time;
+		/* By pawn slot. */
+		TArray<FGWPoseSample> Poses;
+
+		FFrame()
+			: Time(0)
+		{}
+	};
+	struct FWorldHistory
+	{
+		FFrame Frames[FGWLagCompensation::HistorySize];
+		/* Index of frame, which will be written next. */
+		int32 Head;
+		int32 NumFrames;
+		TMap<TWeakObjectPtr<APawn>, int32> Slots;
+		TArray<int32> FreeSlots;
+		int32 NumSlots;
+
+		FWorldHistory()
+			: Head(0),
+			NumFrames(0),
+			NumSlots(0)
+		{}
+		/* 0 is newest frame. */
+		inline const FFrame& GetFrame(int32 AgeIn) const
+		{
+			return Frames[(Head - 1 - AgeIn + FGWLagCompensation::HistorySize) % FGWLagCompensation::HistorySize];
+		}
+	};
+	static TMap<UWorld*, FWorldHistory> Histories;
+	static FDelegateHandle PostActorTickHandle;
+	static FDelegateHandle WorldCleanupHandle;
+
+	static FGWPoseSample MakePose(APawn* PawnIn)
+	{
+		float Radius = 0;
+		float HalfHeight = 0;
+		PawnIn->GetSimpleCollisionCylinder(Radius, HalfHeight);
+		return FGWPoseSample(PawnIn->GetActorLocation(), FMath::Max(Radius, KINDA_SMALL_NUMBER), HalfHeight);
+	}
+	static inline const FGWPoseSample& GetPose(const FFrame& FrameIn, int32 SlotIn)
+	{
+		static const FGWPoseSample Missing;
+		return FrameIn.Poses.IsValidIndex(SlotIn) ? FrameIn.Poses[SlotIn] : Missing;
+	}
+	/* Finds two frames around time. Both are the same, if time is outside of history. */
+	static void FindFrames(const FWorldHistory& HistoryIn, float TimeIn, const FFrame*& OlderOut,
+		const FFrame*& NewerOut, float& AlphaOut)
+	{
+		OlderOut = &HistoryIn.GetFrame(0);
+		NewerOut = OlderOut;
+		AlphaOut = 0;
+		for (int32 Age = 1; Age < HistoryIn.NumFrames; Age++)
+		{
+			if (NewerOut->Time <= TimeIn)
+				break;
+			OlderOut = &HistoryIn.GetFrame(Age);
+			if (OlderOut->Time <= TimeIn)
+			{
+				const float Span = NewerOut->Time - OlderOut->Time;
+				AlphaOut = Span > 0 ? (TimeIn - OlderOut->Time) / Span : 0;
+				return;
+			}
+			NewerOut = OlderOut;
+		}
+		OlderOut = NewerOut;
+	}
+	/* Poses of all pawns at time, by slot. */
+	static void Rewind(const FWorldHistory& HistoryIn, float TimeIn, TArray<FGWPoseSample>& PosesOut)
+	{
+		PosesOut.Reset(HistoryIn.NumSlots);
+		if (HistoryIn.NumFrames == 0)
+			return;
+		const FFrame* Older = nullptr;
+		const FFrame* Newer = nullptr;
+		float Alpha = 0;
+		FindFrames(HistoryIn, TimeIn, Older, Newer, Alpha);
+		PosesOut.AddDefaulted(HistoryIn.NumSlots);
+		for (int32 Slot = 0; Slot < HistoryIn.NumSlots; Slot++)
+		{
+			PosesOut[Slot] = FGWPoseSample::Lerp(GetPose(*Older, Slot), GetPose(*Newer, Slot), Alpha);
+		}
+	}
+	static int32 AddSlot(FWorldHistory& HistoryIn, APawn* PawnIn)
+	{
+		int32 Slot = INDEX_NONE;
+		if (HistoryIn.FreeSlots.Num() > 0)
+		{
+			Slot = HistoryIn.FreeSlots.Pop(false);
+			//forget poses of previous owner of slot.
+			for (FFrame& Frame : HistoryIn.Frames)
+			{
+				if (Frame.Poses.IsValidIndex(Slot))
+				{
+					Frame.Poses[Slot] = FGWPoseSample();
+				}
+			}
+		}
+		else
+		{
+			Slot = HistoryIn.NumSlots++;
+		}
+		HistoryIn.Slots.Add(PawnIn, Slot);
+		return Slot;
+	}
+	/* True if world geometry is between claimed origin and impact point. */
+	static bool IsBlockedByWorld(UWorld* WorldIn, AActor* ShooterIn, const FGWShotClaim& ClaimIn, float ToleranceIn)
+	{
+		static const FName TraceTag(TEXT("GWLagCompensation"));
+		const FVector ToImpact = ClaimIn.ImpactPoint - ClaimIn.Origin;
+		const float Length = ToImpact.Size();
+		if (Length <= ToleranceIn)
+			return false;
+		//stop short of impact, so surface which was hit doesn't count.
+		const FVector End = ClaimIn.Origin + ToImpact * ((Length - ToleranceIn) / Length);
+		FCollisionQueryParams Params(TraceTag, false, ShooterIn);
+		Params.AddIgnoredActor(ClaimIn.HitActor);
+		return WorldIn->LineTraceTestByObjectType(ClaimIn.Origin, End,
+			FCollisionObjectQueryParams(FCollisionObjectQueryParams::AllStaticObjects), Params);
+	}
+	static void OnPostActorTick(UWorld* WorldIn, ELevelTick TickTypeIn, float DeltaTimeIn)
+	{
+		FGWLagCompensation::RecordFrame(WorldIn);
+	}
+	static void OnWorldCleanup(UWorld* WorldIn, bool bSessionEnded, bool bCleanupResources)
+	{
+		Histories.Remove(WorldIn);
+	}
+}
+
+void FGWLagCompensation::Startup()
+{
+	GWLagCompensation::PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddStatic(
+		&GWLagCompensation::OnPostActorTick);
+	GWLagCompensation::WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(
+		&GWLagCompensation::OnWorldCleanup);
+}
+void FGWLagCompensation::Shutdown()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(GWLagCompensation::PostActorTickHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(GWLagCompensation::WorldCleanupHandle);
+	GWLagCompensation::Histories.Empty();
+}
+
+void FGWLagCompensation::RecordFrame(UWorld* WorldIn)
+{
+	//only server validates hits.
+	if (!WorldIn || !WorldIn->IsGameWorld() || WorldIn->GetNetMode() == NM_Client)
+		return;
+
+	GWLagCompensation::FWorldHistory& History = GWLagCompensation::Histories.FindOrAdd(WorldIn);
+	for (auto It = History.Slots.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid() || It.Key()->IsPendingKill())
+		{
+			History.FreeSlots.Add(It.Value());
+			It.RemoveCurrent();
+		}
+	}
+
+	GWLagCompensation::FFrame& Frame = History.Frames[History.Head];
+	Frame.Time = WorldIn->GetTimeSeconds();
+	Frame.Poses.Reset();
+	Frame.Poses.AddDefaulted(History.NumSlots);
+	for (FConstPawnIterator It = WorldIn->GetPawnIterator(); It; ++It)
+	{
+		APawn* Pawn = It->Get();
+		if (!Pawn || Pawn->IsPendingKill())
+			continue;
+		const int32* SlotPtr = History.Slots.Find(Pawn);
+		const int32 Slot = SlotPtr ? *SlotPtr : GWLagCompensation::AddSlot(History, Pawn);
+		if (Slot >= Frame.Poses.Num())
+		{
+			Frame.Poses.AddDefaulted(Slot - Frame.Poses.Num() + 1);
+		}
+		Frame.Poses[Slot] = GWLagCompensation::MakePose(Pawn);
+	}
+	History.Head = (History.Head + 1) % HistorySize;
+	History.NumFrames = FMath::Min(History.NumFrames + 1, (int32)HistorySize);
+}
+
+bool FGWLagCompensation::GetPoseAtTime(APawn* PawnIn, float TimeIn, FGWPoseSample& PoseOut)
+{
+	if (!PawnIn)
+		return false;
+	const GWLagCompensation::FWorldHistory* History = GWLagCompensation::Histories.Find(PawnIn->GetWorld());
+	const int32* Slot = History ? History->Slots.Find(PawnIn) : nullptr;
+	if (!Slot || History->NumFrames == 0)
+		return false;
+	const GWLagCompensation::FFrame* Older = nullptr;
+	const GWLagCompensation::FFrame* Newer = nullptr;
+	float Alpha = 0;
+	GWLagCompensation::FindFrames(*History, TimeIn, Older, Newer, Alpha);
+	PoseOut = FGWPoseSample::Lerp(GWLagCompensation::GetPose(*Older, *Slot), GWLagCompensation::GetPose(*Newer, *Slot), Alpha);
+	return PoseOut.Radius > 0;
+}
+
+bool FGWLagCompensation::ValidateHit(AActor* ShooterIn, const FGWShotClaim& ClaimIn, float ShotTimeIn)
+{
+	if (!ShooterIn)
+		return false;
+	FGWRewoundPoses Poses;
+	Rewind(ShooterIn->GetWorld(), ShotTimeIn, Poses);
+	return ValidateHit(ShooterIn, ClaimIn, Poses);
+}
+
+bool FGWLagCompensation::ValidateHit(AActor* ShooterIn, const FGWShotClaim& ClaimIn, const FGWRewoundPoses& PosesIn)
+{
+	if (!ShooterIn || !ClaimIn.HitActor || ClaimIn.HitActor->IsPendingKill())
+		return false;
+	const float Tolerance = CVarLagCompHitTolerance.GetValueOnGameThread();
+	if (FVector::Dist(ClaimIn.Origin, ShooterIn->GetActorLocation()) > CVarLagCompMaxOriginError.GetValueOnGameThread())
+		return false;
+	if (FMath::PointDistToSegment(ClaimIn.ImpactPoint, ClaimIn.Origin, ClaimIn.End) > Tolerance)
+		return false;
+
+	UWorld* World = ShooterIn->GetWorld();
+	APawn* HitPawn = Cast<APawn>(ClaimIn.HitActor);
+	const GWLagCompensation::FWorldHistory* History = GWLagCompensation::Histories.Find(World);
+	const int32* HitSlot = (History && HitPawn) ? History->Slots.Find(HitPawn) : nullptr;
+	if (!HitSlot)
+	{
+		//not moving (or not tracked), just check if claimed point is on actor.
+		const FBox Bounds = ClaimIn.HitActor->GetComponentsBoundingBox(true).ExpandBy(Tolerance);
+		return Bounds.IsInside(ClaimIn.ImpactPoint)
+			&& !GWLagCompensation::IsBlockedByWorld(World, ShooterIn, ClaimIn, Tolerance);
+	}
+
+	const TArray<FGWPoseSample>& Poses = PosesIn.Poses;
+	//pawn tracked since rewind, is tested at current pose.
+	const FGWPoseSample HitPose = (Poses.IsValidIndex(*HitSlot) && Poses[*HitSlot].Radius > 0)
+		? Poses[*HitSlot] : GWLagCompensation::MakePose(HitPawn);
+
+	FVector ClaimedClosest;
+	if (HitPose.GetDistanceToSegment(ClaimIn.Origin, ClaimIn.End, ClaimedClosest) > Tolerance)
+		return false;
+
+	//shot must not have gone trough other pawn first.
+	const int32* ShooterSlot = History->Slots.Find(Cast<APawn>(ShooterIn));
+	const float ClaimedDistSq = FVector::DistSquared(ClaimIn.Origin, ClaimedClosest);
+	for (int32 Slot = 0; Slot < Poses.Num(); Slot++)
+	{
+		if (Slot == *HitSlot || (ShooterSlot && Slot == *ShooterSlot) || Poses[Slot].Radius <= 0)
+			continue;
+		FVector Closest;
+		if (Poses[Slot].GetDistanceToSegment(ClaimIn.Origin, ClaimIn.End, Closest) < -Tolerance
+			&& FVector::DistSquared(ClaimIn.Origin, Closest) < ClaimedDistSq)
+		{
+			return false;
+		}
+	}
+	//pawns are checked against history, world geometry doesn't move.
+	return !GWLagCompensation::IsBlockedByWorld(World, ShooterIn, ClaimIn, Tolerance);
+}
+
+void FGWLagCompensation::Rewind(UWorld* WorldIn, float ShotTimeIn, FGWRewoundPoses& PosesOut)
+{
+	PosesOut.Poses.Reset();
+	PosesOut.Time = ShotTimeIn;
+	const GWLagCompensation::FWorldHistory* History = WorldIn ? GWLagCompensation::Histories.Find(WorldIn) : nullptr;
+	if (!History)
+		return;
+	const float Now = WorldIn->GetTimeSeconds();
+	PosesOut.Time = FMath::Clamp(ShotTimeIn, Now - CVarLagCompMaxRewindTime.GetValueOnGameThread(), Now);
+	GWLagCompensation::Rewind(*History, PosesOut.Time, PosesOut.Poses);
+}
+
+int32 FGWLagCompensation::GetNumFrames(UWorld* WorldIn)
+{
+	const GWLagCompensation::FWorldHistory* History = GWLagCompensation::Histories.Find(WorldIn);
+	return History ? History->NumFrames : 0;
+}
+float FGWLagCompensation::GetMaxRewindTime()
+{
+	return CVarLagCompMaxRewindTime.GetValueOnGameThread();
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "GWLagCompensation.generated.h"
+
+/* Single hit claimed by client, sent to server for validation. */
+USTRUCT()
+struct GAMEWEAPONS_API FGWShotClaim
+{
+	GENERATED_USTRUCT_BODY()
+public:
+	UPROPERTY()
+		FVector_NetQuantize Origin;
+	UPROPERTY()
+		FVector_NetQuantize End;
+	UPROPERTY()
+		FVector_NetQuantize ImpactPoint;
+	UPROPERTY()
+		AActor* HitActor;
+	/* Index of shot in batch, which produced this hit. */
+	UPROPERTY()
+		uint8 ShotIndex;
+
+	FGWShotClaim()
+		: HitActor(nullptr),
+		ShotIndex(0)
+	{}
+	FGWShotClaim(const FHitResult& HitIn);
+
+	/* Hit result recreated on server, from accepted claim. */
+	FHitResult ToHitResult() const;
+};
+
+/* Collision relevant part of pawn transform. Pawns are treated as upright capsules. */
+struct GAMEWEAPONS_API FGWPoseSample
+{
+	FVector Location;
+	float Radius;
+	float HalfHeight;
+
+	FGWPoseSample()
+		: Location(ForceInitToZero),
+		Radius(0),
+		HalfHeight(0)
+	{}
+	FGWPoseSample(const FVector& LocationIn, float RadiusIn, float HalfHeightIn)
+		: Location(LocationIn),
+		Radius(RadiusIn),
+		HalfHeight(HalfHeightIn)
+	{}
+	/*
+		Distance from segment to capsule surface. Negative when segment goes trough capsule.
+		ClosestOut is point on segment closest to capsule axis.
+	*/
+	float GetDistanceToSegment(const FVector& StartIn, const FVector& EndIn, FVector& ClosestOut) const;
+	static FGWPoseSample Lerp(const FGWPoseSample& A, const FGWPoseSample& B, float Alpha);
+};
+
+/* Poses of all tracked pawns rewound to single time, by slot. Reused by every claim of the same shot. */
+struct GAMEWEAPONS_API FGWRewoundPoses
+{
+	/* Time poses were rewound to, after clamping. */
+	float Time;
+	TArray<FGWPoseSample> Poses;
+
+	FGWRewoundPoses()
+		: Time(0)
+	{}
+};
+
+/*
+	Server side history of pawn poses, used to validate hits claimed by clients.
+	After actors ticked, poses of all pawns in world are stored in fixed size ring buffer.
+	Every frame keeps poses of all pawns in single array, indexed by pawn slot, so rewinding
+	all pawns to given time only reads two arrays.
+
+	Claimed hit on pawn is accepted, if shot segment passes within GW.LagComp.HitTolerance from
+	pawn rewound to shot time, and line from shot origin to impact is not blocked by world geometry.
+	Shot time is clamped to GW.LagComp.MaxRewindTime.
+	Pawns without history (just spawned) are tested at their current pose.
+*/
+class GAMEWEAPONS_API FGWLagCompensation
+{
+public:
+	/* Number of frames kept in history. */
+	static const int32 HistorySize = 32;
+
+	/* Called by module. */
+	static void Startup();
+	static void Shutdown();
+
+	/* Stores current poses of all pawns. Called automatically after actors ticked on server. */
+	static void RecordFrame(UWorld* WorldIn);
+
+	/* Pose of pawn at time. Returns false if pawn is not tracked. */
+	static bool GetPoseAtTime(APawn* PawnIn, float TimeIn, FGWPoseSample& PoseOut);
+
+	/*
+		Re-runs claimed shot against poses at ShotTimeIn (server world time).
+		ShooterIn is used to check if shot origin is plausible.
+	*/
+	static bool ValidateHit(AActor* ShooterIn, const FGWShotClaim& ClaimIn, float ShotTimeIn);
+	/* The same as above, against poses already rewound by Rewind. */
+	static bool ValidateHit(AActor* ShooterIn, const FGWShotClaim& ClaimIn, const FGWRewoundPoses& PosesIn);
+	/* Rewinds all pawns in world to ShotTimeIn. PosesOut is reset, so it's memory can be reused. */
+	static void Rewind(UWorld* WorldIn, float ShotTimeIn, FGWRewoundPoses& PosesOut);
+
+	static int32 GetNumFrames(UWorld* WorldIn);
+	/* How far back shots can be validated (GW.LagComp.MaxRewindTime). */
+	static float GetMaxRewindTime();
+};
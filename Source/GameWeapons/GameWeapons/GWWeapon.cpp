@@ -95,6 +95,10 @@ void AGWWeapon::SetHitLocation(FVector StartLocation, FVector ImpactLocation)
 	HitInfo.Origin = StartLocation;
 	HitInfo.HitLocation = ImpactLocation;
 }
+void AGWWeapon::OnTargetDataReady()
+{
+	//no-op. Weapons which act on TargetData (ie. AGWWeaponRanged) override it.
+}
 void AGWWeapon::OnRep_HitInfo()
 {
 
@@ -92,6 +92,11 @@ public:
 		specific hit location, and update it every frame or every so often ;).
 	*/
 	void SetHitLocation(FVector StartLocation, FVector ImpactLocation);
+	/*
+		Called by targeting method, when asynchronous trace filled TargetData (next frame
+		after UGWTraceBase::Execute()). Does nothing by default, weapons which shoot override it.
+	*/
+	virtual void OnTargetDataReady();
 
 	virtual FVector GetTargetingSocketLocation();
 	virtual FVector GetWeaponSocketLocation();
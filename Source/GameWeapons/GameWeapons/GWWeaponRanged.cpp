@@ -10,6 +10,7 @@
 #include "IGISkeletalMesh.h"
 
 #include "Net/UnrealNetwork.h"
+#include "GameFramework/GameStateBase.h"
 
 #include "GWWeaponRanged.h"
 
@@ -29,12 +30,16 @@ AGWWeaponRanged::AGWWeaponRanged(const FObjectInitializer& ObjectInitializer)
 	bIsWeaponFiring = false;
 
 	ReloadEndCount = 0;
+	BurstSize = 1;
+	SpreadSeed = 0;
+	ShotCounter = 0;
 }
 void AGWWeaponRanged::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 	if (bTraceEveryTick && bIsWeaponFiring && TargetingMethod)
 	{
+		//HitInfo is from trace requested last frame.
 		TargetingMethod->SingleLineTraceSetHitLocation();
 		if (Role < ROLE_Authority || GetNetMode() == ENetMode::NM_Standalone)
 			OnWeaponFiring(HitInfo.Origin, HitInfo.HitLocation);
@@ -48,11 +53,16 @@ void AGWWeaponRanged::BeginPlay()
 	CurrentSpread = BaseSpread;
 	CurrentHorizontalRecoil = RecoilConfig.HorizontalRecoilBase;
 	CurrentVerticalRecoil = RecoilConfig.VerticalRecoilBase;
+	if (Role == ROLE_Authority)
+	{
+		SpreadSeed = FMath::Rand();
+	}
 
 	if (TargetingMethod)
 	{
 		TargetingMethod->SetRange(Range);
 		TargetingMethod->SetCurrentSpread(CurrentSpread);
+		TargetingMethod->SetPelletCount(BurstSize);
 		TargetingMethod->Initialize();
 	}
 
@@ -69,6 +79,8 @@ void AGWWeaponRanged::GetLifetimeReplicatedProps(TArray< class FLifetimeProperty
 	DOREPLIFETIME_CONDITION(AGWWeaponRanged, RemaningAmmo, COND_OwnerOnly);
 	DOREPLIFETIME(AGWWeaponRanged, ReloadEndCount);
 	DOREPLIFETIME(AGWWeaponRanged, ReloadBeginCount);
+	DOREPLIFETIME(AGWWeaponRanged, SpreadSeed);
+	DOREPLIFETIME_CONDITION(AGWWeaponRanged, ShotCounter, COND_SkipOwner);
 
 }
 
@@ -97,25 +109,155 @@ void AGWWeaponRanged::FireWeapon(const FHitResult& TargetIn, float DamageIn, APa
 	}
 }
 void AGWWeaponRanged::ShootWeapon()
+{
+	ShootWeaponBatch(1, GetWorld()->GetTimeSeconds());
+}
+void AGWWeaponRanged::ShootWeaponBatch(int32 NumShotsIn, float FirstShotTimeIn)
 {
 	if (!CheckIfHaveAmmo())
 	{
 		CurrentState->EndActionSequence();
 		return;
 	}
-	SubtractAmmo();
-	CalculateCurrentWeaponSpread();
+	const int32 MaxShots = MaxShotsPerBatch;
+	int32 NumShots = FMath::Clamp(NumShotsIn, 1, MaxShots);
+	if (AmmoCost > 0)
+	{
+		//same as shooting one by one, while there is any ammo left.
+		NumShots = FMath::Min(NumShots, FMath::CeilToInt(RemainingMagazineAmmo / AmmoCost));
+	}
+	SubtractAmmo(NumShots);
+
+	TArray<float, TInlineAllocator<MaxShotsPerBatch>> ShotSpreads;
+	for (int32 Shot = 0; Shot < NumShots; Shot++)
+	{
+		CalculateCurrentWeaponSpread();
+		ShotSpreads.Add(CurrentSpread);
+	}
+	const int32 FirstShot = ShotCounter + 1;
+	ShotCounter += NumShots;
+	if (Role == ROLE_Authority && Instigator && !Instigator->IsLocallyControlled())
+	{
+		//hits of this batch are sent by client in ServerConfirmShot.
+		AddPendingShotBatch(FirstShot, NumShots, FirstShotTimeIn);
+	}
 
 	//if (Role == ROLE_Authority)
 	//{
+		//shot finishes in OnTargetDataReady, once trace results are there.
 		if (TargetingMethod)
+		{
+			//seed might have been replicated after BeginPlay.
+			TargetingMethod->SetRandomSeed(SpreadSeed);
+			TargetingMethod->SetShotBatch(FirstShot, FirstShotTimeIn, ShotSpreads.GetData(), ShotSpreads.Num());
 			TargetingMethod->Execute();
-
-		OnShoot();
+		}
+		else
+			OnTargetDataReady();
 	//}
+}
+void AGWWeaponRanged::OnTargetDataReady()
+{
+	if (Role < ROLE_Authority)
+	{
+		//batch which produced this TargetData, next one might have been fired already.
+		const FGWShotBatch Batch = TargetingMethod ? TargetingMethod->GetCompletedBatch() : FGWShotBatch();
+		const bool bHasShotIndices = Batch.HitShotIndices.Num() == TargetData.Num();
+		TArray<FGWShotClaim> Claims;
+		Claims.Reserve(TargetData.Num());
+		for (int32 Idx = 0; Idx < TargetData.Num(); Idx++)
+		{
+			FGWShotClaim& Claim = Claims[Claims.Add(FGWShotClaim(TargetData[Idx]))];
+			Claim.ShotIndex = bHasShotIndices ? Batch.HitShotIndices[Idx] : 0;
+		}
+		//shots of batch happened between frames, so send time of first one.
+		const float Now = GetWorld()->GetTimeSeconds();
+		AGameStateBase* GameState = GetWorld()->GetGameState();
+		const float ServerNow = GameState ? GameState->GetServerWorldTimeSeconds() : Now;
+		ServerConfirmShot(Claims, ServerNow - FMath::Max(Now - Batch.FirstShotTime, 0.f), Batch.NumShots);
+	}
+	else if (Instigator && !Instigator->IsLocallyControlled())
+	{
+		//shots of remote client are resolved in ServerConfirmShot, against rewound poses.
+		return;
+	}
+	OnShoot();
 	if (GetNetMode() == ENetMode::NM_Standalone || Role < ROLE_Authority)
 		OnRep_HitInfo();
 }
+void AGWWeaponRanged::ServerConfirmShot_Implementation(const TArray<FGWShotClaim>& ClaimsIn, float ShotTimeIn, uint8 NumShotsIn)
+{
+	//client can only confirm shots, which server fired as well.
+	float ShotTime = ShotTimeIn;
+	if (!ConsumePendingShotBatch(NumShotsIn, ShotTime))
+		return;
+
+	AActor* Shooter = Instigator ? Instigator : this;
+	TargetData.Reset();
+	//pawns are rewound once per shot, and every pellet of that shot is checked against the same poses.
+	for (int32 Shot = 0; Shot < NumShotsIn; Shot++)
+	{
+		bool bRewound = false;
+		for (const FGWShotClaim& Claim : ClaimsIn)
+		{
+			if (Claim.ShotIndex != Shot)
+				continue;
+			if (!bRewound)
+			{
+				FGWLagCompensation::Rewind(GetWorld(), ShotTime + Shot * FireRate, RewoundPoses);
+				bRewound = true;
+			}
+			if (FGWLagCompensation::ValidateHit(Shooter, Claim, RewoundPoses))
+			{
+				TargetData.Add(Claim.ToHitResult());
+			}
+		}
+	}
+	if (TargetData.Num() > 0)
+	{
+		SetHitLocation(TargetData[0].TraceStart, TargetData[0].ImpactPoint);
+	}
+	else if (ClaimsIn.Num() > 0)
+	{
+		SetHitLocation(ClaimsIn[0].Origin, ClaimsIn[0].End);
+	}
+	OnShoot();
+}
+bool AGWWeaponRanged::ServerConfirmShot_Validate(const TArray<FGWShotClaim>& ClaimsIn, float ShotTimeIn, uint8 NumShotsIn)
+{
+	if (NumShotsIn < 1 || NumShotsIn > MaxShotsPerBatch)
+		return false;
+	//single shot can't hit more than it has pellets.
+	if (ClaimsIn.Num() > NumShotsIn * FMath::Max(BurstSize, 1))
+		return false;
+	for (const FGWShotClaim& Claim : ClaimsIn)
+	{
+		if (Claim.ShotIndex >= NumShotsIn)
+			return false;
+	}
+	return true;
+}
+void AGWWeaponRanged::AddPendingShotBatch(int32 FirstShotIn, int32 NumShotsIn, float FirstShotTimeIn)
+{
+	if (PendingShotBatches.Num() >= MaxPendingShotBatches)
+	{
+		PendingShotBatches.RemoveAt(0, 1, false);
+	}
+	PendingShotBatches.Add(FGWPendingShotBatch(FirstShotIn, NumShotsIn, FirstShotTimeIn));
+}
+bool AGWWeaponRanged::ConsumePendingShotBatch(int32 NumShotsIn, float& ShotTimeInOut)
+{
+	if (PendingShotBatches.Num() == 0)
+		return false;
+	const FGWPendingShotBatch Batch = PendingShotBatches[0];
+	PendingShotBatches.RemoveAt(0, 1, false);
+	if (NumShotsIn > Batch.NumShots)
+		return false;
+	//client fired before server did, but not earlier than hits can be rewound.
+	ShotTimeInOut = FMath::Clamp(ShotTimeInOut, Batch.FirstShotTime - FGWLagCompensation::GetMaxRewindTime(),
+		Batch.FirstShotTime);
+	return true;
+}
 void AGWWeaponRanged::ActionEnd()
 {
 
@@ -297,9 +439,9 @@ bool AGWWeaponRanged::CheckIfHaveAmmo()
 	else
 		return false;
 }
-void AGWWeaponRanged::SubtractAmmo()
+void AGWWeaponRanged::SubtractAmmo(int32 NumShotsIn)
 {
-	RemainingMagazineAmmo -= AmmoCost;
+	RemainingMagazineAmmo -= AmmoCost * NumShotsIn;
 }
 bool AGWWeaponRanged::CheckIfCanReload()
 {
@@ -332,6 +474,31 @@ void AGWWeaponRanged::CalculateCurrentWeaponSpread()
 		TargetingMethod->SetCurrentSpread(CurrentSpread);
 	}
 }
+void AGWWeaponRanged::ResetWeapon()
+{
+	//states set their own timers.
+	UGWWeaponState* States[] = { EquipingState, ActiveState, ActionState, ReloadState };
+	for (UGWWeaponState* State : States)
+	{
+		if (State)
+			GetWorldTimerManager().ClearAllTimersForObject(State);
+	}
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	GotoState(ActiveState);
+
+	bIsWeaponFiring = false;
+	RemaningAmmo = MaximumAmmo;
+	RemainingMagazineAmmo = MagazineSize;
+	CurrentSpread = BaseSpread;
+	CurrentHorizontalRecoil = RecoilConfig.HorizontalRecoilBase;
+	CurrentVerticalRecoil = RecoilConfig.VerticalRecoilBase;
+	TargetData.Reset();
+	PendingShotBatches.Reset();
+	if (TargetingMethod)
+	{
+		TargetingMethod->SetCurrentSpread(CurrentSpread);
+	}
+}
 void AGWWeaponRanged::ReduceSpreadOverTime()
 {
 	CurrentSpread -= SpreadReduce;
@@ -1,5 +1,6 @@
 #pragma once
 #include "GWWeapon.h"
+#include "GWLagCompensation.h"
 #include "GWWeaponRanged.generated.h"
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FGWOnCurrentWeaponSpread, float);
@@ -67,6 +68,26 @@ public:
 
 };
 
+/* Batch fired on server for remote instigator, waiting for client to confirm it's hits. */
+struct FGWPendingShotBatch
+{
+	int32 FirstShot;
+	int32 NumShots;
+	/* Server world time of first shot. */
+	float FirstShotTime;
+
+	FGWPendingShotBatch()
+		: FirstShot(0),
+		NumShots(0),
+		FirstShotTime(0)
+	{}
+	FGWPendingShotBatch(int32 FirstShotIn, int32 NumShotsIn, float FirstShotTimeIn)
+		: FirstShot(FirstShotIn),
+		NumShots(NumShotsIn),
+		FirstShotTime(FirstShotTimeIn)
+	{}
+};
+
 /*
 	Base class for all weapons.
 	Mele and ranged weapons need separate classes (at least).
@@ -196,13 +217,24 @@ protected:
 	float RemaningAmmo;
 
 	float CurrentSpread;
+	/* Seed of pellet spread. Picked by server, so all sides generate the same pellets. */
+	UPROPERTY(Replicated)
+	int32 SpreadSeed;
+	/* Shots fired so far. Owner counts them locally, others get it replicated. */
+	UPROPERTY(Replicated)
+	int32 ShotCounter;
 	bool CheckIfHaveAmmo();
-	void SubtractAmmo();
+	void SubtractAmmo(int32 NumShotsIn = 1);
 	void CalculateReloadAmmo();
 	bool CheckIfCanReload();
 
 	float CurrentCharge;
 
+	/* Batches fired on server, which remote client has not confirmed yet. Oldest first. */
+	TArray<FGWPendingShotBatch> PendingShotBatches;
+	/* Reused by ServerConfirmShot, so pawns are not rewound into new array for every claim. */
+	FGWRewoundPoses RewoundPoses;
+
 	void ReduceSpreadOverTime();
 	FTimerHandle ReduceSpreadOverTimeTimerHandle;
 
@@ -236,6 +268,12 @@ public:
 		Calculates current weapon spread. Called on every shot.
 	*/
 	virtual void CalculateCurrentWeaponSpread();
+
+	/*
+		Puts weapon back into state it had after BeginPlay (full ammo, base spread, active state).
+		Used when weapon actor is reused instead of spawned again.
+	*/
+	virtual void ResetWeapon();
 public:
 	/*
 		Ranged weapons need special trace methods, which will account for spread.
@@ -258,6 +296,34 @@ public:
 		And client is mainly using for cosmetics.
 	*/
 	virtual void ShootWeapon();
+	/*
+		Fires shots which fall into single frame as one batch. Ammo is subtracted once, spread is
+		advanced for every shot, and pellets of all shots are traced together. OnShoot() and hit
+		cosmetics happen once for whole batch.
+
+		@param NumShotsIn - shots to fire. Clamped to remaining ammo and MaxShotsPerBatch.
+		@param FirstShotTimeIn - world time of first shot. Next shots are FireRate apart.
+	*/
+	virtual void ShootWeaponBatch(int32 NumShotsIn, float FirstShotTimeIn);
+	/* Most shots, which can be fired (and confirmed on server) in single batch. */
+	static const int32 MaxShotsPerBatch = 16;
+	virtual void OnTargetDataReady() override;
+	/*
+		Client sends hits from it's TargetData, with server time of first shot in batch. Server rewinds
+		pawns to time of shot which made each hit, and keeps only hits which would also happen there,
+		before calling OnShoot(). Confirmation without matching batch fired on server is ignored.
+	*/
+	UFUNCTION(Server, Reliable, WithValidation)
+		void ServerConfirmShot(const TArray<FGWShotClaim>& ClaimsIn, float ShotTimeIn, uint8 NumShotsIn);
+	/* Batches older than this are dropped, if client never confirms them. */
+	static const int32 MaxPendingShotBatches = 8;
+	/* Remembers batch fired on server, so confirmation from client can be checked against it. */
+	void AddPendingShotBatch(int32 FirstShotIn, int32 NumShotsIn, float FirstShotTimeIn);
+	/*
+		Removes oldest pending batch. Fails if there is none, or client claims more shots than it had.
+		ShotTimeInOut is clamped to time of batch on server.
+	*/
+	bool ConsumePendingShotBatch(int32 NumShotsIn, float& ShotTimeInOut);
 	virtual void ActionEnd() override;
 
 	virtual void BeginFire();
@@ -32,6 +32,7 @@ namespace UnrealBuildTool.Rules
                     "GameInterfaces",
                     "GameplayTags",
                     "GameAbilities",
+                    "GameTrace",
 
 					// ... add other public dependencies that you statically link with here ...
 				}
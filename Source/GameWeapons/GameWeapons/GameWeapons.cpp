@@ -2,6 +2,7 @@
 #pragma once
 #include "GameWeapons.h"
 #include "IGameWeapons.h"
+#include "GWLagCompensation.h"
 
 
 class FGameWeapons : public IGameWeapons
@@ -18,6 +19,7 @@ IMPLEMENT_MODULE(FGameWeapons, GameWeapons)
 void FGameWeapons::StartupModule()
 {
 	// This code will execute after your module is loaded into memory (but after global variables are initialized, of course.)
+	FGWLagCompensation::Startup();
 }
 
 
@@ -25,6 +27,7 @@ void FGameWeapons::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FGWLagCompensation::Shutdown();
 }
 
 
@@ -8,7 +8,8 @@
 UGWWeaponStateFiring::UGWWeaponStateFiring(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
-
+	FireStartTime = 0;
+	ShotsFired = 0;
 }
 
 void UGWWeaponStateFiring::Tick(float DeltaSeconds)
@@ -19,6 +20,9 @@ void UGWWeaponStateFiring::BeginState(UGWWeaponState* PrevState)
 	CurrentWeapon = Cast<AGWWeaponRanged>(GetOuterAGWWeapon());
 	if (CurrentWeapon)
 	{
+		FireStartTime = GetWorld()->GetTimeSeconds();
+		ShotsFired = 0;
+		//timer only wakes us up, number of shots is computed from time.
 		GetOuterAGWWeapon()->GetWorldTimerManager().SetTimer(FiringTimerHandle, this, &UGWWeaponStateFiring::FireWeapon, CurrentWeapon->FireRate, true);
 		FireWeapon();
 	}
@@ -37,5 +41,23 @@ void UGWWeaponStateFiring::EndActionSequence()
 
 void UGWWeaponStateFiring::FireWeapon()
 {
-	CurrentWeapon->ShootWeapon();
+	const float FireRate = FMath::Max(CurrentWeapon->FireRate, KINDA_SMALL_NUMBER);
+	int32 ShotsDue = 0;
+	const int32 NumShots = GetShotsToFire(GetWorld()->GetTimeSeconds() - FireStartTime, FireRate, ShotsFired, ShotsDue);
+	if (NumShots <= 0)
+		return;
+
+	const float FirstShotTime = FireStartTime + (ShotsDue - NumShots) * FireRate;
+	ShotsFired = ShotsDue;
+	CurrentWeapon->ShootWeaponBatch(NumShots, FirstShotTime);
+}
+int32 UGWWeaponStateFiring::GetShotsToFire(float ElapsedTimeIn, float FireRateIn, int32 ShotsFiredIn, int32& ShotsDueOut)
+{
+	const float FireRate = FMath::Max(FireRateIn, KINDA_SMALL_NUMBER);
+	//include shot at start of firing.
+	ShotsDueOut = FMath::FloorToInt((FMath::Max(ElapsedTimeIn, 0.f) + KINDA_SMALL_NUMBER) / FireRate) + 1;
+	if (ShotsDueOut <= ShotsFiredIn)
+		return 0;
+	const int32 MaxShots = AGWWeaponRanged::MaxShotsPerBatch;
+	return FMath::Min(ShotsDueOut - ShotsFiredIn, MaxShots);
 }
\ No newline at end of file
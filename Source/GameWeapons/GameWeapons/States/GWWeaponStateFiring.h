@@ -15,8 +15,27 @@ public:
 	virtual void BeginActionSequence() override;
 	virtual void EndActionSequence() override;
 protected:
+	/*
+		Fires all shots, which should have happened since last call, as single batch.
+		Shot times are counted from FireStartTime, so they don't drift with frame rate,
+		and shots are not lost when FireRate is shorter than frame.
+	*/
 	void FireWeapon();
+public:
+	/*
+		Number of shots to fire now, when ShotsFiredIn shots have already been fired during
+		first ElapsedTimeIn seconds of firing. Clamped to AGWWeaponRanged::MaxShotsPerBatch,
+		after long hitch oldest shots are dropped instead of firing everything at once.
+
+		@param ShotsDueOut - all shots, which should have been fired by now, including dropped.
+	*/
+	static int32 GetShotsToFire(float ElapsedTimeIn, float FireRateIn, int32 ShotsFiredIn, int32& ShotsDueOut);
+protected:
 	UPROPERTY()
 	class AGWWeaponRanged* CurrentWeapon;
 	FTimerHandle FiringTimerHandle;
+	/* World time of first shot in current firing sequence. */
+	float FireStartTime;
+	/* Shots fired (or skipped) since FireStartTime. */
+	int32 ShotsFired;
 };
@@ -0,0 +1,155 @@
+// Copyright 1998-2014 Epic Games, Inc. All Rights Reserved.
+
+#include "../GameWeapons.h"
+#include "GITestWorld.h"
+#include "../GWWeaponRanged.h"
+#include "../GWLagCompensation.h"
+#include "../States/GWWeaponStateFiring.h"
+#include "../Tracing/GWTraceRangedWeapon.h"
+#if WITH_EDITOR
+
+/* Actor with box collision. World static boxes block shots as world geometry. */
+static AActor* SpawnBox(UWorld* WorldIn, const FVector& LocationIn, const FVector& ExtentIn, bool bWorldStaticIn)
+{
+	AActor* Actor = WorldIn->SpawnActor<AActor>();
+	UBoxComponent* Box = NewObject<UBoxComponent>(Actor);
+	Box->SetBoxExtent(ExtentIn);
+	Box->SetCollisionObjectType(bWorldStaticIn ? ECC_WorldStatic : ECC_WorldDynamic);
+	Box->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	Box->SetCollisionResponseToAllChannels(ECR_Block);
+	Actor->SetRootComponent(Box);
+	Box->RegisterComponent();
+	Actor->SetActorLocation(LocationIn);
+	return Actor;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGWFireWeaponShotsDueTest, "GameWeapons.Weapons.FireWeaponShotsDue", GI_TEST_FLAGS)
+bool FGWFireWeaponShotsDueTest::RunTest(const FString& Parameters)
+{
+	int32 ShotsDue = 0;
+	int32 NumShots = UGWWeaponStateFiring::GetShotsToFire(0, 0.1f, 0, ShotsDue);
+	TestTrue(TEXT("First shot is fired right away"), NumShots == 1 && ShotsDue == 1);
+	NumShots = UGWWeaponStateFiring::GetShotsToFire(0.05f, 0.1f, ShotsDue, ShotsDue);
+	TestTrue(TEXT("Nothing is fired before FireRate elapsed"), NumShots == 0);
+	NumShots = UGWWeaponStateFiring::GetShotsToFire(0.1f, 0.1f, 1, ShotsDue);
+	TestTrue(TEXT("Shot exactly on FireRate is fired"), NumShots == 1 && ShotsDue == 2);
+
+	//FireRate shorter than 60 fps frame.
+	const float FrameTime = 1.f / 60.f;
+	NumShots = UGWWeaponStateFiring::GetShotsToFire(FrameTime, 0.005f, 1, ShotsDue);
+	TestTrue(TEXT("Every shot which fits in frame is fired"), NumShots == 3 && ShotsDue == 4);
+	NumShots = UGWWeaponStateFiring::GetShotsToFire(FrameTime, 0.005f, ShotsDue, ShotsDue);
+	TestTrue(TEXT("Shots are not fired twice in the same frame"), NumShots == 0);
+	NumShots = UGWWeaponStateFiring::GetShotsToFire(FrameTime * 2, 0.005f, 4, ShotsDue);
+	TestTrue(TEXT("Shots don't drift with frame rate"), NumShots == 3 && ShotsDue == 7);
+
+	//one second hitch.
+	NumShots = UGWWeaponStateFiring::GetShotsToFire(1.f, 0.01f, 1, ShotsDue);
+	TestTrue(TEXT("Shots after hitch are clamped to batch size"),
+		NumShots == AGWWeaponRanged::MaxShotsPerBatch && ShotsDue == 101);
+	NumShots = UGWWeaponStateFiring::GetShotsToFire(1.f + FrameTime, 0.01f, ShotsDue, ShotsDue);
+	TestTrue(TEXT("Dropped shots are not fired later"), NumShots == 1 && ShotsDue == 102);
+	NumShots = UGWWeaponStateFiring::GetShotsToFire(1.f, 0, 0, ShotsDue);
+	TestTrue(TEXT("Zero FireRate is clamped to batch size"), NumShots == AGWWeaponRanged::MaxShotsPerBatch);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGWPelletDirectionsDeterministicTest, "GameWeapons.Weapons.PelletDirectionsDeterministic", GI_TEST_FLAGS)
+bool FGWPelletDirectionsDeterministicTest::RunTest(const FString& Parameters)
+{
+	const FVector AimDir(1, 0, 0);
+	const float Spread = 10.f;
+	const int32 NumPellets = 8;
+	TArray<FVector> First;
+	TArray<FVector> Second;
+	TArray<FVector> NextShot;
+	UGWTraceRangedWeapon::GeneratePelletDirections(AimDir, Spread, 1234, 7, NumPellets, First);
+	UGWTraceRangedWeapon::GeneratePelletDirections(AimDir, Spread, 1234, 7, NumPellets, Second);
+	UGWTraceRangedWeapon::GeneratePelletDirections(AimDir, Spread, 1234, 8, NumPellets, NextShot);
+	TestTrue(TEXT("Every pellet has direction"), First.Num() == NumPellets && NextShot.Num() == NumPellets);
+
+	bool bIdentical = Second.Num() == NumPellets;
+	bool bDifferent = true;
+	bool bInCone = true;
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(Spread * 0.5f));
+	for (int32 Idx = 0; Idx < First.Num() && Idx < Second.Num() && Idx < NextShot.Num(); Idx++)
+	{
+		bIdentical &= First[Idx] == Second[Idx];
+		bDifferent &= !First[Idx].Equals(NextShot[Idx]);
+		bInCone &= (First[Idx] | AimDir) >= CosHalfAngle - KINDA_SMALL_NUMBER;
+	}
+	TestTrue(TEXT("The same seed and shot give identical directions"), bIdentical);
+	TestTrue(TEXT("Next shot gives different directions"), bDifferent);
+	TestTrue(TEXT("Pellets stay within spread cone"), bInCone);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGWValidateHitTest, "GameWeapons.Weapons.ValidateHit", GI_TEST_FLAGS)
+bool FGWValidateHitTest::RunTest(const FString& Parameters)
+{
+	FGITestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	AActor* Shooter = SpawnBox(World, FVector::ZeroVector, FVector(10), false);
+	AActor* Target = SpawnBox(World, FVector(1000, 0, 0), FVector(50), false);
+	FGWShotClaim Claim;
+	Claim.Origin = FVector::ZeroVector;
+	Claim.End = FVector(2000, 0, 0);
+	Claim.ImpactPoint = FVector(950, 0, 10);
+	Claim.HitActor = Target;
+	TestTrue(TEXT("Hit within tolerance is accepted"), FGWLagCompensation::ValidateHit(Shooter, Claim, 0));
+	FGWRewoundPoses Poses;
+	FGWLagCompensation::Rewind(World, 0, Poses);
+	TestTrue(TEXT("Hit is accepted against poses rewound once"), FGWLagCompensation::ValidateHit(Shooter, Claim, Poses));
+
+	FGWShotClaim FarOrigin = Claim;
+	FarOrigin.Origin = FVector(0, 0, 1000);
+	FarOrigin.End = FVector(2000, 0, 1000);
+	TestFalse(TEXT("Origin far from shooter is rejected"), FGWLagCompensation::ValidateHit(Shooter, FarOrigin, 0));
+
+	FGWShotClaim OffSegment = Claim;
+	OffSegment.End = FVector(2000, 1000, 0);
+	TestFalse(TEXT("Impact away from shot line is rejected"), FGWLagCompensation::ValidateHit(Shooter, OffSegment, 0));
+
+	AActor* Wall = SpawnBox(World, FVector(500, 0, 0), FVector(10, 200, 200), true);
+	TestFalse(TEXT("Hit behind world geometry is rejected"), FGWLagCompensation::ValidateHit(Shooter, Claim, 0));
+
+	World->DestroyActor(Wall);
+	World->DestroyActor(Target);
+	World->DestroyActor(Shooter);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGWConfirmShotNeedsFiredBatchTest, "GameWeapons.Weapons.ConfirmShotNeedsFiredBatch", GI_TEST_FLAGS)
+bool FGWConfirmShotNeedsFiredBatchTest::RunTest(const FString& Parameters)
+{
+	FGITestWorld TestWorld;
+	UWorld* World = TestWorld.Get();
+
+	AGWWeaponRanged* Weapon = World->SpawnActor<AGWWeaponRanged>();
+	float ShotTime = 1.f;
+	TestFalse(TEXT("Confirm without fired batch is rejected"), Weapon->ConsumePendingShotBatch(1, ShotTime));
+
+	const float Now = World->GetTimeSeconds();
+	Weapon->AddPendingShotBatch(1, 2, Now);
+	Weapon->AddPendingShotBatch(3, 1, Now + 1.f);
+	ShotTime = Now + 10.f;
+	TestTrue(TEXT("Confirm of fired batch is accepted"), Weapon->ConsumePendingShotBatch(2, ShotTime));
+	TestTrue(TEXT("Shot time is clamped to time of batch"), FMath::IsNearlyEqual(ShotTime, Now));
+	ShotTime = Now + 1.f;
+	TestFalse(TEXT("Confirm of more shots than batch had is rejected"), Weapon->ConsumePendingShotBatch(2, ShotTime));
+	TestFalse(TEXT("Rejected confirm still consumes batch"), Weapon->ConsumePendingShotBatch(1, ShotTime));
+
+	for (int32 Idx = 0; Idx < AGWWeaponRanged::MaxPendingShotBatches + 1; Idx++)
+	{
+		Weapon->AddPendingShotBatch(Idx + 1, 1, Now + Idx);
+	}
+	ShotTime = Now + 10.f;
+	Weapon->ConsumePendingShotBatch(1, ShotTime);
+	TestTrue(TEXT("Oldest batch is dropped when queue is full"), FMath::IsNearlyEqual(ShotTime, Now + 1.f));
+
+	World->DestroyActor(Weapon);
+	return true;
+}
+
+#endif
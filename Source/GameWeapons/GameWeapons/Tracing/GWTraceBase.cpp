@@ -9,6 +9,7 @@ UGWTraceBase::UGWTraceBase(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
 	bIgnoreSelf = true;
+	bCoalesceAimTraces = true;
 }
 UWorld* UGWTraceBase::GetWorld() const
 {
@@ -28,22 +29,26 @@ void UGWTraceBase::Tick(float DeltaSecondsIn)
 void UGWTraceBase::SingleLineTraceSetHitLocation()
 {
 	const FVector ShootDir = GetPawnCameraAim();
+	const FGTTraceResultDelegate OnTraceDone = FGTTraceResultDelegate::CreateUObject(this, &UGWTraceBase::OnSetHitLocationTraceDone);
 	if (bTraceFromSocket)
 	{
 		const FVector StartTrace = GetStartLocationFromTargetingSocket();
 		const FVector EndTrace = (GetStartLocationFromTargetingSocket() + ShootDir * Range);
-		const FHitResult Impact = SingleLineRangedTrace(StartTrace, EndTrace);
-		GetOuterAGWWeapon()->SetHitLocation(StartTrace, Impact.Location);
+		AsyncSingleLineRangedTrace(StartTrace, EndTrace, OnTraceDone);
 	}
 	else
 	{
 		const FVector StartTrace = GetPawnCameraDamageStartLocation(ShootDir);
 		const FVector EndTrace = (StartTrace + ShootDir * Range);
-		const FHitResult Impact = SingleLineRangedTrace(StartTrace, EndTrace);
-		GetOuterAGWWeapon()->SetHitLocation(StartTrace, Impact.Location);
+		AsyncSingleLineRangedTrace(StartTrace, EndTrace, OnTraceDone);
 	}
 }
 
+void UGWTraceBase::OnSetHitLocationTraceDone(const FHitResult& HitIn)
+{
+	GetOuterAGWWeapon()->SetHitLocation(HitIn.TraceStart, HitIn.bBlockingHit ? HitIn.Location : HitIn.TraceEnd);
+}
+
 FVector UGWTraceBase::GetSingHitLocation()
 {
 	FHitResult Impact;
@@ -70,8 +75,8 @@ void UGWTraceBase::SingleLineTraceFromWeapon()
 	const FVector ShootDir = GetPawnCameraAim();
 	const FVector StartTrace = GetStartLocationFromWeaponSocket();
 	const FVector EndTrace = (GetStartLocationFromWeaponSocket() + ShootDir * Range);
-	const FHitResult Impact = SingleLineRangedTrace(StartTrace, EndTrace);
-	GetOuterAGWWeapon()->SetHitLocation(StartTrace, Impact.Location);
+	AsyncSingleLineRangedTrace(StartTrace, EndTrace,
+		FGTTraceResultDelegate::CreateUObject(this, &UGWTraceBase::OnSetHitLocationTraceDone));
 }
 
 void UGWTraceBase::Initialize()
@@ -92,7 +97,7 @@ void UGWTraceBase::PreExecute()
 }
 void UGWTraceBase::Execute()
 {
-
+	GetOuterAGWWeapon()->OnTargetDataReady();
 }
 
 void UGWTraceBase::PostExecute()
@@ -205,6 +210,60 @@ FHitResult UGWTraceBase::SingleLineRangedTrace(const FVector& StartTrace, const
 }
 
 
+void UGWTraceBase::AsyncSingleLineRangedTrace(const FVector& StartTrace, const FVector& EndTrace,
+	const FGTTraceResultDelegate& OnTraceDoneIn)
+{
+	if (!GetOuterAGWWeapon()->Instigator)
+	{
+		FHitResult Hit(ForceInit);
+		Hit.TraceStart = StartTrace;
+		Hit.TraceEnd = EndTrace;
+		OnTraceDoneIn.ExecuteIfBound(Hit);
+		return;
+	}
+	FGTAsyncTraceService::RequestLineTrace(GetWorld(), MakeLineTraceRequest(StartTrace, EndTrace), OnTraceDoneIn);
+}
+
+void UGWTraceBase::AsyncMultiLineRangedTrace(const FVector& StartTrace, const TArray<FVector>& EndTraces,
+	const FGTTraceBatchResultDelegate& OnTracesDoneIn)
+{
+	if (!GetOuterAGWWeapon()->Instigator)
+	{
+		TArray<FHitResult> Hits;
+		for (const FVector& EndTrace : EndTraces)
+		{
+			FHitResult& Hit = Hits[Hits.Emplace(ForceInit)];
+			Hit.TraceStart = StartTrace;
+			Hit.TraceEnd = EndTrace;
+		}
+		OnTracesDoneIn.ExecuteIfBound(Hits);
+		return;
+	}
+	TArray<FGTTraceRequest> Requests;
+	Requests.Reserve(EndTraces.Num());
+	for (const FVector& EndTrace : EndTraces)
+	{
+		Requests.Add(MakeLineTraceRequest(StartTrace, EndTrace));
+	}
+	FGTAsyncTraceService::RequestLineTraceBatch(GetWorld(), Requests, OnTracesDoneIn);
+}
+
+FGTTraceRequest UGWTraceBase::MakeLineTraceRequest(const FVector& StartTrace, const FVector& EndTrace) const
+{
+	FGTTraceRequest Request;
+	Request.Start = StartTrace;
+	Request.End = EndTrace;
+	Request.ObjectParams = CollisionObjectParams;
+	//instigator is always ignored, same as by SingleLineRangedTrace.
+	Request.IgnoredActor = GetOuterAGWWeapon()->Instigator;
+	static FName PowerTag = FName(TEXT("SingleLineTrace"));
+	Request.TraceTag = PowerTag;
+	Request.bReturnPhysicalMaterial = true;
+	Request.bCoalesce = bCoalesceAimTraces;
+	Request.bDrawDebug = bDrawDebug;
+	return Request;
+}
+
 FVector UGWTraceBase::GetHelperScale()
 {
 	return FVector::ZeroVector;
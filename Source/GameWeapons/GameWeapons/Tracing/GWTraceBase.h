@@ -1,4 +1,5 @@
 #pragma once
+#include "GTAsyncTraceService.h"
 #include "GWTraceBase.generated.h"
 /*
 	This actually could be moved into separate module ? I know i might need something
@@ -74,6 +75,13 @@ public:
 
 	UPROPERTY(EditAnywhere, Category = "Configuration")
 		bool bDrawDebug;
+
+	/*
+		Share single trace with other traces from the same start to the same end, requested
+		in the same frame (ie. weapons shooting at the same time from the same camera).
+	*/
+	UPROPERTY(EditAnywhere, Category = "Configuration")
+		bool bCoalesceAimTraces;
 	/*
 		TODO::
 		1. Add filtering by tags.
@@ -106,6 +114,8 @@ public:
 
 	/**
 	 *	Central function to execute current action.
+	 *	Traces are asynchronous, and weapon is notified trough AGWWeapon::OnTargetDataReady()
+	 *	when TargetData is filled. Base version doesn't trace and notifies weapon immediately.
 	 */
 	virtual void Execute();
 
@@ -164,4 +174,16 @@ protected:
 	*	Base single line trace.
 	*/
 	FHitResult SingleLineRangedTrace(const FVector& StartTrace, const FVector& EndTrace);
+	/**
+	*	Asynchronous version of SingleLineRangedTrace. Result is delivered next frame.
+	*/
+	void AsyncSingleLineRangedTrace(const FVector& StartTrace, const FVector& EndTrace,
+		const FGTTraceResultDelegate& OnTraceDoneIn);
+	/**
+	*	Traces from single start to multiple ends, as one batch. Results are in order of ends.
+	*/
+	void AsyncMultiLineRangedTrace(const FVector& StartTrace, const TArray<FVector>& EndTraces,
+		const FGTTraceBatchResultDelegate& OnTracesDoneIn);
+	void OnSetHitLocationTraceDone(const FHitResult& HitIn);
+	FGTTraceRequest MakeLineTraceRequest(const FVector& StartTrace, const FVector& EndTrace) const;
 };
@@ -12,39 +12,47 @@ UGWTraceBase_LineSingle::UGWTraceBase_LineSingle(const FObjectInitializer& Objec
 }
 void UGWTraceBase_LineSingle::TraceLineSingle()
 {
-	FHitResult Impact;
-	GetOuterAGWWeapon()->TargetData.Empty();
 	const FVector ShootDir = GetPawnCameraAim();
+	const FGTTraceResultDelegate OnTraceDone = FGTTraceResultDelegate::CreateUObject(this, &UGWTraceBase_LineSingle::OnTraceLineSingleDone);
 
 	if (bTraceFromSocket)
 	{
 		const FVector StartTrace = GetStartLocationFromTargetingSocket();
 		const FVector EndTrace = (GetStartLocationFromTargetingSocket() + ShootDir * Range);
-		Impact = SingleLineRangedTrace(StartTrace, EndTrace);
+		AsyncSingleLineRangedTrace(StartTrace, EndTrace, OnTraceDone);
+	}
+	else
+	{
+		const FVector StartTrace = GetPawnCameraDamageStartLocation(ShootDir);
+		const FVector EndTrace = (StartTrace + ShootDir * Range);
+		AsyncSingleLineRangedTrace(StartTrace, EndTrace, OnTraceDone);
+	}
+}
+
+void UGWTraceBase_LineSingle::OnTraceLineSingleDone(const FHitResult& HitIn)
+{
+	//shots can overlap, so target data is only touched, once results are there.
+	GetOuterAGWWeapon()->TargetData.Empty();
+	//camera trace doesn't produce target data.
+	if (bTraceFromSocket)
+	{
 		//another trace this time from weapon, to impact point.
-		if (Impact.bBlockingHit)
+		if (HitIn.bBlockingHit)
 		{
 			const FVector CorrectStart = GetStartLocationFromWeaponSocket();
-			GetOuterAGWWeapon()->TargetData.Add(Impact);
-			GetOuterAGWWeapon()->SetHitLocation(CorrectStart, Impact.ImpactPoint);
+			GetOuterAGWWeapon()->TargetData.Add(HitIn);
+			GetOuterAGWWeapon()->SetHitLocation(CorrectStart, HitIn.ImpactPoint);
 		}
-		else if (!Impact.bBlockingHit)
+		else
 		{
-			GetOuterAGWWeapon()->SetHitLocation(StartTrace, EndTrace);
+			GetOuterAGWWeapon()->SetHitLocation(HitIn.TraceStart, HitIn.TraceEnd);
 		}
 	}
-	else
-	{
-		const FVector StartTrace = GetPawnCameraDamageStartLocation(ShootDir);
-		const FVector EndTrace = (StartTrace + ShootDir * Range);
-		Impact = SingleLineRangedTrace(StartTrace, EndTrace);
-	}
-	
-	//GetOuterAGWWeapon()->TargetData.Add(Impact);
+	PostExecute();
+	GetOuterAGWWeapon()->OnTargetDataReady();
 }
 
 void UGWTraceBase_LineSingle::Execute()
 {
 	TraceLineSingle();
-	PostExecute();
 }
\ No newline at end of file
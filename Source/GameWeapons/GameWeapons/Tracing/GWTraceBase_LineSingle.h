@@ -27,4 +27,6 @@ class GAMEWEAPONS_API UGWTraceBase_LineSingle : public UGWTraceBase
 public:
 	void TraceLineSingle();
 	virtual void Execute() override;
+protected:
+	void OnTraceLineSingleDone(const FHitResult& HitIn);
 };
@@ -12,66 +12,52 @@ UGWTraceBase_LineSingleRanged::UGWTraceBase_LineSingleRanged(const FObjectInitia
 }
 void UGWTraceBase_LineSingleRanged::TraceLineSingle()
 {
-	FHitResult Impact;
-	GetOuterAGWWeapon()->TargetData.Empty();
 	const FVector AimDir = GetPawnCameraAim();
-	//int32 CurrentSeed = 0;
-	//if (GetOuterAGWWeapon()->GetNetMode() == ENetMode::NM_Client
-	//	|| GetOuterAGWWeapon()->GetNetMode() == ENetMode::NM_DedicatedServer)
-	//{
-	//	if (GetOuterAGWWeapon()->Instigator->PlayerState)
-	//		CurrentSeed = GetOuterAGWWeapon()->Instigator->PlayerState->StartTime;
-	//}
-	//else if (GetOuterAGWWeapon()->GetNetMode() == ENetMode::NM_Standalone)
-	//	CurrentSeed = FMath::Rand();
-
-	//float ConeHalfAngl = FMath::DegreesToRadians(CurrentSpreadRadius* 0.5f);
-	//FRandomStream RandomWeaponStream(CurrentSeed);
-	const FVector ShootDir = AimDir; //RandomWeaponStream.VRandCone(AimDir, ConeHalfAngl, ConeHalfAngl);
+	const FVector StartTrace = bTraceFromSocket ? GetStartLocationFromWeaponSocket() : GetPawnCameraDamageStartLocation(AimDir);
 
-	if (bTraceFromSocket)
+	const int32 NumShots = FMath::Max(ShotSpreads.Num(), 1);
+	TArray<FVector> PelletDirs;
+	TArray<FVector> EndTraces;
+	EndTraces.Reserve(NumShots * PelletCount);
+	for (int32 Shot = 0; Shot < NumShots; Shot++)
 	{
-		const FVector StartTrace = GetStartLocationFromWeaponSocket();
-		const FVector EndTrace = (GetStartLocationFromWeaponSocket() + ShootDir * Range);
-		//const FVector StartTrace = GetStartLocationFromTargetingSocket();
-		//const FVector EndTrace = (GetStartLocationFromTargetingSocket() + ShootDir * Range);
-		Impact = SingleLineRangedTrace(StartTrace, EndTrace);
-		//another trace this time from weapon, to impact point.
-		if (Impact.bBlockingHit)
-		{
-			const FVector CorrectStart = GetStartLocationFromWeaponSocket();
-			GetOuterAGWWeapon()->TargetData.Add(Impact);
-			GetOuterAGWWeapon()->SetHitLocation(CorrectStart, Impact.ImpactPoint);
-		}
-		else if (!Impact.bBlockingHit)
+		const float Spread = ShotSpreads.Num() > 0 ? ShotSpreads[Shot] : CurrentSpreadRadius;
+		GeneratePelletDirections(AimDir, Spread, RandomSeed, PendingBatch.FirstShot + Shot, PelletCount, PelletDirs);
+		for (const FVector& ShootDir : PelletDirs)
 		{
-			const FVector CorrectStart = GetStartLocationFromWeaponSocket();
-			GetOuterAGWWeapon()->SetHitLocation(CorrectStart, EndTrace);
+			EndTraces.Add(StartTrace + ShootDir * Range);
 		}
 	}
-	else
+	AsyncMultiLineRangedTrace(StartTrace, EndTraces,
+		FGTTraceBatchResultDelegate::CreateUObject(this, &UGWTraceBase_LineSingleRanged::OnPelletTracesDone, PelletCount, PendingBatch));
+}
+
+void UGWTraceBase_LineSingleRanged::OnPelletTracesDone(const TArray<FHitResult>& HitsIn, int32 PelletsPerShotIn, FGWShotBatch BatchIn)
+{
+	//shots can overlap, so target data is only touched, once results are there.
+	GetOuterAGWWeapon()->TargetData.Empty();
+	BatchIn.HitShotIndices.Reset();
+	for (int32 Idx = 0; Idx < HitsIn.Num(); Idx++)
 	{
-		const FVector StartTrace = GetPawnCameraDamageStartLocation(ShootDir);
-		const FVector EndTrace = (StartTrace + ShootDir * Range);
-		Impact = SingleLineRangedTrace(StartTrace, EndTrace);
-		if (Impact.bBlockingHit)
-		{
-			const FVector CorrectStart = GetStartLocationFromWeaponSocket();
-			GetOuterAGWWeapon()->TargetData.Add(Impact);
-			GetOuterAGWWeapon()->SetHitLocation(CorrectStart, Impact.ImpactPoint);
-		}
-		else if (!Impact.bBlockingHit)
+		if (HitsIn[Idx].bBlockingHit)
 		{
-			const FVector CorrectStart = GetStartLocationFromWeaponSocket();
-			GetOuterAGWWeapon()->SetHitLocation(CorrectStart, EndTrace);
+			GetOuterAGWWeapon()->TargetData.Add(HitsIn[Idx]);
+			BatchIn.HitShotIndices.Add(Idx / PelletsPerShotIn);
 		}
 	}
-	
-	//GetOuterAGWWeapon()->TargetData.Add(Impact);
+	CompletedBatch = MoveTemp(BatchIn);
+	//cosmetics follow first pellet of last shot, rest can be recreated from seed.
+	if (HitsIn.Num() > 0)
+	{
+		const FHitResult& LastShotHit = HitsIn[((HitsIn.Num() - 1) / PelletsPerShotIn) * PelletsPerShotIn];
+		const FVector CorrectStart = GetStartLocationFromWeaponSocket();
+		GetOuterAGWWeapon()->SetHitLocation(CorrectStart, LastShotHit.bBlockingHit ? LastShotHit.ImpactPoint : LastShotHit.TraceEnd);
+	}
+	PostExecute();
+	GetOuterAGWWeapon()->OnTargetDataReady();
 }
 
 void UGWTraceBase_LineSingleRanged::Execute()
 {
 	TraceLineSingle();
-	PostExecute();
 }
\ No newline at end of file
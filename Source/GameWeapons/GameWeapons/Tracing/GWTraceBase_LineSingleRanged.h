@@ -25,6 +25,13 @@ class GAMEWEAPONS_API UGWTraceBase_LineSingleRanged : public UGWTraceRangedWeapo
 {
 	GENERATED_UCLASS_BODY()
 public:
+	/*
+		Traces PelletCount pellets for every shot in batch, each shot with it's own spread.
+		Pellets are generated from replicated seed and shot counter, so client and server
+		trace the same ones. All pellets of all shots go out as single trace batch.
+	*/
 	void TraceLineSingle();
 	virtual void Execute() override;
+protected:
+	void OnPelletTracesDone(const TArray<FHitResult>& HitsIn, int32 PelletsPerShotIn, FGWShotBatch BatchIn);
 };
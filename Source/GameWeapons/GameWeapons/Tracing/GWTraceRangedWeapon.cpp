@@ -9,4 +9,56 @@ UGWTraceRangedWeapon::UGWTraceRangedWeapon(const FObjectInitializer& ObjectIniti
 : Super(ObjectInitializer)
 {
 	bIgnoreSelf = true;
+	RandomSeed = 0;
+	PelletCount = 1;
+}
+
+void UGWTraceRangedWeapon::SetShotBatch(int32 FirstShotIn, float FirstShotTimeIn, const float* ShotSpreadsIn, int32 NumShotsIn)
+{
+	PendingBatch.FirstShot = FirstShotIn;
+	PendingBatch.NumShots = FMath::Max(NumShotsIn, 1);
+	PendingBatch.FirstShotTime = FirstShotTimeIn;
+	ShotSpreads.Reset(NumShotsIn);
+	ShotSpreads.Append(ShotSpreadsIn, NumShotsIn);
+}
+
+void UGWTraceRangedWeapon::Execute()
+{
+	//base version notifies weapon right away, so there is nothing to keep batch for.
+	CompletedBatch = PendingBatch;
+	Super::Execute();
+}
+
+void UGWTraceRangedWeapon::GeneratePelletDirections(const FVector& AimDirIn, float SpreadIn, int32 SeedIn,
+	int32 ShotIn, int32 NumPelletsIn, TArray<FVector>& DirectionsOut)
+{
+	DirectionsOut.Reset(NumPelletsIn);
+	if (NumPelletsIn <= 0)
+		return;
+
+	const float ConeHalfAngle = FMath::DegreesToRadians(FMath::Max(SpreadIn, 0.f) * 0.5f);
+	const float CosHalfAngle = FMath::Cos(ConeHalfAngle);
+	FVector AxisX, AxisY;
+	AimDirIn.FindBestAxisVectors(AxisX, AxisY);
+
+	//draw all random numbers first, in fixed order, then build directions in single pass.
+	FRandomStream Stream(HashCombine(GetTypeHash(SeedIn), GetTypeHash(ShotIn)));
+	TArray<float, TInlineAllocator<16>> Angles;
+	TArray<float, TInlineAllocator<16>> CosTheta;
+	Angles.SetNumUninitialized(NumPelletsIn);
+	CosTheta.SetNumUninitialized(NumPelletsIn);
+	for (int32 Idx = 0; Idx < NumPelletsIn; Idx++)
+	{
+		Angles[Idx] = Stream.GetFraction() * 2.f * PI;
+		CosTheta[Idx] = 1.f - Stream.GetFraction() * (1.f - CosHalfAngle);
+	}
+
+	DirectionsOut.SetNumUninitialized(NumPelletsIn);
+	for (int32 Idx = 0; Idx < NumPelletsIn; Idx++)
+	{
+		float SinAngle, CosAngle;
+		FMath::SinCos(&SinAngle, &CosAngle, Angles[Idx]);
+		const float SinTheta = FMath::Sqrt(1.f - CosTheta[Idx] * CosTheta[Idx]);
+		DirectionsOut[Idx] = AimDirIn * CosTheta[Idx] + (AxisX * CosAngle + AxisY * SinAngle) * SinTheta;
+	}
 }
\ No newline at end of file
@@ -1,6 +1,28 @@
 #pragma once
 #include "GWTraceBase.h"
 #include "GWTraceRangedWeapon.generated.h"
+
+/*
+	Shots of weapon traced together. Copied into trace request, so batch which is still being
+	traced, is not overwritten by next one.
+*/
+struct GAMEWEAPONS_API FGWShotBatch
+{
+	/* Shot counter of first shot in batch. */
+	int32 FirstShot;
+	int32 NumShots;
+	/* World time of first shot. */
+	float FirstShotTime;
+	/* For every hit in weapon TargetData, index of shot in batch it belongs to. */
+	TArray<uint8> HitShotIndices;
+
+	FGWShotBatch()
+		: FirstShot(0),
+		NumShots(1),
+		FirstShotTime(0)
+	{}
+};
+
 /*
 	This actually could be moved into separate module ? I know i might need something
 	very similiar inside Effectsm but on the other hand the Within part makes
@@ -26,8 +48,36 @@ class GAMEWEAPONS_API UGWTraceRangedWeapon : public UGWTraceBase
 	GENERATED_UCLASS_BODY()
 protected:
 	float CurrentSpreadRadius;
-	float RandomSeed;
+	/* Replicated from weapon, so client and server get the same pellets. */
+	int32 RandomSeed;
+	/* Number of pellets traced in single shot. */
+	int32 PelletCount;
+	/* Batch, which will be traced by next Execute(). */
+	FGWShotBatch PendingBatch;
+	/* Spread of every shot in PendingBatch. When empty, single shot with CurrentSpreadRadius is traced. */
+	TArray<float> ShotSpreads;
+	/* Batch, for which weapon TargetData has been filled last. */
+	FGWShotBatch CompletedBatch;
 public:
 	inline void SetCurrentSpread(float CurrentSpreadRadiusIn){ CurrentSpreadRadius = CurrentSpreadRadiusIn; };
-	inline void SetRandomSeed(float RandomSeedIn){ RandomSeed = RandomSeedIn; };
+	inline void SetRandomSeed(int32 RandomSeedIn){ RandomSeed = RandomSeedIn; };
+	inline void SetPelletCount(int32 PelletCountIn){ PelletCount = FMath::Max(PelletCountIn, 1); };
+	/*
+		Sets shots traced by next Execute().
+
+		@param ShotSpreadsIn - spread of every shot, NumShotsIn entries.
+	*/
+	void SetShotBatch(int32 FirstShotIn, float FirstShotTimeIn, const float* ShotSpreadsIn, int32 NumShotsIn);
+	/* Valid inside AGWWeapon::OnTargetDataReady(). */
+	inline const FGWShotBatch& GetCompletedBatch() const { return CompletedBatch; };
+
+	virtual void Execute() override;
+
+	/*
+		Generates directions of all pellets for single shot, uniformly distributed in cone
+		with angle SpreadIn (degrees) around AimDirIn.
+		The same seed and shot always produce the same directions.
+	*/
+	static void GeneratePelletDirections(const FVector& AimDirIn, float SpreadIn, int32 SeedIn,
+		int32 ShotIn, int32 NumPelletsIn, TArray<FVector>& DirectionsOut);
 };